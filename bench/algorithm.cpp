@@ -0,0 +1,60 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "algorithm.hpp"
+#include "aligned_allocator.hpp"
+#include "bench.hpp"
+#include "vector.hpp"
+
+#define BYTES_PER_SIZE ( 1 << 30 )
+
+// Reads both vectors, equal up to their last element, until 1 GiB is read
+template < typename T >
+double compare_gbs( size_t n, bool by_element, bool lexicographical )
+{
+    typedef ft::vector<T, ft::aligned_allocator<T> > vector_type;
+    vector_type lhs( n, T( 1 ) );
+    vector_type rhs( lhs );
+    rhs.back()    = T( 2 );
+    size_t rounds = BYTES_PER_SIZE / ( 2 * n * sizeof( T ) ) + 1;
+    double start  = bench::now();
+    for ( size_t round = 0; round < rounds; round++ ) {
+        if ( by_element && lexicographical )
+            bench::sink += ft::lexicographical_compare(
+                lhs.begin(), lhs.end(), rhs.begin(), rhs.end() );
+        else if ( by_element )
+            bench::sink += ft::equal( lhs.begin(), lhs.end(), rhs.begin() );
+        else if ( lexicographical )
+            bench::sink += lhs < rhs;
+        else
+            bench::sink += lhs == rhs;
+    }
+    return rounds * 2 * n * sizeof( T ) / ( bench::now() - start ) * 1e-9;
+}
+
+template < typename T >
+void compare_table( const char *title )
+{
+    bench::header( title,
+                   "elements  equal by element  ==     "
+                   "lexicographical by element  <" );
+    for ( size_t n = 4096; n <= 16777216; n *= 8 ) {
+        std::printf( "%8lu  %16.2f  %5.2f  %26.2f  %5.2f\n",
+                     ( unsigned long ) n,
+                     compare_gbs<T>( n, true, false ),
+                     compare_gbs<T>( n, false, false ),
+                     compare_gbs<T>( n, true, true ),
+                     compare_gbs<T>( n, false, true ) );
+    }
+}
+
+int main()
+{
+    std::printf( "SIMD level: %s\n",
+                 ft::_simd_level() == ft::SIMD_AVX2   ? "AVX2"
+                 : ft::_simd_level() == ft::SIMD_SSE2 ? "SSE2"
+                                                      : "none" );
+    compare_table<int>( "vector<int> comparisons (GB/s read)" );
+    compare_table<float>( "vector<float> comparisons (GB/s read)" );
+    return 0;
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <time.h>
+
+namespace bench {
+
+/**
+ * @brief Keeps the optimizer from discarding the results of a benchmark.
+ */
+static volatile size_t sink = 0;
+
+/**
+ * @brief Reads the monotonic clock.
+ *
+ * @return double The current time in seconds.
+ */
+inline double now()
+{
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Prints the header of a benchmark table.
+ *
+ * @param title The name of the benchmark.
+ * @param columns The column names, separated by spaces.
+ */
+inline void header( const char *title, const char *columns )
+{
+    std::printf( "\n%s\n%s\n", title, columns );
+}
+
+} // namespace bench
+
+#endif // BENCH_HPP
@@ -0,0 +1,522 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "map.hpp"
+#include "bench.hpp"
+#include "flat_map.hpp"
+#include "multimap.hpp"
+#include "node_pool_allocator.hpp"
+#include "set.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Inserts the keys 0 to n - 1 in order, with or without the end() hint
+double sorted_insert_ns( size_t n, bool hinted )
+{
+    double            start = bench::now();
+    ft::map<int, int> m;
+    for ( size_t i = 0; i < n; i++ ) {
+        if ( hinted )
+            m.insert( m.end(), ft::make_pair( ( int ) i, 0 ) );
+        else
+            m.insert( ft::make_pair( ( int ) i, 0 ) );
+    }
+    bench::sink += m.size();
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+// Builds a map from n sorted pairs, or copies one built beforehand
+double bulk_ns( size_t n, bool copy )
+{
+    std::vector<ft::pair<int, int> > sorted;
+    for ( size_t i = 0; i < n; i++ )
+        sorted.push_back( ft::make_pair( ( int ) i, 0 ) );
+    ft::map<int, int> source( sorted.begin(), sorted.end() );
+    double            start = bench::now();
+    if ( copy ) {
+        ft::map<int, int> m( source );
+        bench::sink += m.size();
+    } else {
+        ft::map<int, int> m( sorted.begin(), sorted.end() );
+        bench::sink += m.size();
+    }
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+typedef ft::node_pool_allocator<ft::pair<const int, int> > pool_alloc;
+typedef ft::map<int, int, std::less<int>, pool_alloc>       pool_map;
+
+// Fills a map with n random keys, erases and inserts 4n random keys, then
+// destroys it, repeated until about 9M operations are timed
+template < typename Map >
+double churn_ns( size_t n )
+{
+    size_t rounds = 1048576 / n + 1;
+    std::srand( 42 );
+    double start = bench::now();
+    for ( size_t round = 0; round < rounds; round++ ) {
+        Map m;
+        for ( size_t i = 0; i < n; i++ )
+            m[std::rand() % ( 2 * n )] = i;
+        for ( size_t i = 0; i < 4 * n; i++ ) {
+            m.erase( std::rand() % ( 2 * n ) );
+            m[std::rand() % ( 2 * n )] = i;
+        }
+        bench::sink += m.size();
+    }
+    return ( bench::now() - start ) * 1e9 / ( rounds * 9 * n );
+}
+
+// Times clear() on a map of n random keys
+template < typename Map >
+double clear_ns( size_t n )
+{
+    Map m;
+    for ( size_t i = 0; i < n; i++ )
+        m[std::rand()] = i;
+    size_t size  = m.size();
+    double start = bench::now();
+    m.clear();
+    return ( bench::now() - start ) * 1e9 / size;
+}
+
+// A prefix of a request path, compared without building a std::string
+struct slice
+{
+    const char *data;
+    size_t      size;
+};
+
+struct slice_less
+{
+    typedef void is_transparent;
+
+    bool operator()( const std::string &lhs, const std::string &rhs ) const
+    {
+        return lhs < rhs;
+    };
+    bool operator()( const slice &lhs, const std::string &rhs ) const
+    {
+        return compare( lhs.data, lhs.size, rhs.data(), rhs.size() ) < 0;
+    };
+    bool operator()( const std::string &lhs, const slice &rhs ) const
+    {
+        return compare( lhs.data(), lhs.size(), rhs.data, rhs.size ) < 0;
+    };
+
+    static int compare( const char *a, size_t a_size, const char *b,
+                        size_t b_size )
+    {
+        int diff = std::memcmp( a, b, a_size < b_size ? a_size : b_size );
+        if ( diff != 0 )
+            return diff;
+        return a_size < b_size ? -1 : a_size > b_size;
+    };
+};
+
+// Looks up n routes of 24 characters 4M times, by the route part of a
+// longer path, either copied to a std::string or compared in place
+double route_find_ns( size_t n, bool transparent )
+{
+    ft::map<std::string, int, slice_less> m;
+    std::vector<std::string>              paths;
+    char                                  buf[64];
+    for ( size_t i = 0; i < n; i++ ) {
+        std::sprintf( buf, "/api/v1/route/%010u", ( unsigned ) i );
+        m[buf] = i;
+        paths.push_back( std::string( buf ) + "?query=1" );
+    }
+    size_t lookups = 4194304;
+    double start   = bench::now();
+    for ( size_t i = 0; i < lookups; i++ ) {
+        slice route = { paths[i % n].data(), 24 };
+        if ( transparent )
+            bench::sink += m.find( route )->second;
+        else
+            bench::sink += m.find( std::string( route.data, route.size ) )
+                               ->second;
+    }
+    return ( bench::now() - start ) * 1e9 / lookups;
+}
+
+typedef ft::map<int,
+                int,
+                ft::less<int>,
+                std::allocator<ft::pair<const int, int> >,
+                ft::rb_rank_policy>
+    ranked_map;
+
+// Inserts n random keys, reporting ns per insertion
+template < typename Map >
+double random_insert_ns( Map &m, size_t n )
+{
+    std::srand( 42 );
+    double start = bench::now();
+    for ( size_t i = 0; i < n; i++ )
+        m[std::rand()] = i;
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+// Finds 1000 random positions walking from begin()
+double advance_ns( const ft::map<int, int> &m )
+{
+    double start = bench::now();
+    for ( size_t i = 0; i < 1000; i++ ) {
+        size_t                            k  = std::rand() % m.size();
+        ft::map<int, int>::const_iterator it = m.begin();
+        for ( size_t j = 0; j < k; j++ )
+            ++it;
+        bench::sink += it->second;
+    }
+    return ( bench::now() - start ) * 1e9 / 1000;
+}
+
+// Finds 1000 random positions with nth()
+double nth_ns( const ranked_map &m )
+{
+    double start = bench::now();
+    for ( size_t i = 0; i < 1000; i++ )
+        bench::sink += m.nth( std::rand() % m.size() )->second;
+    return ( bench::now() - start ) * 1e9 / 1000;
+}
+
+// Keeps a window of the n latest timestamps, adding and expiring batches of
+// n / 8, by key one at a time as erase( first, last ) used to, or with
+// erase_before; reports ns per expired element
+double expire_ns( size_t n, bool by_range )
+{
+    ft::map<int, int> m;
+    int               now = 0;
+    for ( ; ( size_t ) now < n; now++ )
+        m.insert( m.end(), ft::make_pair( now, now ) );
+    size_t batch   = n / 8;
+    size_t expired = 0;
+    double elapsed = 0;
+    for ( int round = 0; round < 16; round++ ) {
+        for ( size_t i = 0; i < batch; i++, now++ )
+            m.insert( m.end(), ft::make_pair( now, now ) );
+        double start = bench::now();
+        if ( by_range ) {
+            expired += m.erase_before( now - ( int ) n );
+        } else {
+            while ( m.begin()->first < now - ( int ) n ) {
+                m.erase( m.begin()->first );
+                expired++;
+            }
+        }
+        elapsed += bench::now() - start;
+    }
+    return elapsed * 1e9 / expired;
+}
+
+// Intersects a set of n keys with one of m keys spread among them, by looking
+// up each of the m keys and inserting the hits, or with set_intersection;
+// reports ns per intersection
+double intersect_ns( size_t n, size_t m, bool algebra )
+{
+    ft::set<int> granted, needed;
+    for ( size_t i = 0; i < n; i++ )
+        granted.insert( granted.end(), ( int ) ( i * 2 ) );
+    for ( size_t i = 0; i < m; i++ )
+        needed.insert( needed.end(), ( int ) ( i * ( n / m ) * 2 + i % 2 ) );
+    size_t rounds = 4194304 / ( n + m ) + 1;
+    double start  = bench::now();
+    for ( size_t r = 0; r < rounds; r++ ) {
+        if ( algebra ) {
+            bench::sink += ft::set_intersection( needed, granted ).size();
+        } else {
+            ft::set<int> both;
+            for ( ft::set<int>::iterator it = needed.begin();
+                  it != needed.end(); ++it )
+                if ( granted.count( *it ) )
+                    both.insert( *it );
+            bench::sink += both.size();
+        }
+    }
+    return ( bench::now() - start ) * 1e9 / rounds;
+}
+
+typedef ft::map<int,
+                int,
+                ft::less<int>,
+                std::allocator<ft::pair<const int, int> >,
+                ft::rb_threaded_policy>
+    threaded_map;
+
+// Walks the whole map forward then backward, about 8M steps in all; reports
+// ns per step
+template < typename Map >
+double scan_ns( const Map &m )
+{
+    size_t rounds = 4194304 / m.size() + 1;
+    double start  = bench::now();
+    for ( size_t r = 0; r < rounds; r++ ) {
+        for ( typename Map::const_iterator it = m.begin(); it != m.end(); ++it )
+            bench::sink += it->second;
+        for ( typename Map::const_reverse_iterator it = m.rbegin();
+              it != m.rend(); ++it )
+            bench::sink += it->second;
+    }
+    return ( bench::now() - start ) * 1e9 / ( rounds * m.size() * 2 );
+}
+
+// Moves the n entries of one shard into another holding n other keys: erase
+// and insert each entry, insert extracted nodes, or merge; reports ns per
+// entry moved
+double move_ns( size_t n, int how )
+{
+    typedef ft::map<int, std::string> shard;
+    shard                             from, to;
+    std::string value( 32, '.' );
+    for ( size_t i = 0; i < n; i++ ) {
+        from.insert( from.end(), ft::make_pair( ( int ) i * 2, value ) );
+        to.insert( to.end(), ft::make_pair( ( int ) i * 2 + 1, value ) );
+    }
+    double start = bench::now();
+    if ( how == 0 ) {
+        while ( !from.empty() ) {
+            to.insert( *from.begin() );
+            from.erase( from.begin() );
+        }
+    } else if ( how == 1 ) {
+        while ( !from.empty() )
+            to.insert( from.extract( from.begin() ) );
+    } else {
+        to.merge( from );
+    }
+    double elapsed = bench::now() - start;
+    bench::sink += to.size();
+    return elapsed * 1e9 / n;
+}
+
+// Builds the 64 integers a cache computes for a key on a miss
+struct make_block
+{
+    std::vector<int> operator()() const { return std::vector<int>( 64, 1 ); }
+};
+
+// Looks up n random keys in a cache of blocks, building a block on a miss:
+// find then insert a pair, or try_insert; reports ns per lookup
+double cache_ns( size_t n, bool in_place )
+{
+    typedef ft::map<int, std::vector<int> > cache;
+    cache                                   c;
+    make_block                              make;
+    std::srand( 7 );
+    double start = bench::now();
+    for ( size_t i = 0; i < n; i++ ) {
+        int key = std::rand() % ( int ) n;
+        if ( in_place ) {
+            bench::sink += c.try_insert( key, make ).first->second[0];
+        } else {
+            cache::iterator it = c.find( key );
+            if ( it == c.end() )
+                it = c.insert( ft::make_pair( key, make() ) ).first;
+            bench::sink += it->second[0];
+        }
+    }
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+// Builds a secondary index of n rows over n / 8 random keys, as a multimap or
+// as a map of vectors, then drops the rows of every key; reports ns per row
+double index_ns( size_t n, bool multi )
+{
+    typedef ft::map<int, ft::vector<int> > buckets;
+    ft::multimap<int, int>                 index;
+    buckets                                emulated;
+    size_t                                 keys = n / 8;
+    std::srand( 11 );
+    double start = bench::now();
+    for ( size_t i = 0; i < n; i++ ) {
+        int key = std::rand() % ( int ) keys;
+        if ( multi )
+            index.insert( ft::make_pair( key, ( int ) i ) );
+        else
+            emulated[key].push_back( ( int ) i );
+    }
+    for ( size_t k = 0; k < keys; k++ ) {
+        if ( multi )
+            bench::sink += index.erase( ( int ) k );
+        else
+            bench::sink += emulated.erase( ( int ) k );
+    }
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+// Builds a table of n random keys from one unsorted range; reports ns per key
+template < class Table >
+double build_ns( Table &table, size_t n )
+{
+    std::vector<ft::pair<int, int> > rows;
+    std::srand( 13 );
+    for ( size_t i = 0; i < n; i++ )
+        rows.push_back( ft::make_pair( std::rand(), ( int ) i ) );
+    double start = bench::now();
+    table.insert( rows.begin(), rows.end() );
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+// Looks up 1048576 random keys of a table built by build_ns, half of them
+// present; reports ns per lookup
+template < class Table >
+double lookup_ns( const Table &table, size_t n )
+{
+    size_t lookups = 1048576;
+    std::srand( 13 );
+    std::vector<int> keys;
+    for ( size_t i = 0; i < n; i++ )
+        keys.push_back( std::rand() );
+    for ( size_t i = 0; i < n; i++ )
+        keys.push_back( std::rand() );
+    double start = bench::now();
+    for ( size_t i = 0; i < lookups; i++ ) {
+        typename Table::const_iterator it
+            = table.find( keys[( i * 7919 ) % keys.size()] );
+        bench::sink += it == table.end() ? 0 : it->second;
+    }
+    return ( bench::now() - start ) * 1e9 / lookups;
+}
+
+int main()
+{
+    bench::header( "map::insert of sorted keys (ns per element)",
+                   "elements   insert(val)  insert(end(), val)" );
+    for ( size_t n = 1024; n <= 4194304; n *= 8 ) {
+        std::printf( "%8lu  %12.2f  %18.2f\n",
+                     ( unsigned long ) n,
+                     sorted_insert_ns( n, false ),
+                     sorted_insert_ns( n, true ) );
+    }
+    bench::header( "map bulk construction (ns per element, with teardown)",
+                   "elements  map(first, last)  map(const map &)" );
+    for ( size_t n = 1024; n <= 4194304; n *= 8 ) {
+        std::printf( "%8lu  %16.2f  %16.2f\n",
+                     ( unsigned long ) n,
+                     bulk_ns( n, false ),
+                     bulk_ns( n, true ) );
+    }
+    bench::header( "map insert/erase churn (ns per operation)",
+                   "elements  std::allocator  node_pool_allocator" );
+    for ( size_t n = 1024; n <= 524288; n *= 8 ) {
+        std::printf( "%8lu  %14.2f  %19.2f\n",
+                     ( unsigned long ) n,
+                     churn_ns<ft::map<int, int> >( n ),
+                     churn_ns<pool_map>( n ) );
+    }
+
+    bench::header( "map::clear (ns per element)",
+                   "elements  std::allocator  node_pool_allocator" );
+    for ( size_t n = 1024; n <= 4194304; n *= 8 ) {
+        std::printf( "%8lu  %14.2f  %19.2f\n",
+                     ( unsigned long ) n,
+                     clear_ns<ft::map<int, int> >( n ),
+                     clear_ns<pool_map>( n ) );
+    }
+
+    bench::header( "map<std::string, int>::find of a path prefix (ns)",
+                   "elements  find(std::string)  find(slice)" );
+    for ( size_t n = 1024; n <= 1048576; n *= 32 ) {
+        std::printf( "%8lu  %17.2f  %11.2f\n",
+                     ( unsigned long ) n,
+                     route_find_ns( n, false ),
+                     route_find_ns( n, true ) );
+    }
+
+    bench::header( "rb_rank_policy: random insert and k-th element (ns)",
+                   "elements  insert  ranked insert  advance(k)  nth(k)" );
+    for ( size_t n = 1024; n <= 1048576; n *= 32 ) {
+        ft::map<int, int> plain;
+        ranked_map        ranked;
+        double            insert_ns = random_insert_ns( plain, n );
+        double            ranked_ns = random_insert_ns( ranked, n );
+        std::printf( "%8lu  %6.2f  %13.2f  %10.0f  %6.2f\n",
+                     ( unsigned long ) n,
+                     insert_ns,
+                     ranked_ns,
+                     advance_ns( plain ),
+                     nth_ns( ranked ) );
+    }
+
+    bench::header( "map expiry of the oldest keys (ns per expired element)",
+                   "window  erase(key) loop  erase_before(key)" );
+    for ( size_t n = 1024; n <= 4194304; n *= 8 ) {
+        std::printf( "%8lu  %15.2f  %17.2f\n",
+                     ( unsigned long ) n,
+                     expire_ns( n, false ),
+                     expire_ns( n, true ) );
+    }
+
+    bench::header( "set intersection of n and m keys (us)",
+                   "       n        m  find/insert loop  set_intersection" );
+    for ( size_t m = 16; m <= 1048576; m *= 16 ) {
+        std::printf( "%8lu %8lu  %16.2f  %16.2f\n",
+                     ( unsigned long ) 1048576,
+                     ( unsigned long ) m,
+                     intersect_ns( 1048576, m, false ) / 1000,
+                     intersect_ns( 1048576, m, true ) / 1000 );
+    }
+
+    bench::header(
+        "rb_threaded_policy: random insert and full scans (ns)",
+        "elements   insert  threaded insert    scan  threaded scan" );
+    for ( size_t n = 1024; n <= 4194304; n *= 16 ) {
+        ft::map<int, int> plain;
+        threaded_map      threaded;
+        double            insert_ns   = random_insert_ns( plain, n );
+        double            threaded_ns = random_insert_ns( threaded, n );
+        std::printf( "%8lu  %7.2f  %15.2f  %6.2f  %13.2f\n",
+                     ( unsigned long ) n,
+                     insert_ns,
+                     threaded_ns,
+                     scan_ns( plain ),
+                     scan_ns( threaded ) );
+    }
+
+    bench::header( "map entries moved to another shard (ns per entry)",
+                   "entries  erase+insert  extract+insert   merge" );
+    for ( size_t n = 1024; n <= 1048576; n *= 32 ) {
+        std::printf( "%7lu  %12.2f  %14.2f  %6.2f\n",
+                     ( unsigned long ) n,
+                     move_ns( n, 0 ),
+                     move_ns( n, 1 ),
+                     move_ns( n, 2 ) );
+    }
+
+    bench::header( "get-or-create in a cache of 64-int blocks (ns per lookup)",
+                   "lookups  find+insert(pair)  try_insert" );
+    for ( size_t n = 1024; n <= 1048576; n *= 32 ) {
+        std::printf( "%7lu  %17.2f  %10.2f\n",
+                     ( unsigned long ) n,
+                     cache_ns( n, false ),
+                     cache_ns( n, true ) );
+    }
+
+    bench::header( "secondary index, 8 rows per key: build then drop (ns/row)",
+                   "   rows  map<K, vector<V> >  multimap<K, V>" );
+    for ( size_t n = 1024; n <= 1048576; n *= 32 ) {
+        std::printf( "%7lu  %18.2f  %14.2f\n",
+                     ( unsigned long ) n,
+                     index_ns( n, false ),
+                     index_ns( n, true ) );
+    }
+
+    bench::header( "lookup table built once, then queried (ns)",
+                   "elements  map build  flat_map build  map find  "
+                   "flat_map find" );
+    for ( size_t n = 1024; n <= 4194304; n *= 16 ) {
+        ft::map<int, int>      tree;
+        ft::flat_map<int, int> flat;
+        double                 tree_build = build_ns( tree, n );
+        double                 flat_build = build_ns( flat, n );
+        std::printf( "%8lu  %9.2f  %14.2f  %8.2f  %13.2f\n",
+                     ( unsigned long ) n,
+                     tree_build,
+                     flat_build,
+                     lookup_ns( tree, n ),
+                     lookup_ns( flat, n ) );
+    }
+    return 0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "mmap_allocator.hpp"
+#include "bench.hpp"
+#include "vector.hpp"
+
+#define ACCESSES 20000000
+
+typedef unsigned long long                    word;
+typedef ft::mmap_allocator<word>              huge_alloc;
+typedef ft::mmap_allocator<word, 1 << 21, 1>  populated_alloc;
+
+// Time to build a vector of n words, first touch of every page included
+template < typename Alloc >
+double fill_ns( size_t n )
+{
+    double                  start = bench::now();
+    ft::vector<word, Alloc> vec( n, 1 );
+    bench::sink += vec.back();
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+// Dependent reads at pseudo-random indices, which miss the TLB on large sets
+template < typename Alloc >
+double random_read_ns( size_t n )
+{
+    ft::vector<word, Alloc> vec( n );
+    for ( size_t i = 0; i < n; i++ )
+        vec[i] = i * 2654435761u;
+    double start = bench::now();
+    word   index = 0;
+    for ( size_t i = 0; i < ACCESSES; i++ )
+        index = ( vec[index % n] + i ) % n;
+    bench::sink += index;
+    return ( bench::now() - start ) * 1e9 / ACCESSES;
+}
+
+int main()
+{
+    bench::header( "fill n words (ns per element)",
+                   "   words  std::allocator  mmap_allocator  populated" );
+    for ( size_t n = 1 << 16; n <= ( 1 << 25 ); n <<= 3 ) {
+        std::printf( "%8lu  %14.2f  %14.2f  %9.2f\n",
+                     ( unsigned long ) n,
+                     fill_ns<std::allocator<word> >( n ),
+                     fill_ns<huge_alloc>( n ),
+                     fill_ns<populated_alloc>( n ) );
+    }
+    bench::header( "random reads in n words (ns per read)",
+                   "   words  std::allocator  mmap_allocator" );
+    for ( size_t n = 1 << 16; n <= ( 1 << 25 ); n <<= 3 ) {
+        std::printf( "%8lu  %14.2f  %14.2f\n",
+                     ( unsigned long ) n,
+                     random_read_ns<std::allocator<word> >( n ),
+                     random_read_ns<huge_alloc>( n ) );
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "small_vector.hpp"
+#include "bench.hpp"
+#include "vector.hpp"
+
+#define ROUNDS 1000000
+
+// Builds and destroys ROUNDS containers of n elements
+template < typename Container >
+double build_ns( size_t n )
+{
+    double start = bench::now();
+    for ( size_t round = 0; round < ROUNDS; round++ ) {
+        Container ct;
+        for ( size_t i = 0; i < n; i++ )
+            ct.push_back( round + i );
+        bench::sink += ct.back();
+    }
+    return ( bench::now() - start ) * 1e9 / ROUNDS;
+}
+
+int main()
+{
+    bench::header( "build n elements (ns per container)",
+                   "elements   ft::vector  small_vector<8>" );
+    for ( size_t n = 1; n <= 16; n *= 2 ) {
+        std::printf( "%8lu  %11.2f  %15.2f\n",
+                     ( unsigned long ) n,
+                     build_ns<ft::vector<int> >( n ),
+                     build_ns<ft::small_vector<int, 8> >( n ) );
+    }
+    return 0;
+}
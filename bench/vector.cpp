@@ -0,0 +1,106 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "vector.hpp"
+#include "bench.hpp"
+#include "malloc_allocator.hpp"
+#include <string>
+
+struct record
+{
+    int    id;
+    double value;
+};
+
+// Same layout as record, but grows one slot at a time like the old push_back
+struct naive_record
+{
+    int    id;
+    double value;
+};
+
+namespace ft {
+
+template <>
+struct vector_growth_policy<naive_record>
+{
+    static size_t next_capacity( size_t, size_t required, size_t )
+    {
+        return required;
+    };
+};
+
+} // namespace ft
+
+template < typename T >
+double push_back_ns( size_t n )
+{
+    double        start = bench::now();
+    ft::vector<T> vec;
+    T             rec   = T();
+    for ( size_t i = 0; i < n; i++ ) {
+        rec.id = i;
+        vec.push_back( rec );
+    }
+    bench::sink += vec.size();
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+template < typename Alloc >
+double append_ns( size_t n )
+{
+    double                                start = bench::now();
+    ft::vector<unsigned long long, Alloc> vec;
+    for ( size_t i = 0; i < n; i++ )
+        vec.push_back( i );
+    bench::sink += vec.size();
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+// One insert in the middle of a full vector, which reallocates
+double full_insert_ns( size_t n )
+{
+    ft::vector<std::string> vec( n, std::string( 32, 'x' ) );
+    double                  start = bench::now();
+    vec.insert( vec.begin() + n / 2, std::string( 32, 'y' ) );
+    bench::sink += vec.size();
+    return ( bench::now() - start ) * 1e9 / n;
+}
+
+int main()
+{
+    bench::header( "vector::push_back (ns per element)",
+                   "elements    +1 growth    x2 growth" );
+    for ( size_t n = 1024; n <= 16384; n *= 2 ) {
+        std::printf( "%8lu  %11.2f  %11.2f\n",
+                     ( unsigned long ) n,
+                     push_back_ns<naive_record>( n ),
+                     push_back_ns<record>( n ) );
+    }
+    for ( size_t n = 32768; n <= 4194304; n *= 4 ) {
+        std::printf( "%8lu  %11s  %11.2f\n",
+                     ( unsigned long ) n,
+                     "-",
+                     push_back_ns<record>( n ) );
+    }
+
+    bench::header( "vector<unsigned long long>::push_back (ns per element)",
+                   "elements  std::allocator  malloc_allocator" );
+    for ( size_t n = 65536; n <= 16777216; n *= 4 ) {
+        typedef std::allocator<unsigned long long>       std_alloc;
+        typedef ft::malloc_allocator<unsigned long long> malloc_alloc;
+        std::printf( "%8lu  %14.2f  %16.2f\n",
+                     ( unsigned long ) n,
+                     append_ns<std_alloc>( n ),
+                     append_ns<malloc_alloc>( n ) );
+    }
+
+    bench::header( "vector<std::string>::insert in the middle of a full vector"
+                   " (ns per element)",
+                   "elements  insert" );
+    for ( size_t n = 1024; n <= 1048576; n *= 4 ) {
+        std::printf(
+            "%8lu  %6.2f\n", ( unsigned long ) n, full_insert_ns( n ) );
+    }
+    return 0;
+}
@@ -4,10 +4,250 @@
 #ifndef ALGORITHM_HPP
 #define ALGORITHM_HPP
 
+#include "config.hpp"
+#include "simd.hpp"
+#include "type_traits.hpp"
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 
 namespace ft {
 
+template < typename InputIt, typename OutputIt >
+OutputIt copy( InputIt first, InputIt last, OutputIt result )
+{
+    while ( first != last ) {
+        *result = *first;
+        ++result;
+        ++first;
+    }
+    return result;
+}
+
+template < typename BidirIt1, typename BidirIt2 >
+BidirIt2 copy_backward( BidirIt1 first, BidirIt1 last, BidirIt2 result )
+{
+    while ( first != last ) {
+        *--result = *--last;
+    }
+    return result;
+}
+
+/**
+ * @brief Moves the elements of [first, last) to the range starting at result,
+ * front to back. Without C++11 the elements are copied.
+ */
+template < typename InputIt, typename OutputIt >
+OutputIt move( InputIt first, InputIt last, OutputIt result )
+{
+    while ( first != last ) {
+        *result = FT_MOVE( *first );
+        ++result;
+        ++first;
+    }
+    return result;
+}
+
+/**
+ * @brief Moves the elements of [first, last) to the range ending at result,
+ * back to front. Without C++11 the elements are copied.
+ */
+template < typename BidirIt1, typename BidirIt2 >
+BidirIt2 move_backward( BidirIt1 first, BidirIt1 last, BidirIt2 result )
+{
+    while ( first != last ) {
+        *--result = FT_MOVE( *--last );
+    }
+    return result;
+}
+
+template < typename T >
+T *_copy_pointers( const T *first, const T *last, T *result, true_type )
+{
+    size_t n = last - first;
+    if ( n > 0 )
+        std::memmove( result, first, n * sizeof( T ) );
+    return result + n;
+}
+
+template < typename T >
+T *_copy_pointers( const T *first, const T *last, T *result, false_type )
+{
+    return ft::copy<const T *, T *>( first, last, result );
+}
+
+template < typename T >
+T *_copy_backward_pointers( const T *first,
+                            const T *last,
+                            T       *result,
+                            true_type )
+{
+    size_t n = last - first;
+    if ( n > 0 )
+        std::memmove( result - n, first, n * sizeof( T ) );
+    return result - n;
+}
+
+template < typename T >
+T *_copy_backward_pointers( const T *first,
+                            const T *last,
+                            T       *result,
+                            false_type )
+{
+    return ft::copy_backward<const T *, T *>( first, last, result );
+}
+
+/**
+ * @brief Pointer version of copy, trivially copyable elements are moved in
+ * bulk with memmove.
+ */
+template < typename T >
+T *copy( const T *first, const T *last, T *result )
+{
+    typename ft::is_trivially_copyable<T>::type is_trivial;
+    return _copy_pointers( first, last, result, is_trivial );
+}
+
+template < typename T >
+T *copy( T *first, T *last, T *result )
+{
+    return ft::copy( static_cast<const T *>( first ),
+                     static_cast<const T *>( last ),
+                     result );
+}
+
+/**
+ * @brief Pointer version of copy_backward, trivially copyable elements are
+ * moved in bulk with memmove.
+ */
+template < typename T >
+T *copy_backward( const T *first, const T *last, T *result )
+{
+    typename ft::is_trivially_copyable<T>::type is_trivial;
+    return _copy_backward_pointers( first, last, result, is_trivial );
+}
+
+template < typename T >
+T *copy_backward( T *first, T *last, T *result )
+{
+    return ft::copy_backward( static_cast<const T *>( first ),
+                              static_cast<const T *>( last ),
+                              result );
+}
+
+/**
+ * @brief Swaps a and b with the swap found by argument-dependent lookup,
+ * falling back to std::swap.
+ */
+template < typename T >
+void _swap_elements( T &a, T &b )
+{
+    using std::swap;
+    swap( a, b );
+}
+
+/**
+ * @brief Reverses the order of the elements of [first, last).
+ */
+template < typename BidirIt >
+void reverse( BidirIt first, BidirIt last )
+{
+    while ( first != last && first != --last ) {
+        ft::_swap_elements( *first, *last );
+        ++first;
+    }
+}
+
+/**
+ * @brief Rotates [first, last) so that middle becomes its first element,
+ * with three reversals. Unlike std::rotate, nothing is returned.
+ */
+template < typename BidirIt >
+void rotate( BidirIt first, BidirIt middle, BidirIt last )
+{
+    ft::reverse( first, middle );
+    ft::reverse( middle, last );
+    ft::reverse( first, last );
+}
+
+template < typename T >
+T *_move_elements( T *first, T *last, T *result, true_type )
+{
+    for ( ; first != last; ++first, ++result )
+        ft::_swap_elements( *result, *first );
+    return result;
+}
+
+template < typename T >
+T *_move_elements( T *first, T *last, T *result, false_type )
+{
+    return ft::move<T *, T *>( first, last, result );
+}
+
+template < typename T >
+T *_move_backward_elements( T *first, T *last, T *result, true_type )
+{
+    while ( first != last )
+        ft::_swap_elements( *--result, *--last );
+    return result;
+}
+
+template < typename T >
+T *_move_backward_elements( T *first, T *last, T *result, false_type )
+{
+    return ft::move_backward<T *, T *>( first, last, result );
+}
+
+template < typename T >
+T *_move_pointers( T *first, T *last, T *result, true_type )
+{
+    return _copy_pointers<T>( first, last, result, true_type() );
+}
+
+template < typename T >
+T *_move_pointers( T *first, T *last, T *result, false_type )
+{
+    typename ft::_moves_by_swap<T>::type by_swap;
+    return _move_elements( first, last, result, by_swap );
+}
+
+template < typename T >
+T *_move_backward_pointers( T *first, T *last, T *result, true_type )
+{
+    return _copy_backward_pointers<T>( first, last, result, true_type() );
+}
+
+template < typename T >
+T *_move_backward_pointers( T *first, T *last, T *result, false_type )
+{
+    typename ft::_moves_by_swap<T>::type by_swap;
+    return _move_backward_elements( first, last, result, by_swap );
+}
+
+/**
+ * @brief Pointer version of move, trivially copyable elements are moved in
+ * bulk with memmove. Without C++11, swap-relocatable elements are swapped
+ * into place, the source range is left with unspecified values.
+ */
+template < typename T >
+T *move( T *first, T *last, T *result )
+{
+    typename ft::is_trivially_copyable<T>::type is_trivial;
+    return _move_pointers( first, last, result, is_trivial );
+}
+
+/**
+ * @brief Pointer version of move_backward, trivially copyable elements are
+ * moved in bulk with memmove. Without C++11, swap-relocatable elements are
+ * swapped into place, the source range is left with unspecified values.
+ */
+template < typename T >
+T *move_backward( T *first, T *last, T *result )
+{
+    typename ft::is_trivially_copyable<T>::type is_trivial;
+    return _move_backward_pointers( first, last, result, is_trivial );
+}
+
 template <typename InputIt1, typename InputIt2>
 bool equal( InputIt1 first1, InputIt1 last1, InputIt2 first2 )
 {
@@ -74,6 +314,95 @@ bool lexicographical_compare( InputIt1 first1,
     return ( first2 != last2 );
 }
 
+template < typename T >
+bool _equal_pointers( const T *first1,
+                      const T *last1,
+                      const T *first2,
+                      true_type )
+{
+    size_t n = last1 - first1;
+    return ft::_simd_mismatch( first1, first2, n, false ) == n;
+}
+
+template < typename T >
+bool _equal_pointers( const T *first1,
+                      const T *last1,
+                      const T *first2,
+                      false_type )
+{
+    return ft::equal<const T *, const T *>( first1, last1, first2 );
+}
+
+/**
+ * @brief Pointer version of equal, ranges of integers, float or double are
+ * compared with the SIMD kernels of simd.hpp.
+ */
+template < typename T >
+bool equal( const T *first1, const T *last1, const T *first2 )
+{
+    typename ft::_is_simd_comparable<T>::type is_simd;
+    return _equal_pointers( first1, last1, first2, is_simd );
+}
+
+template < typename T >
+bool equal( T *first1, T *last1, T *first2 )
+{
+    return ft::equal( static_cast<const T *>( first1 ),
+                      static_cast<const T *>( last1 ),
+                      static_cast<const T *>( first2 ) );
+}
+
+template < typename T >
+bool _lexicographical_compare_pointers( const T *first1,
+                                        const T *last1,
+                                        const T *first2,
+                                        const T *last2,
+                                        true_type )
+{
+    size_t n1 = last1 - first1;
+    size_t n2 = last2 - first2;
+    size_t n  = n1 < n2 ? n1 : n2;
+    size_t i  = ft::_simd_mismatch( first1, first2, n, true );
+    if ( i < n )
+        return first1[i] < first2[i];
+    return n1 < n2;
+}
+
+template < typename T >
+bool _lexicographical_compare_pointers( const T *first1,
+                                        const T *last1,
+                                        const T *first2,
+                                        const T *last2,
+                                        false_type )
+{
+    return ft::lexicographical_compare<const T *, const T *>(
+        first1, last1, first2, last2 );
+}
+
+/**
+ * @brief Pointer version of lexicographical_compare, ranges of integers,
+ * float or double are compared with the SIMD kernels of simd.hpp.
+ */
+template < typename T >
+bool lexicographical_compare( const T *first1,
+                              const T *last1,
+                              const T *first2,
+                              const T *last2 )
+{
+    typename ft::_is_simd_comparable<T>::type is_simd;
+    return _lexicographical_compare_pointers(
+        first1, last1, first2, last2, is_simd );
+}
+
+template < typename T >
+bool lexicographical_compare( T *first1, T *last1, T *first2, T *last2 )
+{
+    return ft::lexicographical_compare( static_cast<const T *>( first1 ),
+                                        static_cast<const T *>( last1 ),
+                                        static_cast<const T *>( first2 ),
+                                        static_cast<const T *>( last2 ) );
+}
+
 } // namespace ft
 
 #endif // ALGORITHM_HPP
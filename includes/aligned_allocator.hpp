@@ -0,0 +1,90 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef ALIGNED_ALLOCATOR_HPP
+#define ALIGNED_ALLOCATOR_HPP
+
+#include "malloc_allocator.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace ft {
+
+/**
+ * @brief Allocator whose buffers start on an Align byte boundary, by default
+ * a cache line, so vectorized loops over a container never split their first
+ * loads across two lines. The storage is freed with free, but unlike
+ * malloc_allocator it cannot grow with realloc, which does not keep the
+ * alignment.
+ *
+ * @tparam T The type of the elements to allocate.
+ * @tparam Align The alignment in bytes, a power of two of at least
+ * sizeof(void *).
+ */
+template < typename T, size_t Align = 64 >
+class aligned_allocator : public malloc_allocator<T> {
+    typedef char _align_is_valid[( Align & ( Align - 1 ) ) == 0
+                                         && Align >= sizeof( void * )
+                                     ? 1
+                                     : -1];
+
+public:
+    typedef typename malloc_allocator<T>::pointer   pointer;
+    typedef typename malloc_allocator<T>::size_type size_type;
+    typedef ft::bool_constant<false>                can_reallocate;
+
+    template < typename U >
+    struct rebind
+    {
+        typedef aligned_allocator<U, Align> other;
+    };
+
+    static const size_t alignment = Align;
+
+    aligned_allocator() {};
+    aligned_allocator( const aligned_allocator &x )
+        : malloc_allocator<T>( x ) {};
+    template < typename U >
+    aligned_allocator( const aligned_allocator<U, Align> & ) {};
+    ~aligned_allocator() {};
+
+    /**
+     * @brief Allocates uninitialized storage for n elements aligned on Align
+     * bytes. Never returns NULL, even for n == 0.
+     */
+    pointer allocate( size_type n, const void * = 0 )
+    {
+        if ( n > this->max_size() )
+            throw std::bad_alloc();
+        void *p = NULL;
+        if ( ::posix_memalign( &p, Align, n > 0 ? n * sizeof( T ) : 1 ) != 0 )
+            throw std::bad_alloc();
+        return static_cast<pointer>( p );
+    };
+
+private:
+    // Hides malloc_allocator::reallocate, realloc drops the alignment
+    pointer reallocate( pointer p, size_type old_n, size_type new_n );
+};
+
+template < typename T, size_t Align >
+const size_t aligned_allocator<T, Align>::alignment;
+
+template < typename T, typename U, size_t Align >
+inline bool operator==( const aligned_allocator<T, Align> &,
+                        const aligned_allocator<U, Align> & )
+{
+    return true;
+}
+
+template < typename T, typename U, size_t Align >
+inline bool operator!=( const aligned_allocator<T, Align> &,
+                        const aligned_allocator<U, Align> & )
+{
+    return false;
+}
+
+} // namespace ft
+
+#endif // ALIGNED_ALLOCATOR_HPP
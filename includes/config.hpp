@@ -0,0 +1,60 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef CONFIG_HPP
+#define CONFIG_HPP
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * The library builds as C++98. When compiled as C++11 or later, FT_CXX11 is
+ * set and the containers gain move semantics and emplacement. FT_MOVE and
+ * FT_MOVE_IF_NOEXCEPT let shared code move where it can and copy otherwise.
+ */
+#if __cplusplus >= 201103L
+#define FT_CXX11 1
+#else
+#define FT_CXX11 0
+#endif
+
+#if FT_CXX11
+#include <utility>
+#define FT_MOVE( x ) std::move( x )
+#define FT_MOVE_IF_NOEXCEPT( x ) std::move_if_noexcept( x )
+#else
+#define FT_MOVE( x ) ( x )
+#define FT_MOVE_IF_NOEXCEPT( x ) ( x )
+#endif
+
+/**
+ * Build with -DFT_CONTAINERS_DEBUG to turn on the precondition checks of the
+ * containers (unchecked element access, iterator arithmetic). A failed check
+ * prints the broken condition and aborts. Without it the checks compile to
+ * nothing.
+ */
+#ifdef FT_CONTAINERS_DEBUG
+#define FT_ASSERT( cond, msg )                                                 \
+    ( ( cond ) ? ( void ) 0                                                    \
+               : ft::_assert_fail( #cond, msg, __FILE__, __LINE__ ) )
+#else
+#define FT_ASSERT( cond, msg ) ( ( void ) 0 )
+#endif
+
+namespace ft {
+
+inline void
+_assert_fail( const char *cond, const char *msg, const char *file, int line )
+{
+    std::fprintf( stderr,
+                  "%s:%d: ft_containers: assertion `%s' failed: %s\n",
+                  file,
+                  line,
+                  cond,
+                  msg );
+    std::abort();
+}
+
+} // namespace ft
+
+#endif // CONFIG_HPP
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef FLAT_ALGORITHM_HPP
+#define FLAT_ALGORITHM_HPP
+
+#include "algorithm.hpp"
+#include "config.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+
+#if FT_CXX11
+#include <type_traits>
+#endif
+
+namespace ft {
+
+/**
+ * @brief The index of the first of the n sorted keys at first that is not
+ * less than k. Each step keeps one half of the range with a conditional move
+ * instead of a branch, so a lookup always takes log2(n) steps and never
+ * mispredicts, whatever the keys.
+ */
+template < typename Key, typename K, typename Compare >
+size_t
+_flat_lower_bound( const Key *first, size_t n, const K &k, const Compare &comp )
+{
+    if ( n == 0 ) {
+        return 0;
+    }
+    const Key *base = first;
+    while ( n > 1 ) {
+        size_t half = n / 2;
+        base        = comp( base[half], k ) ? base + half : base;
+        n          -= half;
+    }
+    return size_t( base - first ) + comp( *base, k );
+}
+
+/**
+ * @brief The index of the first of the n sorted keys at first that is
+ * greater than k, see _flat_lower_bound.
+ */
+template < typename Key, typename K, typename Compare >
+size_t
+_flat_upper_bound( const Key *first, size_t n, const K &k, const Compare &comp )
+{
+    if ( n == 0 ) {
+        return 0;
+    }
+    const Key *base = first;
+    while ( n > 1 ) {
+        size_t half = n / 2;
+        base        = comp( k, base[half] ) ? base : base + half;
+        n          -= half;
+    }
+    return size_t( base - first ) + !comp( k, *base );
+}
+
+/**
+ * @brief Sorts the n indices at order by the keys they index, keeping equal
+ * keys in their order. A merge sort with buf as room for n / 2 indices, which
+ * only compares the halves once when they are already in order, so a sorted
+ * input takes n comparisons.
+ */
+template < typename Key, typename Compare >
+void _flat_sort( size_t        *order,
+                 size_t         n,
+                 size_t        *buf,
+                 const Key     *keys,
+                 const Compare &comp )
+{
+    if ( n <= 16 ) {
+        for ( size_t i = 1; i < n; i++ ) {
+            size_t x = order[i];
+            size_t j = i;
+            for ( ; j > 0 && comp( keys[x], keys[order[j - 1]] ); j-- ) {
+                order[j] = order[j - 1];
+            }
+            order[j] = x;
+        }
+        return;
+    }
+    size_t half = n / 2;
+    _flat_sort( order, half, buf, keys, comp );
+    _flat_sort( order + half, n - half, buf, keys, comp );
+    if ( !comp( keys[order[half]], keys[order[half - 1]] ) ) {
+        return;
+    }
+    for ( size_t i = 0; i < half; i++ ) {
+        buf[i] = order[i];
+    }
+    // The merged prefix never catches up with the unread second half
+    size_t i = 0, j = half, out = 0;
+    while ( i < half && j < n ) {
+        if ( comp( keys[order[j]], keys[buf[i]] ) ) {
+            order[out++] = order[j++];
+        } else {
+            order[out++] = buf[i++];
+        }
+    }
+    while ( i < half ) {
+        order[out++] = buf[i++];
+    }
+}
+
+/**
+ * @brief Picks the new keys of a bulk insert: sorts the indices of the m keys
+ * at keys into order, with pos as room, then keeps the first of equal keys
+ * unless the n sorted keys of table have it. The b-th kept key has index
+ * order[b] in keys and goes before table[pos[b]].
+ *
+ * @return size_t The number of keys kept.
+ */
+template < typename Key, typename Compare >
+size_t _flat_select( size_t        *order,
+                     size_t        *pos,
+                     size_t         m,
+                     const Key     *keys,
+                     const Key     *table,
+                     size_t         n,
+                     const Compare &comp )
+{
+    for ( size_t j = 0; j < m; j++ ) {
+        order[j] = j;
+    }
+    ft::_flat_sort( order, m, pos, keys, comp );
+    size_t kept = 0;
+    size_t lo   = 0;
+    for ( size_t j = 0; j < m; j++ ) {
+        const Key &k = keys[order[j]];
+        if ( kept > 0 && !comp( keys[order[kept - 1]], k ) ) {
+            continue;
+        }
+        lo += ft::_flat_lower_bound( table + lo, n - lo, k, comp );
+        if ( lo < n && !comp( k, table[lo] ) ) {
+            continue;
+        }
+        order[kept] = order[j];
+        pos[kept]   = lo;
+        kept++;
+    }
+    return kept;
+}
+
+/**
+ * @brief Swaps elements of a flat table with each other, or with the kept
+ * elements of a bulk insert, by index, see _flat_fill.
+ */
+template < typename Container >
+struct _flat_swapper
+{
+    Container    &table;
+    Container    &staged;
+    const size_t *order;
+
+    _flat_swapper( Container &t, Container &s, const size_t *o ) :
+        table( t ), staged( s ), order( o ) {};
+
+    void swap( size_t to, size_t from )
+    {
+        ft::_swap_elements( table[to], table[from] );
+    };
+
+    void take( size_t to, size_t b )
+    {
+        ft::_swap_elements( table[to], staged[order[b]] );
+    };
+};
+
+/**
+ * @brief Moves the kept elements of a bulk insert into place in a table of n
+ * sorted elements, grown by kept placeholders at its end. Filling from the
+ * back, the elements from pos[b] on move past the b + 1 kept ones before
+ * them, without a comparison.
+ */
+template < typename Swapper >
+void _flat_fill( size_t n, const size_t *pos, size_t kept, Swapper swapper )
+{
+    size_t i = n;
+    for ( size_t b = kept; b-- > 0; ) {
+        for ( ; i > pos[b]; i-- ) {
+            swapper.swap( i + b, i - 1 );
+        }
+        swapper.take( i + b, b );
+    }
+}
+
+/**
+ * @brief Whether swapping two T cannot throw, so a table of T can be merged
+ * into in place. True for trivially copyable and swap-relocatable types and,
+ * with C++11, for types with non-throwing moves.
+ */
+template < typename T >
+struct _flat_swaps_nothrow
+    : bool_constant< FT_IS_TRIVIALLY_COPYABLE( T )
+                     || is_swap_relocatable<T>::value
+#if FT_CXX11
+                     || ( std::is_nothrow_move_constructible<T>::value
+                          && std::is_nothrow_move_assignable<T>::value )
+#endif
+                     > {};
+
+} // namespace ft
+
+#endif // FLAT_ALGORITHM_HPP
@@ -0,0 +1,598 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include "flat_algorithm.hpp"
+#include "flat_map_iterator.hpp"
+#include "functional.hpp"
+#include "reverse_iterator.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+#include <stdexcept>
+
+#define FLAT_MAP_TEMPLATE_ARGS                                                 \
+    typename Key, typename T, typename Compare, typename Alloc
+
+#define FLAT_MAP_CLASS_TYPE flat_map< Key, T, Compare, Alloc >
+
+namespace ft {
+
+/**
+ * @brief A map stored as two sorted arrays, one of keys and one of mapped
+ * values at the same indices. Lookups binary search the keys without
+ * branching and touch the values only once found, and the tables take no
+ * memory besides the elements. Inserting or erasing a single element moves
+ * the elements after it, so tables are best built in bulk, see
+ * insert( first, last ).
+ */
+template < typename Key,
+           typename T,
+           typename Compare = ft::less<Key>,
+           typename Alloc   = std::allocator<ft::pair<const Key, T> > >
+class flat_map {
+public:
+    typedef Key              key_type;
+    typedef T                mapped_type;
+    typedef ft::pair<Key, T> value_type;
+    typedef Compare          key_compare;
+    typedef Alloc            allocator_type;
+    typedef size_t           size_type;
+    typedef ptrdiff_t        difference_type;
+
+    typedef typename Alloc::template rebind<Key>::other key_allocator_type;
+    typedef typename Alloc::template rebind<T>::other   mapped_allocator_type;
+    typedef ft::vector<Key, key_allocator_type>         key_container_type;
+    typedef ft::vector<T, mapped_allocator_type>        mapped_container_type;
+
+    typedef flat_map_iterator<Key, T>            iterator;
+    typedef flat_map_iterator<Key, T, const T>   const_iterator;
+    typedef ft::reverse_iterator<iterator>       reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef typename iterator::reference         reference;
+    typedef typename const_iterator::reference   const_reference;
+
+    class value_compare
+        : public std::binary_function<value_type, value_type, bool> {
+        friend class flat_map<Key, T, Compare, Alloc>;
+
+    protected:
+        Compare comp;
+
+        explicit value_compare( Compare c ) : comp( c ) {}
+
+    public:
+        bool operator()( const value_type &x, const value_type &y ) const
+        {
+            return comp( x.first, y.first );
+        }
+    };
+
+    // Constructors
+    explicit flat_map( const key_compare    &comp  = key_compare(),
+                       const allocator_type &alloc = allocator_type() ) :
+        _keys( key_allocator_type( alloc ) ),
+        _values( mapped_allocator_type( alloc ) ),
+        _comp( comp ) {};
+
+    template < typename InputIterator >
+    flat_map( InputIterator         first,
+              InputIterator         last,
+              const key_compare    &comp  = key_compare(),
+              const allocator_type &alloc = allocator_type() ) :
+        _keys( key_allocator_type( alloc ) ),
+        _values( mapped_allocator_type( alloc ) ),
+        _comp( comp )
+    {
+        insert( first, last );
+    };
+
+    flat_map( const flat_map &x ) :
+        _keys( x._keys ), _values( x._values ), _comp( x._comp ) {};
+
+    // Destructor
+    ~flat_map() {};
+
+    // Operators
+    flat_map &operator=( const flat_map &x )
+    {
+        _keys   = x._keys;
+        _values = x._values;
+        _comp   = x._comp;
+        return *this;
+    };
+
+    // Iterators
+    iterator       begin() { return _at( 0 ); };
+    const_iterator begin() const { return _at( 0 ); };
+    iterator       end() { return _at( size() ); };
+    const_iterator end() const { return _at( size() ); };
+
+    reverse_iterator       rbegin() { return reverse_iterator( end() ); };
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator( end() );
+    };
+    reverse_iterator       rend() { return reverse_iterator( begin() ); };
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator( begin() );
+    };
+
+    // Capacity
+    bool      empty() const { return _keys.empty(); };
+    size_type size() const { return _keys.size(); };
+    size_type max_size() const
+    {
+        return _keys.max_size() < _values.max_size() ? _keys.max_size()
+                                                     : _values.max_size();
+    };
+    size_type capacity() const { return _keys.capacity(); };
+
+    /**
+     * @brief Allocates room for n elements, so inserts, single or in bulk,
+     * do not reallocate the arrays while the map holds at most n elements.
+     * Bulk inserts of elements that may throw when swapped still build new
+     * arrays, see _flat_swaps_nothrow
+     *
+     * @param n The number of elements to make room for
+     */
+    void reserve( size_type n )
+    {
+        _keys.reserve( n );
+        _values.reserve( n );
+    };
+
+    /**
+     * @brief Frees the room for elements past size(), once a table is built
+     */
+    void shrink_to_fit()
+    {
+        _keys.shrink_to_fit();
+        _values.shrink_to_fit();
+    };
+
+    // Element access
+    /**
+     * @brief Returns a reference to the mapped value of key k, inserting a
+     * value-initialized one first if k is missing
+     *
+     * @param k The key of the element
+     * @return mapped_type& Returns the mapped value
+     */
+    mapped_type &operator[]( const key_type &k )
+    {
+        size_type i = _lower_bound( k );
+        if ( i == size() || _comp( k, _keys[i] ) ) {
+            _insert_at( i, k, mapped_type() );
+        }
+        return _values[i];
+    };
+
+    mapped_type &at( const key_type &k )
+    {
+        size_type i = _find( k );
+        if ( i == size() ) {
+            throw std::out_of_range( "flat_map::at" );
+        }
+        return _values[i];
+    };
+
+    const mapped_type &at( const key_type &k ) const
+    {
+        size_type i = _find( k );
+        if ( i == size() ) {
+            throw std::out_of_range( "flat_map::at" );
+        }
+        return _values[i];
+    };
+
+    // Modifiers
+    /**
+     * @brief Inserts an element unless its key is in the map, moving the
+     * elements after it
+     *
+     * @param val The value to insert
+     * @return ft::pair<iterator, bool> Returns the element with the key of val
+     * and whether it was inserted
+     */
+    ft::pair<iterator, bool> insert( const value_type &val )
+    {
+        size_type i = _lower_bound( val.first );
+        if ( i < size() && !_comp( val.first, _keys[i] ) ) {
+            return ft::make_pair( _at( i ), false );
+        }
+        _insert_at( i, val.first, val.second );
+        return ft::make_pair( _at( i ), true );
+    };
+
+    /**
+     * @brief Inserts an element unless its key is in the map, without a
+     * search when it belongs right before position, e.g. at end() for keys
+     * inserted in order
+     *
+     * @param position The position to try first
+     * @param val The value to insert
+     * @return iterator Returns the element with the key of val
+     */
+    iterator insert( const_iterator position, const value_type &val )
+    {
+        size_type i = position - begin();
+        if ( ( i == size() || _comp( val.first, _keys[i] ) )
+             && ( i == 0 || _comp( _keys[i - 1], val.first ) ) ) {
+            _insert_at( i, val.first, val.second );
+            return _at( i );
+        }
+        return insert( val ).first;
+    };
+
+    /**
+     * @brief Inserts the elements of a range whose keys are not in the map,
+     * the first of equal keys in the range winning. The range is collected,
+     * sorted once and merged with the map in place in O(n + m log m) for m
+     * new elements, instead of moving n elements for each of them
+     *
+     * @tparam InputIterator The iterator type
+     * @param first The iterator to the first element of the range
+     * @param last The iterator past the last element of the range
+     */
+    template < typename InputIterator >
+    void insert( InputIterator first, InputIterator last )
+    {
+        key_container_type    keys( _keys.get_allocator() );
+        mapped_container_type values( _values.get_allocator() );
+        for ( ; first != last; ++first ) {
+            keys.push_back( ( *first ).first );
+            values.push_back( ( *first ).second );
+        }
+        _merge( keys, values );
+    };
+
+    /**
+     * @brief Erases an element from the flat_map
+     *
+     * @param it The iterator to the element to erase
+     */
+    void erase( iterator it ) { erase( it, it + 1 ); };
+
+    /**
+     * @brief Erases the element with key k, if any
+     *
+     * @param k The key of the element to erase
+     * @return size_type Returns the number of elements erased
+     */
+    size_type erase( const key_type &k )
+    {
+        size_type i = _find( k );
+        if ( i == size() ) {
+            return 0;
+        }
+        erase( _at( i ) );
+        return 1;
+    };
+
+    /**
+     * @brief Erases a range of elements from the flat_map
+     *
+     * @param first The iterator to the first element of the range
+     * @param last The iterator past the last element of the range
+     */
+    void erase( iterator first, iterator last )
+    {
+        size_type i = first - begin();
+        size_type j = last - begin();
+        _keys.erase( _keys.begin() + i, _keys.begin() + j );
+        _values.erase( _values.begin() + i, _values.begin() + j );
+    };
+
+    /**
+     * @brief Swaps the contents of two flat_map containers
+     *
+     * @param x The flat_map container to swap with
+     */
+    void swap( flat_map &x )
+    {
+        key_compare tmp = _comp;
+        _keys.swap( x._keys );
+        _values.swap( x._values );
+        _comp   = x._comp;
+        x._comp = tmp;
+    };
+
+    void clear()
+    {
+        _keys.clear();
+        _values.clear();
+    };
+
+    // Observers
+    key_compare   key_comp() const { return _comp; };
+    value_compare value_comp() const { return value_compare( _comp ); };
+
+    /**
+     * @brief The sorted array of keys, e.g. to scan them without touching
+     * the mapped values
+     */
+    const key_container_type &keys() const { return _keys; };
+
+    /**
+     * @brief The mapped values, at the indices of their keys
+     */
+    const mapped_container_type &values() const { return _values; };
+
+    allocator_type get_allocator() const
+    {
+        return allocator_type( _keys.get_allocator() );
+    };
+
+    // Operations
+    /**
+     * @brief Finds an element with a specific key
+     *
+     * @param k The key to search for
+     * @return iterator Returns an iterator to the element, or to
+     * flat_map::end if the key is not found
+     */
+    iterator find( const key_type &k ) { return _at( _find( k ) ); };
+
+    const_iterator find( const key_type &k ) const
+    {
+        return _at( _find( k ) );
+    };
+
+    size_type count( const key_type &k ) const
+    {
+        return _find( k ) != size();
+    };
+
+    /**
+     * @brief The lower bound of a key
+     *
+     * @param k The key to search for
+     * @return iterator Returns an iterator to the first element not less than k
+     */
+    iterator lower_bound( const key_type &k )
+    {
+        return _at( _lower_bound( k ) );
+    };
+
+    const_iterator lower_bound( const key_type &k ) const
+    {
+        return _at( _lower_bound( k ) );
+    };
+
+    /**
+     * @brief The upper bound of a key
+     *
+     * @param k The key to search for
+     * @return iterator Returns an iterator to the first element greater than k
+     */
+    iterator upper_bound( const key_type &k )
+    {
+        return _at( _upper_bound( k ) );
+    };
+
+    const_iterator upper_bound( const key_type &k ) const
+    {
+        return _at( _upper_bound( k ) );
+    };
+
+    ft::pair<iterator, iterator> equal_range( const key_type &k )
+    {
+        size_type i = _lower_bound( k );
+        size_type j = i + ( i < size() && !_comp( k, _keys[i] ) );
+        return ft::make_pair( _at( i ), _at( j ) );
+    };
+
+    ft::pair<const_iterator, const_iterator>
+    equal_range( const key_type &k ) const
+    {
+        size_type i = _lower_bound( k );
+        size_type j = i + ( i < size() && !_comp( k, _keys[i] ) );
+        return ft::make_pair( _at( i ), _at( j ) );
+    };
+
+    // Non-member functions
+    template < typename K1, typename T1, typename C1, typename A1 >
+    friend bool operator==( const flat_map<K1, T1, C1, A1> &,
+                            const flat_map<K1, T1, C1, A1> & );
+
+    template < typename K1, typename T1, typename C1, typename A1 >
+    friend bool operator<( const flat_map<K1, T1, C1, A1> &,
+                           const flat_map<K1, T1, C1, A1> & );
+
+private:
+    iterator _at( size_type i )
+    {
+        return iterator( _keys.data() + i, _values.data() + i );
+    };
+
+    const_iterator _at( size_type i ) const
+    {
+        return const_iterator( _keys.data() + i, _values.data() + i );
+    };
+
+    size_type _lower_bound( const key_type &k ) const
+    {
+        return ft::_flat_lower_bound( _keys.data(), size(), k, _comp );
+    };
+
+    size_type _upper_bound( const key_type &k ) const
+    {
+        return ft::_flat_upper_bound( _keys.data(), size(), k, _comp );
+    };
+
+    // The index of key k, size() if it is missing
+    size_type _find( const key_type &k ) const
+    {
+        size_type i = _lower_bound( k );
+        if ( i == size() || _comp( k, _keys[i] ) ) {
+            return size();
+        }
+        return i;
+    };
+
+    void _insert_at( size_type i, const key_type &k, const mapped_type &v )
+    {
+        _keys.insert( _keys.begin() + i, k );
+        try {
+            _values.insert( _values.begin() + i, v );
+        } catch ( ... ) {
+            _keys.erase( _keys.begin() + i );
+            throw;
+        }
+    };
+
+    /**
+     * @brief Merges the unsorted keys and values of a bulk insert into the
+     * map, see _flat_select and _flat_fill. The elements of the map are
+     * swapped into place rather than copied when that cannot throw, otherwise
+     * the merge runs on copies so that a throw leaves the map as it was.
+     */
+    void _merge( key_container_type &keys, mapped_container_type &values )
+    {
+        size_type m = keys.size();
+        if ( m == 0 ) {
+            return;
+        }
+        ft::vector<size_t> order( m );
+        ft::vector<size_t> pos( m );
+
+        size_type kept = ft::_flat_select( order.data(),
+                                           pos.data(),
+                                           m,
+                                           keys.data(),
+                                           _keys.data(),
+                                           size(),
+                                           _comp );
+        if ( kept == 0 ) {
+            return;
+        }
+        if ( ft::_flat_swaps_nothrow<key_type>::value
+             && ft::_flat_swaps_nothrow<mapped_type>::value ) {
+            _merge_into(
+                _keys, _values, keys, values, order.data(), pos.data(), kept );
+            return;
+        }
+        size_type             n = size() + kept;
+        key_container_type    merged_keys( _keys.get_allocator() );
+        mapped_container_type merged_values( _values.get_allocator() );
+        merged_keys.reserve( n < capacity() ? capacity() : n );
+        merged_values.reserve( n < capacity() ? capacity() : n );
+        merged_keys.insert( merged_keys.end(), _keys.begin(), _keys.end() );
+        merged_values.insert(
+            merged_values.end(), _values.begin(), _values.end() );
+        _merge_into( merged_keys,
+                     merged_values,
+                     keys,
+                     values,
+                     order.data(),
+                     pos.data(),
+                     kept );
+        _keys.swap( merged_keys );
+        _values.swap( merged_values );
+    };
+
+    typedef ft::_flat_swapper<key_container_type>    key_swapper;
+    typedef ft::_flat_swapper<mapped_container_type> mapped_swapper;
+
+    // Appends the kept elements to the tables as placeholders, then fills
+    // both the same way
+    static void _merge_into( key_container_type    &table_keys,
+                             mapped_container_type &table_values,
+                             key_container_type    &keys,
+                             mapped_container_type &values,
+                             const size_t          *order,
+                             const size_t          *pos,
+                             size_type              kept )
+    {
+        size_type n = table_keys.size();
+        if ( n + kept > table_keys.capacity() ) {
+            table_keys.reserve( n + kept );
+            table_values.reserve( n + kept );
+        }
+        try {
+            for ( size_type b = 0; b < kept; b++ ) {
+                table_keys.push_back( keys[order[b]] );
+                table_values.push_back( values[order[b]] );
+            }
+        } catch ( ... ) {
+            table_keys.erase( table_keys.begin() + n, table_keys.end() );
+            table_values.erase( table_values.begin() + n, table_values.end() );
+            throw;
+        }
+        ft::_flat_fill( n, pos, kept, key_swapper( table_keys, keys, order ) );
+        ft::_flat_fill(
+            n, pos, kept, mapped_swapper( table_values, values, order ) );
+    };
+
+    key_container_type    _keys;
+    mapped_container_type _values;
+    key_compare           _comp;
+};
+
+template < FLAT_MAP_TEMPLATE_ARGS >
+bool operator==( const FLAT_MAP_CLASS_TYPE &lhs,
+                 const FLAT_MAP_CLASS_TYPE &rhs )
+{
+    return lhs._keys == rhs._keys && lhs._values == rhs._values;
+}
+
+template < FLAT_MAP_TEMPLATE_ARGS >
+bool operator!=( const FLAT_MAP_CLASS_TYPE &lhs,
+                 const FLAT_MAP_CLASS_TYPE &rhs )
+{
+    return !( lhs == rhs );
+}
+
+// Compares the elements in order, as ft::map does
+template < FLAT_MAP_TEMPLATE_ARGS >
+bool operator<( const FLAT_MAP_CLASS_TYPE &lhs, const FLAT_MAP_CLASS_TYPE &rhs )
+{
+    size_t n = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+    for ( size_t i = 0; i < n; i++ ) {
+        if ( lhs._keys[i] < rhs._keys[i] )
+            return true;
+        if ( rhs._keys[i] < lhs._keys[i] )
+            return false;
+        if ( lhs._values[i] < rhs._values[i] )
+            return true;
+        if ( rhs._values[i] < lhs._values[i] )
+            return false;
+    }
+    return lhs.size() < rhs.size();
+}
+
+template < FLAT_MAP_TEMPLATE_ARGS >
+bool operator<=( const FLAT_MAP_CLASS_TYPE &lhs,
+                 const FLAT_MAP_CLASS_TYPE &rhs )
+{
+    return !( rhs < lhs );
+}
+
+template < FLAT_MAP_TEMPLATE_ARGS >
+bool operator>( const FLAT_MAP_CLASS_TYPE &lhs, const FLAT_MAP_CLASS_TYPE &rhs )
+{
+    return rhs < lhs;
+}
+
+template < FLAT_MAP_TEMPLATE_ARGS >
+bool operator>=( const FLAT_MAP_CLASS_TYPE &lhs,
+                 const FLAT_MAP_CLASS_TYPE &rhs )
+{
+    return !( lhs < rhs );
+}
+
+template < FLAT_MAP_TEMPLATE_ARGS >
+void swap( FLAT_MAP_CLASS_TYPE &x, FLAT_MAP_CLASS_TYPE &y )
+{
+    x.swap( y );
+}
+
+template < FLAT_MAP_TEMPLATE_ARGS >
+struct is_swap_relocatable< FLAT_MAP_CLASS_TYPE > : bool_constant<true> {};
+
+} // namespace ft
+
+#endif // FLAT_MAP_HPP
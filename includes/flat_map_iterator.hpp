@@ -0,0 +1,204 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef FLAT_MAP_ITERATOR_HPP
+#define FLAT_MAP_ITERATOR_HPP
+
+#include "iterator_traits.hpp"
+#include "utility.hpp"
+
+namespace ft {
+
+/**
+ * @brief What a flat_map iterator points to: a key and its mapped value,
+ * which flat_map keeps in two separate arrays. Reads and writes go through to
+ * the arrays, as with ft::pair<const Key &, Mapped &>, which C++98 cannot
+ * spell.
+ */
+template < typename Key, typename Mapped >
+struct flat_map_reference
+{
+    const Key &first;
+    Mapped    &second;
+
+    flat_map_reference( const Key &k, Mapped &m ) : first( k ), second( m ) {};
+
+    template < typename U, typename V >
+    operator ft::pair<U, V>() const
+    {
+        return ft::pair<U, V>( first, second );
+    };
+};
+
+/**
+ * @brief Random access iterator over the keys and mapped values of a
+ * flat_map, stepping through both arrays at once.
+ *
+ * @tparam Key The key type.
+ * @tparam T The mapped type.
+ * @tparam Mapped T, or const T for a const_iterator.
+ */
+template < typename Key, typename T, typename Mapped = T >
+class flat_map_iterator {
+public:
+    typedef ft::pair<Key, T>                value_type;
+    typedef ptrdiff_t                       difference_type;
+    typedef flat_map_reference<Key, Mapped> reference;
+    typedef random_access_iterator_tag      iterator_category;
+
+    // Holds the reference it->first and it->second go through
+    class pointer {
+    public:
+        explicit pointer( const reference &ref ) : _ref( ref ) {};
+
+        const reference *operator->() const { return &_ref; };
+
+    private:
+        reference _ref;
+    };
+
+    // Constructors
+    flat_map_iterator() : _key( NULL ), _mapped( NULL ) {};
+
+    flat_map_iterator( const Key *key, Mapped *mapped ) :
+        _key( key ), _mapped( mapped ) {};
+
+    template < typename OtherMapped >
+    flat_map_iterator( const flat_map_iterator<Key, T, OtherMapped> &it ) :
+        _key( it.key_base() ), _mapped( it.mapped_base() ) {};
+
+    // Accessors
+    const Key *key_base() const { return _key; };
+
+    Mapped *mapped_base() const { return _mapped; };
+
+    // Operators
+    reference operator*() const { return reference( *_key, *_mapped ); };
+
+    pointer operator->() const { return pointer( operator*() ); };
+
+    reference operator[]( difference_type n ) const
+    {
+        return reference( _key[n], _mapped[n] );
+    };
+
+    flat_map_iterator &operator++()
+    {
+        ++_key;
+        ++_mapped;
+        return *this;
+    };
+
+    flat_map_iterator operator++( int )
+    {
+        flat_map_iterator tmp = *this;
+        ++*this;
+        return tmp;
+    };
+
+    flat_map_iterator &operator--()
+    {
+        --_key;
+        --_mapped;
+        return *this;
+    };
+
+    flat_map_iterator operator--( int )
+    {
+        flat_map_iterator tmp = *this;
+        --*this;
+        return tmp;
+    };
+
+    flat_map_iterator &operator+=( difference_type n )
+    {
+        _key    += n;
+        _mapped += n;
+        return *this;
+    };
+
+    flat_map_iterator &operator-=( difference_type n )
+    {
+        _key    -= n;
+        _mapped -= n;
+        return *this;
+    };
+
+    flat_map_iterator operator+( difference_type n ) const
+    {
+        return flat_map_iterator( _key + n, _mapped + n );
+    };
+
+    flat_map_iterator operator-( difference_type n ) const
+    {
+        return flat_map_iterator( _key - n, _mapped - n );
+    };
+
+private:
+    const Key *_key;
+    Mapped    *_mapped;
+};
+
+template < typename Key, typename T, typename M >
+inline flat_map_iterator<Key, T, M>
+operator+( typename flat_map_iterator<Key, T, M>::difference_type n,
+           const flat_map_iterator<Key, T, M>                    &it )
+{
+    return it + n;
+}
+
+// Comparisons and differences between iterators and const_iterators look at
+// the keys only, both arrays move together
+
+template < typename Key, typename T, typename M1, typename M2 >
+inline ptrdiff_t operator-( const flat_map_iterator<Key, T, M1> &lhs,
+                            const flat_map_iterator<Key, T, M2> &rhs )
+{
+    return lhs.key_base() - rhs.key_base();
+}
+
+template < typename Key, typename T, typename M1, typename M2 >
+inline bool operator==( const flat_map_iterator<Key, T, M1> &lhs,
+                        const flat_map_iterator<Key, T, M2> &rhs )
+{
+    return lhs.key_base() == rhs.key_base();
+}
+
+template < typename Key, typename T, typename M1, typename M2 >
+inline bool operator!=( const flat_map_iterator<Key, T, M1> &lhs,
+                        const flat_map_iterator<Key, T, M2> &rhs )
+{
+    return lhs.key_base() != rhs.key_base();
+}
+
+template < typename Key, typename T, typename M1, typename M2 >
+inline bool operator<( const flat_map_iterator<Key, T, M1> &lhs,
+                       const flat_map_iterator<Key, T, M2> &rhs )
+{
+    return lhs.key_base() < rhs.key_base();
+}
+
+template < typename Key, typename T, typename M1, typename M2 >
+inline bool operator<=( const flat_map_iterator<Key, T, M1> &lhs,
+                        const flat_map_iterator<Key, T, M2> &rhs )
+{
+    return lhs.key_base() <= rhs.key_base();
+}
+
+template < typename Key, typename T, typename M1, typename M2 >
+inline bool operator>( const flat_map_iterator<Key, T, M1> &lhs,
+                       const flat_map_iterator<Key, T, M2> &rhs )
+{
+    return lhs.key_base() > rhs.key_base();
+}
+
+template < typename Key, typename T, typename M1, typename M2 >
+inline bool operator>=( const flat_map_iterator<Key, T, M1> &lhs,
+                        const flat_map_iterator<Key, T, M2> &rhs )
+{
+    return lhs.key_base() >= rhs.key_base();
+}
+
+} // namespace ft
+
+#endif // FLAT_MAP_ITERATOR_HPP
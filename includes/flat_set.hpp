@@ -0,0 +1,433 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef FLAT_SET_HPP
+#define FLAT_SET_HPP
+
+#define FLAT_SET_TEMPLATE_ARGS typename T, typename Compare, typename Alloc
+#define FLAT_SET_CLASS_TYPE flat_set<T, Compare, Alloc>
+
+#include "flat_algorithm.hpp"
+#include "functional.hpp"
+#include "utility.hpp"
+#include "vector.hpp"
+
+namespace ft {
+
+/**
+ * @brief A set stored as a sorted ft::vector. Lookups binary search it without
+ * branching, and the elements take no memory besides themselves. Inserting or
+ * erasing a single element moves the ones after it, so sets are best built in
+ * bulk, see insert( first, last ).
+ */
+template < class T,
+           class Compare = ft::less<T>,
+           class Alloc   = std::allocator<T> >
+class flat_set {
+public:
+    typedef T                               key_type;
+    typedef T                               value_type;
+    typedef Compare                         key_compare;
+    typedef Compare                         value_compare;
+    typedef Alloc                           allocator_type;
+    typedef typename Alloc::reference       reference;
+    typedef typename Alloc::const_reference const_reference;
+    typedef typename Alloc::pointer         pointer;
+    typedef typename Alloc::const_pointer   const_pointer;
+    typedef ft::vector<T, Alloc>            container_type;
+
+    typedef typename container_type::size_type       size_type;
+    typedef typename container_type::difference_type difference_type;
+
+    // The elements are sorted, so iterators only give read access
+    typedef typename container_type::const_iterator iterator;
+    typedef typename container_type::const_iterator const_iterator;
+    typedef typename container_type::const_reverse_iterator reverse_iterator;
+    typedef
+        typename container_type::const_reverse_iterator const_reverse_iterator;
+
+    // Constructors
+    explicit flat_set( const key_compare    &comp  = key_compare(),
+                       const allocator_type &alloc = allocator_type() ) :
+        _elements( alloc ), _comp( comp ) {};
+
+    template <class InputIterator>
+    flat_set( InputIterator         first,
+              InputIterator         last,
+              const key_compare    &comp  = key_compare(),
+              const allocator_type &alloc = allocator_type() ) :
+        _elements( alloc ), _comp( comp )
+    {
+        insert( first, last );
+    };
+
+    flat_set( const flat_set &s ) :
+        _elements( s._elements ), _comp( s._comp ) {};
+
+    // Destructor
+    ~flat_set() {};
+
+    // Assignment operator
+    flat_set &operator=( const flat_set &s )
+    {
+        if ( this != &s ) {
+            _elements = s._elements;
+            _comp     = s._comp;
+        }
+        return *this;
+    };
+
+    // Iterators
+    iterator begin() const { return _elements.begin(); };
+    iterator end() const { return _elements.end(); };
+
+    reverse_iterator rbegin() const { return _elements.rbegin(); };
+    reverse_iterator rend() const { return _elements.rend(); };
+
+    // Capacity
+    bool      empty() const { return _elements.empty(); };
+    size_type size() const { return _elements.size(); };
+    size_type max_size() const { return _elements.max_size(); };
+    size_type capacity() const { return _elements.capacity(); };
+
+    /**
+     * @brief Allocates room for n elements, so inserts, single or in bulk,
+     * do not reallocate while the set holds at most n elements. Bulk inserts
+     * of elements that may throw when swapped still build a new array, see
+     * _flat_swaps_nothrow.
+     *
+     * @param n The number of elements to make room for.
+     */
+    void reserve( size_type n ) { _elements.reserve( n ); };
+
+    /**
+     * @brief Frees the room for elements past size(), once a set is built.
+     */
+    void shrink_to_fit() { _elements.shrink_to_fit(); };
+
+    // Modifiers
+    /**
+     * @brief Inserts an element unless an equivalent one is in the set,
+     * moving the elements after it.
+     *
+     * @param val The value to insert.
+     * @return ft::pair<iterator, bool> The element equivalent to val, and
+     * whether it was inserted.
+     */
+    ft::pair<iterator, bool> insert( const value_type &val )
+    {
+        size_type i = _lower_bound( val );
+        if ( i < size() && !_comp( val, _elements[i] ) ) {
+            return ft::make_pair( begin() + i, false );
+        }
+        _elements.insert( _elements.begin() + i, val );
+        return ft::make_pair( begin() + i, true );
+    };
+
+    /**
+     * @brief Inserts an element unless an equivalent one is in the set,
+     * without a search when it belongs right before position.
+     *
+     * @param position The position to try first.
+     * @param val The value to insert.
+     * @return iterator The element equivalent to val.
+     */
+    iterator insert( iterator position, const value_type &val )
+    {
+        size_type i = position - begin();
+        if ( ( i == size() || _comp( val, _elements[i] ) )
+             && ( i == 0 || _comp( _elements[i - 1], val ) ) ) {
+            _elements.insert( _elements.begin() + i, val );
+            return begin() + i;
+        }
+        return insert( val ).first;
+    };
+
+    /**
+     * @brief Inserts the elements of a range that are not in the set, the
+     * first of equivalent ones in the range winning. The range is sorted once
+     * and merged with the set in place, in O(n + m log m) for m new elements.
+     *
+     * @tparam InputIterator The type of the iterator.
+     * @param first The first element of the range.
+     * @param last The element past the range.
+     */
+    template <class InputIterator>
+    void insert( InputIterator first, InputIterator last )
+    {
+        container_type values( _elements.get_allocator() );
+        for ( ; first != last; ++first ) {
+            values.push_back( *first );
+        }
+        _merge( values );
+    };
+
+    /**
+     * @brief Erases an element from the set.
+     *
+     * @param position The position of the element to erase.
+     */
+    void erase( iterator position ) { erase( position, position + 1 ); };
+
+    /**
+     * @brief Erases the element equivalent to val, if any.
+     *
+     * @param val The value to erase.
+     * @return size_type The number of elements erased.
+     */
+    size_type erase( const value_type &val )
+    {
+        size_type i = _find( val );
+        if ( i == size() ) {
+            return 0;
+        }
+        erase( begin() + i );
+        return 1;
+    };
+
+    /**
+     * @brief Erases a range of elements from the set.
+     *
+     * @param first The first element of the range.
+     * @param last The element past the range.
+     */
+    void erase( iterator first, iterator last )
+    {
+        _elements.erase( _elements.begin() + ( first - begin() ),
+                         _elements.begin() + ( last - begin() ) );
+    };
+
+    /**
+     * @brief Swaps the contents of two sets.
+     *
+     * @param s The set to swap with.
+     */
+    void swap( flat_set &s )
+    {
+        key_compare tmp = _comp;
+        _elements.swap( s._elements );
+        _comp   = s._comp;
+        s._comp = tmp;
+    };
+
+    /**
+     * @brief Clears the set.
+     */
+    void clear() { _elements.clear(); };
+
+    // Observers
+    key_compare key_comp() const { return _comp; };
+
+    value_compare value_comp() const { return _comp; };
+
+    /**
+     * @brief The sorted array of elements.
+     */
+    const container_type &elements() const { return _elements; };
+
+    allocator_type get_allocator() const { return _elements.get_allocator(); };
+
+    // Operations
+    /**
+     * @brief Finds an element in the set.
+     *
+     * @param val The value to find.
+     * @return iterator The iterator to the element, or end() if not found.
+     */
+    iterator find( const value_type &val ) const
+    {
+        return begin() + _find( val );
+    };
+
+    /**
+     * @brief Counts the elements equivalent to a given value.
+     *
+     * @param val The value to count.
+     * @return size_type 1 if the set holds it, 0 otherwise.
+     */
+    size_type count( const value_type &val ) const
+    {
+        return _find( val ) != size();
+    };
+
+    /**
+     * @brief Finds the first element not less than a given value.
+     *
+     * @param val The value to search for.
+     * @return iterator The iterator to the element, or end() if not found.
+     */
+    iterator lower_bound( const value_type &val ) const
+    {
+        return begin() + _lower_bound( val );
+    };
+
+    /**
+     * @brief Finds the first element greater than a given value.
+     *
+     * @param val The value to search for.
+     * @return iterator The iterator to the element, or end() if not found.
+     */
+    iterator upper_bound( const value_type &val ) const
+    {
+        return begin()
+             + ft::_flat_upper_bound( _elements.data(), size(), val, _comp );
+    };
+
+    /**
+     * @brief Finds the range of elements equivalent to a given value.
+     *
+     * @param val The value to search for.
+     * @return ft::pair<iterator, iterator> A pair containing the lower and
+     * upper bounds of the range.
+     */
+    ft::pair<iterator, iterator> equal_range( const value_type &val ) const
+    {
+        size_type i = _lower_bound( val );
+        size_type j = i + ( i < size() && !_comp( val, _elements[i] ) );
+        return ft::make_pair( begin() + i, begin() + j );
+    };
+
+    // Non-member functions
+    template <typename T1, typename C1, typename A1>
+    friend bool operator==( const flat_set<T1, C1, A1> &lhs,
+                            const flat_set<T1, C1, A1> &rhs );
+
+    template <typename T1, typename C1, typename A1>
+    friend bool operator<( const flat_set<T1, C1, A1> &lhs,
+                           const flat_set<T1, C1, A1> &rhs );
+
+private:
+    size_type _lower_bound( const value_type &val ) const
+    {
+        return ft::_flat_lower_bound( _elements.data(), size(), val, _comp );
+    };
+
+    // The index of the element equivalent to val, size() if there is none
+    size_type _find( const value_type &val ) const
+    {
+        size_type i = _lower_bound( val );
+        if ( i == size() || _comp( val, _elements[i] ) ) {
+            return size();
+        }
+        return i;
+    };
+
+    /**
+     * @brief Merges the unsorted values of a bulk insert into the set, see
+     * _flat_select and _flat_fill. The elements of the set are swapped into
+     * place rather than copied when that cannot throw, otherwise the merge
+     * runs on a copy so that a throw leaves the set as it was.
+     */
+    void _merge( container_type &values )
+    {
+        size_type m = values.size();
+        if ( m == 0 ) {
+            return;
+        }
+        ft::vector<size_t> order( m );
+        ft::vector<size_t> pos( m );
+
+        size_type kept = ft::_flat_select( order.data(),
+                                           pos.data(),
+                                           m,
+                                           values.data(),
+                                           _elements.data(),
+                                           size(),
+                                           _comp );
+        if ( kept == 0 ) {
+            return;
+        }
+        if ( ft::_flat_swaps_nothrow<value_type>::value ) {
+            _merge_into( _elements, values, order.data(), pos.data(), kept );
+            return;
+        }
+        size_type      n = size() + kept;
+        container_type merged( _elements.get_allocator() );
+        merged.reserve( n < capacity() ? capacity() : n );
+        merged.insert( merged.end(), _elements.begin(), _elements.end() );
+        _merge_into( merged, values, order.data(), pos.data(), kept );
+        _elements.swap( merged );
+    };
+
+    typedef ft::_flat_swapper<container_type> swapper;
+
+    // Appends the kept values to table as placeholders, then fills it
+    static void _merge_into( container_type &table,
+                             container_type &values,
+                             const size_t   *order,
+                             const size_t   *pos,
+                             size_type       kept )
+    {
+        size_type n = table.size();
+        if ( n + kept > table.capacity() ) {
+            table.reserve( n + kept );
+        }
+        try {
+            for ( size_type b = 0; b < kept; b++ ) {
+                table.push_back( values[order[b]] );
+            }
+        } catch ( ... ) {
+            table.erase( table.begin() + n, table.end() );
+            throw;
+        }
+        ft::_flat_fill( n, pos, kept, swapper( table, values, order ) );
+    };
+
+    container_type _elements;
+    key_compare    _comp;
+};
+
+template < FLAT_SET_TEMPLATE_ARGS >
+inline bool operator==( const FLAT_SET_CLASS_TYPE &lhs,
+                        const FLAT_SET_CLASS_TYPE &rhs )
+{
+    return lhs._elements == rhs._elements;
+}
+
+template < FLAT_SET_TEMPLATE_ARGS >
+inline bool operator!=( const FLAT_SET_CLASS_TYPE &lhs,
+                        const FLAT_SET_CLASS_TYPE &rhs )
+{
+    return !( lhs == rhs );
+}
+
+template < FLAT_SET_TEMPLATE_ARGS >
+inline bool operator<( const FLAT_SET_CLASS_TYPE &lhs,
+                       const FLAT_SET_CLASS_TYPE &rhs )
+{
+    return lhs._elements < rhs._elements;
+}
+
+template < FLAT_SET_TEMPLATE_ARGS >
+inline bool operator<=( const FLAT_SET_CLASS_TYPE &lhs,
+                        const FLAT_SET_CLASS_TYPE &rhs )
+{
+    return !( rhs < lhs );
+}
+
+template < FLAT_SET_TEMPLATE_ARGS >
+inline bool operator>( const FLAT_SET_CLASS_TYPE &lhs,
+                       const FLAT_SET_CLASS_TYPE &rhs )
+{
+    return rhs < lhs;
+}
+
+template < FLAT_SET_TEMPLATE_ARGS >
+inline bool operator>=( const FLAT_SET_CLASS_TYPE &lhs,
+                        const FLAT_SET_CLASS_TYPE &rhs )
+{
+    return !( lhs < rhs );
+}
+
+template < FLAT_SET_TEMPLATE_ARGS >
+inline void swap( FLAT_SET_CLASS_TYPE &lhs, FLAT_SET_CLASS_TYPE &rhs )
+{
+    lhs.swap( rhs );
+}
+
+template < FLAT_SET_TEMPLATE_ARGS >
+struct is_swap_relocatable< FLAT_SET_CLASS_TYPE > : bool_constant<true> {};
+
+} // namespace ft
+
+#endif // FLAT_SET_HPP
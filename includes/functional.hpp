@@ -4,6 +4,8 @@
 #ifndef FUNCTIONAL_HPP
 #define FUNCTIONAL_HPP
 
+#include "type_traits.hpp"
+
 namespace ft {
 
 template <typename T>
@@ -12,6 +14,38 @@ struct less
     bool operator()( const T &lhs, const T &rhs ) const { return lhs < rhs; };
 };
 
+/**
+ * @brief Compares values of any two types with operator<. Being transparent,
+ * it lets ft::map and ft::set look keys up without converting them to
+ * key_type, e.g. a const char * in a map of std::string.
+ */
+template <>
+struct less<void>
+{
+    typedef void is_transparent;
+
+    template < typename T, typename U >
+    bool operator()( const T &lhs, const U &rhs ) const
+    {
+        return lhs < rhs;
+    };
+};
+
+/**
+ * @brief Whether Compare declares `is_transparent`, so that lookups may
+ * compare a K with the keys directly. K only delays the check until a lookup
+ * is instantiated.
+ */
+template < typename Compare, typename K, typename = void >
+struct _is_transparent : bool_constant<false> {};
+
+template < typename Compare, typename K >
+struct _is_transparent<
+    Compare,
+    K,
+    typename _void_type<typename Compare::is_transparent>::type >
+    : bool_constant<true> {};
+
 } // namespace ft
 
 #endif // FUNCTIONAL_HPP
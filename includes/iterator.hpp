@@ -4,6 +4,7 @@
 #ifndef ITERATOR_HPP
 #define ITERATOR_HPP
 
+#include "config.hpp"
 #include "iterator_traits.hpp"
 #include "reverse_iterator.hpp"
 #include <cstddef>
@@ -12,11 +13,78 @@ using namespace ft;
 
 namespace ft {
 
+/**
+ * @brief Bounds of the sequence an iterator points into. With
+ * FT_CONTAINERS_DEBUG defined they are recorded by the container and checked
+ * on every dereference and arithmetic step, otherwise the class is empty and
+ * the checks compile to nothing.
+ *
+ * @tparam Iterator The underlying pointer type.
+ */
+template < typename Iterator >
+class checked_bounds {
+    template < typename It >
+    friend class checked_bounds;
+
+public:
+#ifdef FT_CONTAINERS_DEBUG
+    checked_bounds() : _first(), _last(), _checked( false ) {};
+    checked_bounds( const Iterator &first, const Iterator &last ) :
+        _first( first ), _last( last ), _checked( true ) {};
+    template < typename It >
+    checked_bounds( const checked_bounds<It> &other ) :
+        _first( other._first ), _last( other._last ),
+        _checked( other._checked ) {};
+
+protected:
+    void _check_dereferenceable( const Iterator &it ) const
+    {
+        FT_ASSERT( !_checked || ( _first <= it && it < _last ),
+                   "iterator is not dereferenceable" );
+    };
+
+    void _check_in_range( const Iterator &it ) const
+    {
+        FT_ASSERT( !_checked || ( _first <= it && it <= _last ),
+                   "iterator moved out of its sequence" );
+    };
+
+    template < typename It >
+    void _check_same_range( const checked_bounds<It> &other ) const
+    {
+        FT_ASSERT( !_checked || !other._checked || _first == other._first,
+                   "iterators belong to different sequences" );
+    };
+
+private:
+    Iterator _first;
+    Iterator _last;
+    bool     _checked;
+#else
+    checked_bounds() {};
+    checked_bounds( const Iterator &, const Iterator & ) {};
+    template < typename It >
+    checked_bounds( const checked_bounds<It> & ) {};
+
+protected:
+    void _check_dereferenceable( const Iterator & ) const {};
+    void _check_in_range( const Iterator & ) const {};
+    template < typename It >
+    void _check_same_range( const checked_bounds<It> & ) const {};
+#endif
+};
+
 // creates a random access iterator
 
 template < typename Iterator >
 class random_access_iterator
-    : public iterator<random_access_iterator_tag, Iterator> {
+    : public iterator<random_access_iterator_tag, Iterator>,
+      protected checked_bounds<Iterator> {
+    template < typename It >
+    friend class random_access_iterator;
+
+    typedef checked_bounds<Iterator> bounds_type;
+
 public:
     typedef Iterator                                            iterator_type;
     typedef typename iterator_traits<Iterator>::value_type      value_type;
@@ -28,10 +96,16 @@ public:
 
     random_access_iterator() : _it() {};
     explicit random_access_iterator( const iterator_type &it ) : _it( it ) {};
+    random_access_iterator( const iterator_type &it,
+                            const iterator_type &first,
+                            const iterator_type &last ) :
+        bounds_type( first, last ),
+        _it( it ) {};
     random_access_iterator( const random_access_iterator &it ) :
-        _it( it.base() ) {};
+        bounds_type( it ), _it( it.base() ) {};
     template < typename It >
     random_access_iterator( const random_access_iterator<It> &it ) :
+        bounds_type( static_cast<const checked_bounds<It> &>( it ) ),
         _it( it.base() ) {};
     ~random_access_iterator() {};
 
@@ -39,59 +113,79 @@ public:
     const iterator_type &base() const { return _it; };
 
     // iterator operations
-    reference operator*() const { return *_it; };
+    reference operator*() const
+    {
+        this->_check_dereferenceable( _it );
+        return *_it;
+    };
 
     random_access_iterator operator+( difference_type n ) const
     {
-        return random_access_iterator( _it + n );
+        random_access_iterator tmp( *this );
+        return tmp += n;
     };
 
     random_access_iterator operator++( int )
     {
         random_access_iterator tmp = *this;
         ++_it;
+        this->_check_in_range( _it );
         return tmp;
     };
 
     random_access_iterator &operator++()
     {
         ++_it;
+        this->_check_in_range( _it );
         return *this;
     };
 
     random_access_iterator &operator+=( difference_type n )
     {
         _it += n;
+        this->_check_in_range( _it );
         return *this;
     };
 
     random_access_iterator operator-( difference_type n ) const
     {
-        return random_access_iterator( _it - n );
+        random_access_iterator tmp( *this );
+        return tmp -= n;
     };
 
     random_access_iterator operator--( int )
     {
         random_access_iterator tmp = *this;
         --_it;
+        this->_check_in_range( _it );
         return tmp;
     };
 
     random_access_iterator &operator--()
     {
         --_it;
+        this->_check_in_range( _it );
         return *this;
     };
 
     random_access_iterator &operator-=( difference_type n )
     {
         _it -= n;
+        this->_check_in_range( _it );
         return *this;
     };
 
-    pointer operator->() const { return _it; };
+    pointer operator->() const
+    {
+        this->_check_dereferenceable( _it );
+        return _it;
+    };
 
-    reference operator[]( difference_type n ) const { return _it[n]; };
+    reference operator[]( difference_type n ) const
+    {
+        this->_check_dereferenceable( _it + n );
+        return _it[n];
+    };
 
     // comparison operations
     bool operator==( const random_access_iterator &rhs ) const
@@ -127,12 +221,22 @@ public:
     // arithmetic operations
     difference_type operator-( const random_access_iterator &rhs ) const
     {
+        this->_check_same_range( rhs );
+        return _it - rhs.base();
+    };
+
+    template < typename It >
+    difference_type distance_from( const random_access_iterator<It> &rhs ) const
+    {
+        this->_check_same_range(
+            static_cast<const checked_bounds<It> &>( rhs ) );
         return _it - rhs.base();
     };
 
     // assignment operations
     random_access_iterator &operator=( const random_access_iterator &rhs )
     {
+        bounds_type::operator=( rhs );
         _it = rhs.base();
         return *this;
     };
@@ -140,6 +244,8 @@ public:
     template < typename It >
     random_access_iterator &operator=( const random_access_iterator<It> &rhs )
     {
+        bounds_type::operator=(
+            bounds_type( static_cast<const checked_bounds<It> &>( rhs ) ) );
         _it = rhs.base();
         return *this;
     };
@@ -148,15 +254,15 @@ public:
     template < typename It >
     operator random_access_iterator<It>() const
     {
-        return random_access_iterator<It>( _it );
+        return random_access_iterator<It>( *this );
     };
 
     // swap operations
     void swap( random_access_iterator &rhs )
     {
-        iterator_type tmp = _it;
-        _it               = rhs.base();
-        rhs._it           = tmp;
+        random_access_iterator tmp = *this;
+        *this                      = rhs;
+        rhs                        = tmp;
     };
 
 protected:
@@ -175,7 +281,7 @@ inline random_access_iterator<Iterator>
 operator+( typename random_access_iterator<Iterator>::difference_type n,
            const random_access_iterator<Iterator>                    &it )
 {
-    return random_access_iterator<Iterator>( it.base() + n );
+    return it + n;
 }
 
 template < typename Iterator >
@@ -183,7 +289,7 @@ inline typename random_access_iterator<Iterator>::difference_type
 operator-( const random_access_iterator<Iterator> &lhs,
            const random_access_iterator<Iterator> &rhs )
 {
-    return lhs.base() - rhs.base();
+    return lhs.distance_from( rhs );
 }
 
 template < typename Iterator >
@@ -275,7 +381,7 @@ inline random_access_iterator<It1>
 operator+( typename random_access_iterator<It1>::difference_type n,
            const random_access_iterator<It2>                    &it )
 {
-    return random_access_iterator<It1>( it.base() + n );
+    return random_access_iterator<It1>( it + n );
 }
 
 template < typename It1, typename It2 >
@@ -283,7 +389,24 @@ inline typename random_access_iterator<It1>::difference_type
 operator-( const random_access_iterator<It1> &lhs,
            const random_access_iterator<It2> &rhs )
 {
-    return lhs.base() - rhs.base();
+    return lhs.distance_from( rhs );
+}
+
+/**
+ * @brief Returns the pointer wrapped by a random_access_iterator, so that
+ * algorithms can take their pointer fast paths. Other iterators are returned
+ * unchanged.
+ */
+template < typename It >
+inline It _unwrap( It it )
+{
+    return it;
+}
+
+template < typename Iterator >
+inline Iterator _unwrap( const random_access_iterator<Iterator> &it )
+{
+    return it.base();
 }
 
 } // namespace ft
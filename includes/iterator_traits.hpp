@@ -5,14 +5,20 @@
 #define ITERATOR_TRAITS_HPP
 
 #include <cstddef>
+#include <iterator>
 
 namespace ft {
 
-class input_iterator_tag {};
-class output_iterator_tag {};
-class forward_iterator_tag : public input_iterator_tag {};
-class bidirectional_iterator_tag : public forward_iterator_tag {};
-class random_access_iterator_tag : public bidirectional_iterator_tag {};
+/**
+ * The iterator tags are the standard ones, so that algorithms dispatching on
+ * the category handle the standard iterators (e.g. std::istream_iterator)
+ * and ours alike.
+ */
+typedef std::input_iterator_tag         input_iterator_tag;
+typedef std::output_iterator_tag        output_iterator_tag;
+typedef std::forward_iterator_tag       forward_iterator_tag;
+typedef std::bidirectional_iterator_tag bidirectional_iterator_tag;
+typedef std::random_access_iterator_tag random_access_iterator_tag;
 
 template < typename Category,
            typename T,
@@ -59,9 +65,9 @@ struct iterator_traits<const T *>
 };
 
 // Iterator operations
-template <typename InputIt>
-typename iterator_traits<InputIt>::difference_type distance( InputIt first,
-                                                             InputIt last )
+template < typename InputIt >
+typename iterator_traits<InputIt>::difference_type
+_distance( InputIt first, InputIt last, input_iterator_tag )
 {
     typename iterator_traits<InputIt>::difference_type result = 0;
     while ( first != last ) {
@@ -71,8 +77,27 @@ typename iterator_traits<InputIt>::difference_type distance( InputIt first,
     return result;
 }
 
-template <typename InputIt, typename Distance>
-void advance( InputIt &it, Distance n )
+template < typename RandomIt >
+typename iterator_traits<RandomIt>::difference_type
+_distance( RandomIt first, RandomIt last, random_access_iterator_tag )
+{
+    return last - first;
+}
+
+/**
+ * @brief Counts the steps from first to last, in constant time for random
+ * access iterators.
+ */
+template < typename InputIt >
+typename iterator_traits<InputIt>::difference_type distance( InputIt first,
+                                                             InputIt last )
+{
+    typename iterator_traits<InputIt>::iterator_category category;
+    return ft::_distance( first, last, category );
+}
+
+template < typename InputIt, typename Distance >
+void _advance( InputIt &it, Distance n, input_iterator_tag )
 {
     while ( n > 0 ) {
         --n;
@@ -80,6 +105,36 @@ void advance( InputIt &it, Distance n )
     }
 }
 
+template < typename BidirIt, typename Distance >
+void _advance( BidirIt &it, Distance n, bidirectional_iterator_tag )
+{
+    while ( n > 0 ) {
+        --n;
+        ++it;
+    }
+    while ( n < 0 ) {
+        ++n;
+        --it;
+    }
+}
+
+template < typename RandomIt, typename Distance >
+void _advance( RandomIt &it, Distance n, random_access_iterator_tag )
+{
+    it += n;
+}
+
+/**
+ * @brief Moves it by n steps, in constant time for random access iterators.
+ * n may be negative for bidirectional iterators.
+ */
+template < typename InputIt, typename Distance >
+void advance( InputIt &it, Distance n )
+{
+    typename iterator_traits<InputIt>::iterator_category category;
+    ft::_advance( it, n, category );
+}
+
 } // namespace ft
 
 #endif // ITERATOR_TRAITS_HPP
@@ -0,0 +1,129 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef MALLOC_ALLOCATOR_HPP
+#define MALLOC_ALLOCATOR_HPP
+
+#include "config.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+namespace ft {
+
+/**
+ * @brief Allocator backed by malloc and free that can grow a buffer with
+ * realloc. The C library extends the block in place when the memory after it
+ * is free and remaps large blocks instead of copying them, so containers of
+ * trivially relocatable elements grow without keeping two buffers alive.
+ *
+ * @tparam T The type of the elements to allocate.
+ */
+template < typename T >
+class malloc_allocator {
+public:
+    typedef T                       value_type;
+    typedef T                      *pointer;
+    typedef const T                *const_pointer;
+    typedef T                      &reference;
+    typedef const T                &const_reference;
+    typedef size_t                  size_type;
+    typedef ptrdiff_t               difference_type;
+    typedef ft::bool_constant<true> can_reallocate;
+
+    template < typename U >
+    struct rebind
+    {
+        typedef malloc_allocator<U> other;
+    };
+
+    malloc_allocator() {};
+    malloc_allocator( const malloc_allocator & ) {};
+    template < typename U >
+    malloc_allocator( const malloc_allocator<U> & ) {};
+    ~malloc_allocator() {};
+
+    pointer       address( reference x ) const { return &x; };
+    const_pointer address( const_reference x ) const { return &x; };
+
+    /**
+     * @brief Allocates uninitialized storage for n elements. Never returns
+     * NULL, even for n == 0.
+     *
+     * @param n The number of elements to allocate.
+     * @return pointer The allocated storage.
+     */
+    pointer allocate( size_type n, const void * = 0 )
+    {
+        if ( n > max_size() )
+            throw std::bad_alloc();
+        void *p = std::malloc( n > 0 ? n * sizeof( T ) : 1 );
+        if ( p == NULL )
+            throw std::bad_alloc();
+        return static_cast<pointer>( p );
+    };
+
+    void deallocate( pointer p, size_type ) { std::free( p ); };
+
+    /**
+     * @brief Grows or shrinks the storage at p from old_n to new_n elements,
+     * in place when possible. The first min(old_n, new_n) elements are moved
+     * bytewise, so it may only be used for trivially relocatable elements. On
+     * failure p is left untouched.
+     *
+     * @param p The storage to resize, returned by allocate or reallocate.
+     * @param old_n The number of elements p was allocated for.
+     * @param new_n The number of elements to allocate.
+     * @return pointer The resized storage, which may differ from p.
+     */
+    pointer reallocate( pointer p, size_type old_n, size_type new_n )
+    {
+        ( void ) old_n;
+        if ( new_n > max_size() )
+            throw std::bad_alloc();
+        void *tmp = std::realloc( p, new_n > 0 ? new_n * sizeof( T ) : 1 );
+        if ( tmp == NULL )
+            throw std::bad_alloc();
+        return static_cast<pointer>( tmp );
+    };
+
+    size_type max_size() const
+    {
+        return std::numeric_limits<size_type>::max() / sizeof( T );
+    };
+
+#if FT_CXX11
+    template < typename U, typename... Args >
+    void construct( U *p, Args &&...args )
+    {
+        ::new ( ( void * ) p ) U( std::forward<Args>( args )... );
+    };
+#else
+    void construct( pointer p, const_reference val )
+    {
+        ::new ( ( void * ) p ) T( val );
+    };
+#endif
+
+    void destroy( pointer p ) { p->~T(); };
+};
+
+template < typename T, typename U >
+inline bool operator==( const malloc_allocator<T> &,
+                        const malloc_allocator<U> & )
+{
+    return true;
+}
+
+template < typename T, typename U >
+inline bool operator!=( const malloc_allocator<T> &,
+                        const malloc_allocator<U> & )
+{
+    return false;
+}
+
+} // namespace ft
+
+#endif // MALLOC_ALLOCATOR_HPP
@@ -5,25 +5,56 @@
 #define MAP_HPP
 
 #include "functional.hpp"
+#include "node_handle.hpp"
 #include "rb_tree.hpp"
 #include "utility.hpp"
+#include <new>
 
 #define MAP_TEMPLATE_ARGS                                                      \
-    typename Key, typename T, typename Compare, typename Alloc
+    typename Key, typename T, typename Compare, typename Alloc, typename Policy
 
-#define MAP_CLASS_TYPE map< Key, T, Compare, Alloc >
+#define MAP_CLASS_TYPE map< Key, T, Compare, Alloc, Policy >
 
 namespace ft {
 
 template < typename Key,
            typename T,
            typename Compare = ft::less<Key>,
-           typename Alloc   = std::allocator<ft::pair<const Key, T> > >
+           typename Alloc   = std::allocator<ft::pair<const Key, T> >,
+           typename Policy  = ft::rb_plain_policy >
 class map {
     template < typename P >
     struct select1st
     {
-        Key operator()( const P &p ) const { return p.first; }
+        const Key &operator()( const P &p ) const { return p.first; }
+    };
+
+    // Constructs an element in the storage of a new node from its key and a
+    // factory of its mapped value, see rb_tree::emplace_unique
+    template < typename Factory >
+    struct construct_with
+    {
+        const Key     &key;
+        const Factory &make;
+
+        void operator()( ft::pair<const Key, T> *p ) const
+        {
+            ::new ( static_cast<void *>( p ) )
+                ft::pair<const Key, T>( key, make, ft::from_factory_t() );
+        }
+    };
+
+    struct value_initialized
+    {
+        T operator()() const { return T(); }
+    };
+
+    template < typename M >
+    struct converted_from
+    {
+        const M &value;
+
+        T operator()() const { return T( value ); }
     };
 
 public:
@@ -38,7 +69,7 @@ public:
 
     class value_compare
         : public std::binary_function<value_type, value_type, bool> {
-        friend class map<Key, T, Compare, Alloc>;
+        friend class map<Key, T, Compare, Alloc, Policy>;
 
     protected:
         Compare comp;
@@ -57,7 +88,8 @@ private:
                      value_type,
                      select1st<value_type>,
                      key_compare,
-                     Alloc >
+                     Alloc,
+                     Policy >
                  rb_tree_type;
     rb_tree_type _rb_tree;
 
@@ -71,6 +103,11 @@ public:
     typedef typename rb_tree_type::reverse_iterator reverse_iterator;
     typedef
         typename rb_tree_type::const_reverse_iterator const_reverse_iterator;
+    typedef map_node_handle<Key,
+                            T,
+                            typename rb_tree_type::node,
+                            allocator_type>
+        node_type;
 
     // Constructors
     explicit map( const key_compare    &comp  = key_compare(),
@@ -84,10 +121,7 @@ public:
          const allocator_type &alloc = allocator_type() ) :
         _rb_tree( comp, alloc )
     {
-        while ( first != last ) {
-            insert( *first );
-            ++first;
-        }
+        _rb_tree.insert_range( first, last );
     };
 
     map( const map &x ) : _rb_tree( x._rb_tree ) {};
@@ -120,8 +154,7 @@ public:
     // Element access
     mapped_type &operator[]( const key_type &k )
     {
-        iterator it = insert( begin(), ft::make_pair( k, mapped_type() ) );
-        return it->second;
+        return try_insert( k, value_initialized() ).first->second;
     };
 
     // Modifiers
@@ -134,32 +167,59 @@ public:
      */
     ft::pair<iterator, bool> insert( const value_type &val )
     {
-        iterator it = find( val.first );
-        if ( it != end() ) {
-            return ft::make_pair( it, false );
-        } else {
-            return ft::make_pair( _rb_tree.insert_unique( val ), true );
-        }
+        return _rb_tree.insert_unique( val );
     };
 
     /**
      * @brief Inserts a element into the map container
      *
      *
-     * @param position The iterator with the position where the element will be
-     * inserted
+     * @param position A hint for the position of the element, inserting right
+     * before or after it takes amortized constant time
      * @param val The value to insert
-     * @return iterator Returns an iterator to the inserted element
+     * @return iterator Returns an iterator to the element with the key of val
      */
     iterator insert( iterator position, const value_type &val )
     {
-        iterator it = find( val.first );
-        if ( it != end() ) {
-            return it;
-        } else {
-            _rb_tree.insert( val, position.base() );
-            return find( val.first );
+        return _rb_tree.insert_unique( position, val );
+    };
+
+    /**
+     * @brief Inserts an element with key k unless one exists, its mapped
+     * value built in place in the new node from what make() returns
+     *
+     * @tparam Factory A function or functor returning a mapped_type, called
+     * only when k is missing
+     * @param k The key of the element
+     * @param make The factory of the mapped value
+     * @return ft::pair<iterator, bool> Returns the element with key k and
+     * whether it was inserted
+     */
+    template < typename Factory >
+    ft::pair<iterator, bool> try_insert( const key_type &k, Factory make )
+    {
+        construct_with<Factory> construct = { k, make };
+        return _rb_tree.emplace_unique( k, construct );
+    };
+
+    /**
+     * @brief Assigns obj to the mapped value of key k, or inserts an element
+     * with key k and a mapped value constructed in place from obj
+     *
+     * @param k The key of the element
+     * @param obj The value to assign or construct the mapped value from
+     * @return ft::pair<iterator, bool> Returns the element with key k and
+     * whether it was inserted
+     */
+    template < typename M >
+    ft::pair<iterator, bool> insert_or_assign( const key_type &k, const M &obj )
+    {
+        converted_from<M>        make = { obj };
+        ft::pair<iterator, bool> res  = try_insert( k, make );
+        if ( !res.second ) {
+            res.first->second = obj;
         }
+        return res;
     };
 
     /**
@@ -173,10 +233,7 @@ public:
     template <typename InputIterator>
     void insert( InputIterator first, InputIterator last )
     {
-        while ( first != last ) {
-            insert( *first );
-            ++first;
-        }
+        _rb_tree.insert_range( first, last );
     };
 
     /**
@@ -185,7 +242,7 @@ public:
      *
      * @param it The iterator to the element to erase
      */
-    void erase( iterator it ) { _rb_tree.erase( it->first ); };
+    void erase( iterator it ) { _rb_tree.erase( it ); };
 
     /**
      * @brief Eraes an element from the map container
@@ -195,27 +252,41 @@ public:
      *
      * @return size_type Returns the number of elements erased
      */
-    size_type erase( const key_type &k )
-    {
-        if ( find( k ) == end() ) {
-            return 0;
-        }
-        _rb_tree.erase( k );
-        return 1;
-    };
+    size_type erase( const key_type &k ) { return _rb_tree.erase( k ); };
 
     /**
-     * @brief Erases a range of elements from the map container
+     * @brief Erases a range of elements from the map container in
+     * O(log n) plus one deallocation per element
      *
      * @param first The iterator to the first element of the range
-     * @param last The iterator to the last element of the range
+     * @param last The iterator past the last element of the range
      */
     void erase( iterator first, iterator last )
     {
-        while ( first != last ) {
-            erase( first );
-            ++first;
-        }
+        _rb_tree.erase( first, last );
+    };
+
+    /**
+     * @brief Erases the elements with a key less than k, e.g. expired
+     * entries of a map keyed by time
+     *
+     * @param k The key of the first element to keep
+     * @return size_type Returns the number of elements erased
+     */
+    size_type erase_before( const key_type &k )
+    {
+        return _rb_tree.erase( begin(), lower_bound( k ) );
+    };
+
+    /**
+     * @brief Erases the elements with a key greater than k
+     *
+     * @param k The key of the last element to keep
+     * @return size_type Returns the number of elements erased
+     */
+    size_type erase_after( const key_type &k )
+    {
+        return _rb_tree.erase( upper_bound( k ), end() );
     };
 
     /**
@@ -231,6 +302,55 @@ public:
      */
     void clear() { _rb_tree.clear(); };
 
+    /**
+     * @brief Unlinks an element from the map without destroying it
+     *
+     * @param pos The iterator to the element
+     * @return node_type Returns a handle that owns the element, to insert it
+     * into another map, possibly under a new key, without reallocating
+     */
+    node_type extract( iterator pos )
+    {
+        return _rb_tree.template extract<node_type>( pos );
+    };
+
+    /**
+     * @brief Unlinks the element with key k, if any, from the map
+     *
+     * @param k The key of the element
+     * @return node_type Returns a handle that owns the element, or an empty
+     * handle
+     */
+    node_type extract( const key_type &k )
+    {
+        iterator it = find( k );
+        if ( it == end() )
+            return node_type();
+        return extract( it );
+    };
+
+    /**
+     * @brief Links the element of a node handle unless its key is in the map.
+     * The handle gives up the element if it was inserted, so it can be a
+     * temporary from extract
+     *
+     * @param nh The handle
+     * @return ft::pair<iterator, bool> Returns the element with the key of the
+     * handle and whether it was inserted
+     */
+    ft::pair<iterator, bool> insert( const node_type &nh )
+    {
+        return _rb_tree.insert_node( const_cast<node_type &>( nh ) );
+    };
+
+    /**
+     * @brief Moves the elements of src whose keys are not in the map,
+     * relinking their nodes when the allocators compare equal
+     *
+     * @param src The map to take the elements from
+     */
+    void merge( map &src ) { _rb_tree.merge( src._rb_tree ); };
+
     // Observers
     key_compare   key_comp() const { return _rb_tree.key_comp(); };
     value_compare value_comp() const
@@ -376,17 +496,153 @@ public:
         return _rb_tree.equal_range( k );
     };
 
+    /**
+     * @brief Finds an element with a key equivalent to k, comparing k with the
+     * keys directly instead of converting it to key_type. This and the lookups
+     * below only exist when key_compare declares is_transparent.
+     *
+     * @param k A value of any type key_compare can compare with the keys
+     */
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           iterator>::type
+    find( const K &k )
+    {
+        return iterator( _rb_tree.search( k ) );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           const_iterator>::type
+    find( const K &k ) const
+    {
+        return const_iterator( _rb_tree.search( k ) );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           size_type>::type
+    count( const K &k ) const
+    {
+        return _rb_tree.count( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           iterator>::type
+    lower_bound( const K &k )
+    {
+        return _rb_tree.lower_bound( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           const_iterator>::type
+    lower_bound( const K &k ) const
+    {
+        return _rb_tree.lower_bound( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           iterator>::type
+    upper_bound( const K &k )
+    {
+        return _rb_tree.upper_bound( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           const_iterator>::type
+    upper_bound( const K &k ) const
+    {
+        return _rb_tree.upper_bound( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           ft::pair<iterator, iterator> >::type
+    equal_range( const K &k )
+    {
+        return _rb_tree.equal_range( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           ft::pair<const_iterator, const_iterator> >::type
+    equal_range( const K &k ) const
+    {
+        return _rb_tree.equal_range( k );
+    };
+
+    // Order statistics, only with ft::rb_rank_policy
+
+    /**
+     * @brief The element at index k in key order, found in O(log n)
+     *
+     * @param k The index of the element
+     * @return iterator Returns an iterator to the element, or to map::end if k
+     * is not less than size()
+     */
+    iterator nth( size_type k ) { return iterator( _rb_tree.nth( k ) ); };
+
+    const_iterator nth( size_type k ) const
+    {
+        return const_iterator( _rb_tree.nth( k ) );
+    };
+
+    /**
+     * @brief The number of elements with a key less than k, in O(log n)
+     *
+     * @param k The key to rank
+     * @return size_type Returns the index of lower_bound( k )
+     */
+    size_type rank( const key_type &k ) const { return _rb_tree.rank( k ); };
+
+    /**
+     * @brief The index of an element in key order, in O(log n)
+     *
+     * @param it An iterator to the element, or map::end for size()
+     */
+    size_type index_of( const_iterator it ) const
+    {
+        return _rb_tree.index_of( it );
+    };
+
+    /**
+     * @brief The number of increments from first to last, in O(log n)
+     */
+    difference_type distance( const_iterator first, const_iterator last ) const
+    {
+        return difference_type( index_of( last ) )
+             - difference_type( index_of( first ) );
+    };
+
     // Allocator
     allocator_type get_allocator() const { return _rb_tree.get_allocator(); };
 
     // Non-member functions
-    template <typename K1, typename T1, typename C1, typename A1>
-    friend bool operator==( const map<K1, T1, C1, A1> &,
-                            const map<K1, T1, C1, A1> & );
-
-    template <typename K1, typename T1, typename C1, typename A1>
-    friend bool operator<( const map<K1, T1, C1, A1> &,
-                           const map<K1, T1, C1, A1> & );
+    template <typename K1, typename T1, typename C1, typename A1, typename P1>
+    friend bool operator==( const map<K1, T1, C1, A1, P1> &,
+                            const map<K1, T1, C1, A1, P1> & );
+
+    template <typename K1, typename T1, typename C1, typename A1, typename P1>
+    friend bool operator<( const map<K1, T1, C1, A1, P1> &,
+                           const map<K1, T1, C1, A1, P1> & );
+
+    template <typename K1, typename T1, typename C1, typename A1, typename P1>
+    friend map<K1, T1, C1, A1, P1> set_union( const map<K1, T1, C1, A1, P1> &,
+                                              const map<K1, T1, C1, A1, P1> & );
+
+    template <typename K1, typename T1, typename C1, typename A1, typename P1>
+    friend map<K1, T1, C1, A1, P1>
+    set_intersection( const map<K1, T1, C1, A1, P1> &,
+                      const map<K1, T1, C1, A1, P1> & );
+
+    template <typename K1, typename T1, typename C1, typename A1, typename P1>
+    friend map<K1, T1, C1, A1, P1>
+    set_difference( const map<K1, T1, C1, A1, P1> &,
+                    const map<K1, T1, C1, A1, P1> & );
 };
 
 template < MAP_TEMPLATE_ARGS >
@@ -431,6 +687,48 @@ void swap( MAP_CLASS_TYPE &x, MAP_CLASS_TYPE &y )
     x.swap( y );
 }
 
+/**
+ * @brief The elements of lhs and rhs, with the element of lhs when both have
+ * its key. Finds the keys of the smaller of the two in the other, from the
+ * root or from the previous match when they are close, in O(min(m log n,
+ * n + m)) comparisons for sizes m <= n, then builds the balanced result in
+ * linear time.
+ */
+template < MAP_TEMPLATE_ARGS >
+MAP_CLASS_TYPE set_union( const MAP_CLASS_TYPE &lhs, const MAP_CLASS_TYPE &rhs )
+{
+    MAP_CLASS_TYPE result( lhs.key_comp(), lhs.get_allocator() );
+    result._rb_tree.assign_union( lhs._rb_tree, rhs._rb_tree );
+    return result;
+}
+
+/**
+ * @brief The elements of lhs whose keys are in rhs, see set_union.
+ */
+template < MAP_TEMPLATE_ARGS >
+MAP_CLASS_TYPE
+set_intersection( const MAP_CLASS_TYPE &lhs, const MAP_CLASS_TYPE &rhs )
+{
+    MAP_CLASS_TYPE result( lhs.key_comp(), lhs.get_allocator() );
+    result._rb_tree.assign_intersection( lhs._rb_tree, rhs._rb_tree );
+    return result;
+}
+
+/**
+ * @brief The elements of lhs whose keys are not in rhs, see set_union.
+ */
+template < MAP_TEMPLATE_ARGS >
+MAP_CLASS_TYPE
+set_difference( const MAP_CLASS_TYPE &lhs, const MAP_CLASS_TYPE &rhs )
+{
+    MAP_CLASS_TYPE result( lhs.key_comp(), lhs.get_allocator() );
+    result._rb_tree.assign_difference( lhs._rb_tree, rhs._rb_tree );
+    return result;
+}
+
+template < MAP_TEMPLATE_ARGS >
+struct is_swap_relocatable< MAP_CLASS_TYPE > : bool_constant<true> {};
+
 } // namespace ft
 
 #endif // MAP_HPP
@@ -0,0 +1,400 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef MEMORY_HPP
+#define MEMORY_HPP
+
+#include "algorithm.hpp"
+#include "config.hpp"
+#include "type_traits.hpp"
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace ft {
+
+template < typename Char, typename Traits, typename Alloc >
+struct is_swap_relocatable< std::basic_string<Char, Traits, Alloc> >
+    : bool_constant<true> {};
+
+template < typename T, typename Alloc >
+struct is_swap_relocatable< std::vector<T, Alloc> > : bool_constant<true> {};
+
+/**
+ * @brief Whether Alloc provides the reallocate extension:
+ * `pointer reallocate( pointer p, size_type old_n, size_type new_n )`
+ * resizes the storage at p, in place when possible, moving its contents
+ * bytewise and throwing std::bad_alloc on failure. An allocator advertises it
+ * with `typedef ft::bool_constant<true> can_reallocate;`.
+ */
+template < typename Alloc, typename = void >
+struct allocator_can_reallocate : bool_constant<false> {};
+
+template < typename Alloc >
+struct allocator_can_reallocate<
+    Alloc,
+    typename _void_type<typename Alloc::can_reallocate>::type >
+    : bool_constant<Alloc::can_reallocate::value> {};
+
+/**
+ * @brief Whether Alloc provides the release extension: `bool release()` frees
+ * at once every block handed out by the allocator, without deallocating them
+ * one by one, and returns false, doing nothing, when other allocators still
+ * share that storage. An allocator advertises it with
+ * `typedef ft::bool_constant<true> can_release;`.
+ */
+template < typename Alloc, typename = void >
+struct allocator_can_release : bool_constant<false> {};
+
+template < typename Alloc >
+struct allocator_can_release<
+    Alloc,
+    typename _void_type<typename Alloc::can_release>::type >
+    : bool_constant<Alloc::can_release::value> {};
+
+template < typename Alloc >
+void _destroy_n( Alloc &, typename Alloc::pointer, size_t, true_type )
+{
+}
+
+template < typename Alloc >
+void _destroy_n( Alloc                  &alloc,
+                 typename Alloc::pointer first,
+                 size_t                  n,
+                 false_type )
+{
+    for ( size_t i = 0; i < n; i++ )
+        alloc.destroy( first + i );
+}
+
+/**
+ * @brief Destroys the n elements starting at first. Nothing is done for
+ * trivially destructible elements.
+ *
+ * @param alloc The allocator that constructed the elements.
+ * @param first Pointer to the first element to destroy.
+ * @param n The number of elements to destroy.
+ */
+template < typename Alloc >
+void destroy_n( Alloc &alloc, typename Alloc::pointer first, size_t n )
+{
+    typename ft::is_trivially_destructible<typename Alloc::value_type>::type
+        is_trivial;
+    _destroy_n( alloc, first, n, is_trivial );
+}
+
+template < typename Alloc >
+void _uninitialized_copy_n( Alloc                        &,
+                            typename Alloc::const_pointer src,
+                            size_t                        n,
+                            typename Alloc::pointer       dst,
+                            true_type )
+{
+    if ( n > 0 )
+        std::memcpy( dst, src, n * sizeof( typename Alloc::value_type ) );
+}
+
+template < typename Alloc >
+void _uninitialized_copy_n( Alloc                        &alloc,
+                            typename Alloc::const_pointer src,
+                            size_t                        n,
+                            typename Alloc::pointer       dst,
+                            false_type )
+{
+    size_t i = 0;
+    try {
+        for ( ; i < n; i++ )
+            alloc.construct( dst + i, src[i] );
+    } catch ( ... ) {
+        ft::destroy_n( alloc, dst, i );
+        throw;
+    }
+}
+
+/**
+ * @brief Copy-constructs the n elements starting at src into the
+ * uninitialized storage starting at dst. Trivially copyable elements are
+ * copied in bulk with memcpy. The ranges must not overlap.
+ *
+ * @param alloc The allocator used to construct the elements.
+ * @param src Pointer to the first element to copy.
+ * @param n The number of elements to copy.
+ * @param dst Pointer to the uninitialized destination storage.
+ */
+template < typename Alloc >
+void uninitialized_copy_n( Alloc                        &alloc,
+                           typename Alloc::const_pointer src,
+                           size_t                        n,
+                           typename Alloc::pointer       dst )
+{
+    typename ft::is_trivially_copyable<typename Alloc::value_type>::type
+        is_trivial;
+    _uninitialized_copy_n( alloc, src, n, dst, is_trivial );
+}
+
+template < typename Alloc, typename InputIt >
+typename Alloc::pointer _uninitialized_copy( Alloc                  &alloc,
+                                             InputIt                 first,
+                                             InputIt                 last,
+                                             typename Alloc::pointer dst,
+                                             true_type )
+{
+    size_t n = last - first;
+    ft::uninitialized_copy_n( alloc, first, n, dst );
+    return dst + n;
+}
+
+template < typename Alloc, typename InputIt >
+typename Alloc::pointer _uninitialized_copy( Alloc                  &alloc,
+                                             InputIt                 first,
+                                             InputIt                 last,
+                                             typename Alloc::pointer dst,
+                                             false_type )
+{
+    typename Alloc::pointer cur = dst;
+    try {
+        for ( ; first != last; ++first, ++cur )
+            alloc.construct( cur, *first );
+    } catch ( ... ) {
+        ft::destroy_n( alloc, dst, cur - dst );
+        throw;
+    }
+    return cur;
+}
+
+/**
+ * @brief Copy-constructs the elements of [first, last) into the uninitialized
+ * storage starting at dst. Ranges of pointers to the element type go through
+ * uninitialized_copy_n and its memcpy fast path.
+ *
+ * @param alloc The allocator used to construct the elements.
+ * @param first The iterator to the first element to copy.
+ * @param last The iterator past the last element to copy.
+ * @param dst Pointer to the uninitialized destination storage.
+ * @return pointer Pointer past the last constructed element.
+ */
+template < typename Alloc, typename InputIt >
+typename Alloc::pointer uninitialized_copy( Alloc                  &alloc,
+                                            InputIt                 first,
+                                            InputIt                 last,
+                                            typename Alloc::pointer dst )
+{
+    typedef typename Alloc::value_type value_type;
+
+    typename bool_constant<
+        ft::is_same<InputIt, const value_type *>::value
+        || ft::is_same<InputIt, value_type *>::value >::type is_pointer;
+    return _uninitialized_copy( alloc, first, last, dst, is_pointer );
+}
+
+/**
+ * @brief Copy-constructs n copies of val into the uninitialized storage
+ * starting at dst.
+ *
+ * @param alloc The allocator used to construct the elements.
+ * @param dst Pointer to the uninitialized destination storage.
+ * @param n The number of elements to construct.
+ * @param val The value to copy.
+ */
+template < typename Alloc >
+void uninitialized_fill_n( Alloc                            &alloc,
+                           typename Alloc::pointer           dst,
+                           size_t                            n,
+                           const typename Alloc::value_type &val )
+{
+    size_t i = 0;
+    try {
+        for ( ; i < n; i++ )
+            alloc.construct( dst + i, val );
+    } catch ( ... ) {
+        ft::destroy_n( alloc, dst, i );
+        throw;
+    }
+}
+
+#if FT_CXX11
+/**
+ * @brief Constructs an element in place from args through the allocator.
+ */
+template < typename Alloc, typename... Args >
+void construct( Alloc &alloc, typename Alloc::pointer p, Args &&...args )
+{
+    std::allocator_traits<Alloc>::construct(
+        alloc, p, std::forward<Args>( args )... );
+}
+#endif
+
+template < typename Alloc >
+void _uninitialized_move_n( Alloc                  &alloc,
+                            typename Alloc::pointer src,
+                            size_t                  n,
+                            typename Alloc::pointer dst,
+                            true_type )
+{
+    _uninitialized_copy_n( alloc, src, n, dst, true_type() );
+}
+
+/**
+ * @brief Default-constructs n elements at dst and swaps them with the n
+ * elements starting at src, which are left default-constructed. If a
+ * constructor throws, the swapped elements are given back to src.
+ */
+template < typename Alloc >
+void _uninitialized_swap_n( Alloc                  &alloc,
+                            typename Alloc::pointer src,
+                            size_t                  n,
+                            typename Alloc::pointer dst )
+{
+    size_t i = 0;
+    try {
+        for ( ; i < n; i++ ) {
+            alloc.construct( dst + i, typename Alloc::value_type() );
+            ft::_swap_elements( dst[i], src[i] );
+        }
+    } catch ( ... ) {
+        for ( size_t j = 0; j < i; j++ )
+            ft::_swap_elements( dst[j], src[j] );
+        ft::destroy_n( alloc, dst, i );
+        throw;
+    }
+}
+
+template < typename Alloc >
+void _uninitialized_move_elements( Alloc                  &alloc,
+                                   typename Alloc::pointer src,
+                                   size_t                  n,
+                                   typename Alloc::pointer dst,
+                                   true_type )
+{
+    _uninitialized_swap_n( alloc, src, n, dst );
+}
+
+template < typename Alloc >
+void _uninitialized_move_elements( Alloc                  &alloc,
+                                   typename Alloc::pointer src,
+                                   size_t                  n,
+                                   typename Alloc::pointer dst,
+                                   false_type )
+{
+    size_t i = 0;
+    try {
+        for ( ; i < n; i++ )
+            alloc.construct( dst + i, FT_MOVE( src[i] ) );
+    } catch ( ... ) {
+        ft::destroy_n( alloc, dst, i );
+        throw;
+    }
+}
+
+template < typename Alloc >
+void _uninitialized_move_n( Alloc                  &alloc,
+                            typename Alloc::pointer src,
+                            size_t                  n,
+                            typename Alloc::pointer dst,
+                            false_type )
+{
+    typename ft::_moves_by_swap<typename Alloc::value_type>::type by_swap;
+    _uninitialized_move_elements( alloc, src, n, dst, by_swap );
+}
+
+/**
+ * @brief Move-constructs the n elements starting at src into the
+ * uninitialized storage starting at dst. Without C++11, swap-relocatable
+ * elements are swapped out of src and the others are copied. The ranges must
+ * not overlap.
+ *
+ * @param alloc The allocator used to construct the elements.
+ * @param src Pointer to the first element to move.
+ * @param n The number of elements to move.
+ * @param dst Pointer to the uninitialized destination storage.
+ */
+template < typename Alloc >
+void uninitialized_move_n( Alloc                  &alloc,
+                           typename Alloc::pointer src,
+                           size_t                  n,
+                           typename Alloc::pointer dst )
+{
+    typename ft::is_trivially_copyable<typename Alloc::value_type>::type
+        is_trivial;
+    _uninitialized_move_n( alloc, src, n, dst, is_trivial );
+}
+
+template < typename Alloc >
+void _uninitialized_relocate_n( Alloc                  &alloc,
+                                typename Alloc::pointer src,
+                                size_t                  n,
+                                typename Alloc::pointer dst,
+                                true_type )
+{
+    _uninitialized_copy_n( alloc, src, n, dst, true_type() );
+}
+
+template < typename Alloc >
+void _relocate_elements( Alloc                  &alloc,
+                         typename Alloc::pointer src,
+                         size_t                  n,
+                         typename Alloc::pointer dst,
+                         true_type )
+{
+    _uninitialized_swap_n( alloc, src, n, dst );
+}
+
+template < typename Alloc >
+void _relocate_elements( Alloc                  &alloc,
+                         typename Alloc::pointer src,
+                         size_t                  n,
+                         typename Alloc::pointer dst,
+                         false_type )
+{
+    size_t i = 0;
+    try {
+        for ( ; i < n; i++ )
+            alloc.construct( dst + i, FT_MOVE_IF_NOEXCEPT( src[i] ) );
+    } catch ( ... ) {
+        ft::destroy_n( alloc, dst, i );
+        throw;
+    }
+}
+
+template < typename Alloc >
+void _uninitialized_relocate_n( Alloc                  &alloc,
+                                typename Alloc::pointer src,
+                                size_t                  n,
+                                typename Alloc::pointer dst,
+                                false_type )
+{
+    typename ft::_moves_by_swap<typename Alloc::value_type>::type by_swap;
+    _relocate_elements( alloc, src, n, dst, by_swap );
+    ft::destroy_n( alloc, src, n );
+}
+
+/**
+ * @brief Relocates the n elements starting at src into the uninitialized
+ * storage starting at dst: the destination elements are constructed and the
+ * source elements destroyed. Trivially relocatable elements are relocated in
+ * bulk with memcpy. With C++11 the elements are moved when their move
+ * constructor cannot throw and copied otherwise, so if a copy throws the
+ * source is left untouched. Without C++11, swap-relocatable elements are
+ * swapped with default-constructed ones instead of being copied.
+ *
+ * @param alloc The allocator owning both ranges.
+ * @param src Pointer to the first element to relocate.
+ * @param n The number of elements to relocate.
+ * @param dst Pointer to the uninitialized destination storage.
+ */
+template < typename Alloc >
+void uninitialized_relocate_n( Alloc                  &alloc,
+                               typename Alloc::pointer src,
+                               size_t                  n,
+                               typename Alloc::pointer dst )
+{
+    typename ft::is_trivially_relocatable<typename Alloc::value_type>::type
+        is_trivial;
+    _uninitialized_relocate_n( alloc, src, n, dst, is_trivial );
+}
+
+} // namespace ft
+
+#endif // MEMORY_HPP
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef MMAP_ALLOCATOR_HPP
+#define MMAP_ALLOCATOR_HPP
+
+#include "malloc_allocator.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace ft {
+
+/**
+ * @brief Allocator for large buffers: requests of at least Threshold bytes
+ * are mapped straight from the kernel with anonymous mmap, aligned on and
+ * advised for transparent huge pages (MADV_HUGEPAGE), which cuts TLB misses
+ * on large random-access working sets. Smaller requests, like the nodes of a
+ * map, fall back to malloc. Mapped buffers grow with mremap where available.
+ *
+ * @tparam T The type of the elements to allocate.
+ * @tparam Threshold The size in bytes from which requests are mapped.
+ * @tparam Populate Whether to pre-fault the mapped pages once they are advised,
+ * which moves the cost of the first touch of every page to the allocation.
+ */
+template < typename T,
+           size_t Threshold = 2 * 1024 * 1024,
+           bool   Populate  = false >
+class mmap_allocator : public malloc_allocator<T> {
+public:
+    typedef typename malloc_allocator<T>::pointer   pointer;
+    typedef typename malloc_allocator<T>::size_type size_type;
+
+    template < typename U >
+    struct rebind
+    {
+        typedef mmap_allocator<U, Threshold, Populate> other;
+    };
+
+    /**
+     * @brief The alignment of mapped buffers, the usual size of a huge page.
+     */
+    static const size_t huge_page_size = 2 * 1024 * 1024;
+
+    mmap_allocator() {};
+    mmap_allocator( const mmap_allocator &x ) : malloc_allocator<T>( x ) {};
+    template < typename U >
+    mmap_allocator( const mmap_allocator<U, Threshold, Populate> & ) {};
+    ~mmap_allocator() {};
+
+    pointer allocate( size_type n, const void * = 0 )
+    {
+        if ( n > this->max_size() )
+            throw std::bad_alloc();
+        if ( !_is_mapped( n ) )
+            return malloc_allocator<T>::allocate( n );
+        return static_cast<pointer>( _map( n * sizeof( T ) ) );
+    };
+
+    void deallocate( pointer p, size_type n )
+    {
+        if ( _is_mapped( n ) )
+            ::munmap( p, _map_length( n * sizeof( T ) ) );
+        else
+            malloc_allocator<T>::deallocate( p, n );
+    };
+
+    /**
+     * @brief Resizes the storage at p from old_n to new_n elements, see
+     * allocator_can_reallocate. Mapped buffers are remapped by the kernel
+     * without copying their pages: in place when the pages after them are
+     * free, otherwise into a new mapping aligned on a huge page.
+     */
+    pointer reallocate( pointer p, size_type old_n, size_type new_n )
+    {
+        if ( new_n > this->max_size() )
+            throw std::bad_alloc();
+        if ( !_is_mapped( old_n ) && !_is_mapped( new_n ) )
+            return malloc_allocator<T>::reallocate( p, old_n, new_n );
+#if defined( __linux__ ) && defined( MREMAP_FIXED )
+        if ( _is_mapped( old_n ) && _is_mapped( new_n ) ) {
+            size_t old_len = _map_length( old_n * sizeof( T ) );
+            size_t new_len = _map_length( new_n * sizeof( T ) );
+            void  *tmp     = ::mremap( p, old_len, new_len, 0 );
+            if ( tmp == MAP_FAILED ) {
+                // MREMAP_MAYMOVE alone only keeps page alignment
+                void *target = _map( new_n * sizeof( T ), false );
+                int   flags  = MREMAP_MAYMOVE | MREMAP_FIXED;
+                tmp          = ::mremap( p, old_len, new_len, flags, target );
+                if ( tmp == MAP_FAILED ) {
+                    ::munmap( target, new_len );
+                    throw std::bad_alloc();
+                }
+            }
+            if ( Populate && new_len > old_len )
+                _populate( static_cast<char *>( tmp ) + old_len,
+                           new_len - old_len );
+            return static_cast<pointer>( tmp );
+        }
+#endif
+        pointer tmp = allocate( new_n );
+        std::memcpy(
+            tmp, p, ( old_n < new_n ? old_n : new_n ) * sizeof( T ) );
+        deallocate( p, old_n );
+        return tmp;
+    };
+
+private:
+    static bool _is_mapped( size_type n )
+    {
+        return n * sizeof( T ) >= Threshold;
+    };
+
+    static size_t _map_length( size_t bytes )
+    {
+        size_t page = ::sysconf( _SC_PAGESIZE );
+        return ( bytes + page - 1 ) / page * page;
+    };
+
+    /**
+     * @brief Maps at least bytes bytes aligned on a huge page: the mapping is
+     * oversized by a huge page and the unaligned head and tail are unmapped.
+     * The pages are only pre-faulted once advised, so that they can be huge
+     * pages, and the slack is never faulted.
+     */
+    static void *_map( size_t bytes, bool populate = Populate )
+    {
+        size_t len = _map_length( bytes );
+        void  *raw = ::mmap( NULL,
+                             len + huge_page_size,
+                             PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS,
+                             -1,
+                             0 );
+        if ( raw == MAP_FAILED )
+            throw std::bad_alloc();
+        char  *base  = static_cast<char *>( raw );
+        size_t head  = ( huge_page_size
+                        - reinterpret_cast<size_t>( base ) % huge_page_size )
+                     % huge_page_size;
+        char  *start = base + head;
+        if ( head > 0 )
+            ::munmap( base, head );
+        if ( huge_page_size - head > 0 )
+            ::munmap( start + len, huge_page_size - head );
+#ifdef MADV_HUGEPAGE
+        ::madvise( start, len, MADV_HUGEPAGE );
+#endif
+        if ( populate )
+            _populate( start, len );
+        return start;
+    };
+
+    /**
+     * @brief Faults in the len bytes of pages at start, with
+     * MADV_POPULATE_WRITE where the kernel has it, otherwise by writing one
+     * byte of every page.
+     */
+    static void _populate( char *start, size_t len )
+    {
+#ifdef MADV_POPULATE_WRITE
+        if ( ::madvise( start, len, MADV_POPULATE_WRITE ) == 0 )
+            return;
+#endif
+        size_t page = ::sysconf( _SC_PAGESIZE );
+        for ( size_t off = 0; off < len; off += page )
+            static_cast<volatile char *>( start )[off] = 0;
+    };
+};
+
+template < typename T, size_t Threshold, bool Populate >
+const size_t mmap_allocator<T, Threshold, Populate>::huge_page_size;
+
+template < typename T, typename U, size_t Threshold, bool Populate >
+inline bool operator==( const mmap_allocator<T, Threshold, Populate> &,
+                        const mmap_allocator<U, Threshold, Populate> & )
+{
+    return true;
+}
+
+template < typename T, typename U, size_t Threshold, bool Populate >
+inline bool operator!=( const mmap_allocator<T, Threshold, Populate> &,
+                        const mmap_allocator<U, Threshold, Populate> & )
+{
+    return false;
+}
+
+} // namespace ft
+
+#endif // MMAP_ALLOCATOR_HPP
@@ -0,0 +1,352 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef MULTIMAP_HPP
+#define MULTIMAP_HPP
+
+#include "functional.hpp"
+#include "rb_tree.hpp"
+#include "utility.hpp"
+
+#define MULTIMAP_TEMPLATE_ARGS                                                 \
+    typename Key, typename T, typename Compare, typename Alloc, typename Policy
+
+#define MULTIMAP_CLASS_TYPE multimap< Key, T, Compare, Alloc, Policy >
+
+namespace ft {
+
+template < typename Key,
+           typename T,
+           typename Compare = ft::less<Key>,
+           typename Alloc   = std::allocator<ft::pair<const Key, T> >,
+           typename Policy  = ft::rb_plain_policy >
+class multimap {
+    template < typename P >
+    struct select1st
+    {
+        const Key &operator()( const P &p ) const { return p.first; }
+    };
+
+public:
+    typedef Key                             key_type;
+    typedef T                               mapped_type;
+    typedef ft::pair<const Key, T>          value_type;
+    typedef Compare                         key_compare;
+    typedef typename Alloc::reference       reference;
+    typedef typename Alloc::const_reference const_reference;
+    typedef typename Alloc::pointer         pointer;
+    typedef typename Alloc::const_pointer   const_pointer;
+
+    class value_compare
+        : public std::binary_function<value_type, value_type, bool> {
+        friend class multimap<Key, T, Compare, Alloc, Policy>;
+
+    protected:
+        Compare comp;
+
+        explicit value_compare( Compare c ) : comp( c ) {}
+
+    public:
+        bool operator()( const value_type &x, const value_type &y ) const
+        {
+            return comp( x.first, y.first );
+        }
+    };
+
+private:
+    typedef rb_tree< key_type,
+                     value_type,
+                     select1st<value_type>,
+                     key_compare,
+                     Alloc,
+                     Policy >
+                 rb_tree_type;
+    rb_tree_type _rb_tree;
+
+public:
+    typedef typename rb_tree_type::allocator_type  allocator_type;
+    typedef typename rb_tree_type::size_type       size_type;
+    typedef typename rb_tree_type::difference_type difference_type;
+
+    typedef typename rb_tree_type::iterator         iterator;
+    typedef typename rb_tree_type::const_iterator   const_iterator;
+    typedef typename rb_tree_type::reverse_iterator reverse_iterator;
+    typedef
+        typename rb_tree_type::const_reverse_iterator const_reverse_iterator;
+
+    // Constructors
+    explicit multimap( const key_compare    &comp  = key_compare(),
+                       const allocator_type &alloc = allocator_type() ) :
+        _rb_tree( comp, alloc ) {};
+
+    template <typename InputIterator>
+    multimap( InputIterator         first,
+              InputIterator         last,
+              const key_compare    &comp  = key_compare(),
+              const allocator_type &alloc = allocator_type() ) :
+        _rb_tree( comp, alloc )
+    {
+        _rb_tree.insert_range_equal( first, last );
+    };
+
+    multimap( const multimap &x ) : _rb_tree( x._rb_tree ) {};
+
+    // Destructor
+    ~multimap() { clear(); };
+
+    // Operators
+    multimap &operator=( const multimap &x )
+    {
+        _rb_tree = x._rb_tree;
+        return *this;
+    };
+
+    // Iterators
+    iterator               begin() { return _rb_tree.begin(); };
+    const_iterator         begin() const { return _rb_tree.begin(); };
+    iterator               end() { return _rb_tree.end(); };
+    const_iterator         end() const { return _rb_tree.end(); };
+    reverse_iterator       rbegin() { return _rb_tree.rbegin(); };
+    const_reverse_iterator rbegin() const { return _rb_tree.rbegin(); };
+    reverse_iterator       rend() { return _rb_tree.rend(); };
+    const_reverse_iterator rend() const { return _rb_tree.rend(); };
+
+    // Capacity
+    bool      empty() const { return _rb_tree.empty(); };
+    size_type size() const { return _rb_tree.size(); };
+    size_type max_size() const { return _rb_tree.max_size(); };
+
+    // Modifiers
+    /**
+     * @brief Inserts an element after the elements with an equivalent key
+     *
+     * @param val The value to insert
+     * @return iterator Returns an iterator to the inserted element
+     */
+    iterator insert( const value_type &val )
+    {
+        return _rb_tree.insert_equal( val );
+    };
+
+    /**
+     * @brief Inserts an element right before position when its key belongs
+     * there, in amortized constant time, and after the elements with an
+     * equivalent key otherwise
+     *
+     * @param position The position to insert before, end() or upper_bound of
+     * the key to append to the elements with that key
+     * @param val The value to insert
+     * @return iterator Returns an iterator to the inserted element
+     */
+    iterator insert( iterator position, const value_type &val )
+    {
+        return _rb_tree.insert_equal( position, val );
+    };
+
+    /**
+     * @brief Inserts a range of elements, building an empty multimap from a
+     * sorted range in linear time
+     *
+     * @tparam InputIterator The iterator type
+     * @param first The iterator to the first element of the range
+     * @param last The iterator past the last element of the range
+     */
+    template <typename InputIterator>
+    void insert( InputIterator first, InputIterator last )
+    {
+        _rb_tree.insert_range_equal( first, last );
+    };
+
+    /**
+     * @brief Erases an element from the multimap
+     *
+     * @param it The iterator to the element to erase
+     */
+    void erase( iterator it ) { _rb_tree.erase( it ); };
+
+    /**
+     * @brief Erases the elements with key k in O(log n) plus one
+     * deallocation per element
+     *
+     * @param k The key of the elements to erase
+     * @return size_type Returns the number of elements erased
+     */
+    size_type erase( const key_type &k ) { return _rb_tree.erase_equal( k ); };
+
+    /**
+     * @brief Erases a range of elements from the multimap in O(log n) plus
+     * one deallocation per element
+     *
+     * @param first The iterator to the first element of the range
+     * @param last The iterator past the last element of the range
+     */
+    void erase( iterator first, iterator last )
+    {
+        _rb_tree.erase( first, last );
+    };
+
+    /**
+     * @brief Swaps the contents of two multimap containers
+     *
+     * @param x The multimap container to swap with
+     */
+    void swap( multimap &x ) { _rb_tree.swap( x._rb_tree ); };
+
+    /**
+     * @brief Clears the contents of the multimap container
+     *
+     */
+    void clear() { _rb_tree.clear(); };
+
+    // Observers
+    key_compare   key_comp() const { return _rb_tree.key_comp(); };
+    value_compare value_comp() const
+    {
+        return value_compare( _rb_tree.key_comp() );
+    };
+
+    // Operations
+    /**
+     * @brief Finds the first element with a specific key
+     *
+     * @param k The key to search for
+     * @return iterator Returns an iterator to the element, if the element is
+     * not found, the function returns an iterator to multimap::end
+     */
+    iterator find( const key_type &k )
+    {
+        return iterator( _rb_tree.search( k ) );
+    };
+
+    const_iterator find( const key_type &k ) const
+    {
+        return const_iterator( _rb_tree.search( k ) );
+    };
+
+    /**
+     * @brief Counts the elements with a specific key, in O(log n + count)
+     *
+     * @param k The key to count elements with
+     * @return size_type Returns the number of elements with the specified key
+     */
+    size_type count( const key_type &k ) const
+    {
+        return _rb_tree.count_equal( k );
+    };
+
+    /**
+     * @brief The lower bound of a key
+     *
+     * @param k The key to search for
+     * @return iterator Returns an iterator to the first element not less than k
+     */
+    iterator lower_bound( const key_type &k )
+    {
+        return _rb_tree.lower_bound( k );
+    };
+
+    const_iterator lower_bound( const key_type &k ) const
+    {
+        return _rb_tree.lower_bound( k );
+    };
+
+    /**
+     * @brief The upper bound of a key
+     *
+     * @param k The key to search for
+     * @return iterator Returns an iterator to the first element greater than k
+     */
+    iterator upper_bound( const key_type &k )
+    {
+        return _rb_tree.upper_bound( k );
+    };
+
+    const_iterator upper_bound( const key_type &k ) const
+    {
+        return _rb_tree.upper_bound( k );
+    };
+
+    /**
+     * @brief Gets the range of elements with a specific key, in a single
+     * descent from the root down to the first of them
+     *
+     * @param k The key to search for
+     * @return ft::pair<iterator, iterator> Returns a pair of iterators, the
+     * first is the lower bound, the second is the upper bound
+     */
+    ft::pair<iterator, iterator> equal_range( const key_type &k )
+    {
+        return _rb_tree.equal_range( k );
+    };
+
+    ft::pair<const_iterator, const_iterator>
+    equal_range( const key_type &k ) const
+    {
+        return _rb_tree.equal_range( k );
+    };
+
+    // Allocator
+    allocator_type get_allocator() const { return _rb_tree.get_allocator(); };
+
+    // Non-member functions
+    template <typename K1, typename T1, typename C1, typename A1, typename P1>
+    friend bool operator==( const multimap<K1, T1, C1, A1, P1> &,
+                            const multimap<K1, T1, C1, A1, P1> & );
+
+    template <typename K1, typename T1, typename C1, typename A1, typename P1>
+    friend bool operator<( const multimap<K1, T1, C1, A1, P1> &,
+                           const multimap<K1, T1, C1, A1, P1> & );
+};
+
+template < MULTIMAP_TEMPLATE_ARGS >
+bool operator==( const MULTIMAP_CLASS_TYPE &lhs,
+                 const MULTIMAP_CLASS_TYPE &rhs )
+{
+    return lhs._rb_tree == rhs._rb_tree;
+}
+
+template < MULTIMAP_TEMPLATE_ARGS >
+bool operator!=( const MULTIMAP_CLASS_TYPE &lhs,
+                 const MULTIMAP_CLASS_TYPE &rhs )
+{
+    return !( lhs == rhs );
+}
+
+template < MULTIMAP_TEMPLATE_ARGS >
+bool operator<( const MULTIMAP_CLASS_TYPE &lhs, const MULTIMAP_CLASS_TYPE &rhs )
+{
+    return lhs._rb_tree < rhs._rb_tree;
+}
+
+template < MULTIMAP_TEMPLATE_ARGS >
+bool operator<=( const MULTIMAP_CLASS_TYPE &lhs,
+                 const MULTIMAP_CLASS_TYPE &rhs )
+{
+    return !( rhs < lhs );
+}
+
+template < MULTIMAP_TEMPLATE_ARGS >
+bool operator>( const MULTIMAP_CLASS_TYPE &lhs, const MULTIMAP_CLASS_TYPE &rhs )
+{
+    return rhs < lhs;
+}
+
+template < MULTIMAP_TEMPLATE_ARGS >
+bool operator>=( const MULTIMAP_CLASS_TYPE &lhs,
+                 const MULTIMAP_CLASS_TYPE &rhs )
+{
+    return !( lhs < rhs );
+}
+
+template < MULTIMAP_TEMPLATE_ARGS >
+void swap( MULTIMAP_CLASS_TYPE &x, MULTIMAP_CLASS_TYPE &y )
+{
+    x.swap( y );
+}
+
+template < MULTIMAP_TEMPLATE_ARGS >
+struct is_swap_relocatable< MULTIMAP_CLASS_TYPE > : bool_constant<true> {};
+
+} // namespace ft
+
+#endif // MULTIMAP_HPP
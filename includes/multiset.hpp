@@ -0,0 +1,317 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef MULTISET_HPP
+#define MULTISET_HPP
+
+#define MULTISET_TEMPLATE_ARGS                                                 \
+    typename T, typename Compare, typename Alloc, typename Policy
+#define MULTISET_CLASS_TYPE multiset<T, Compare, Alloc, Policy>
+
+#include "functional.hpp"
+#include "rb_tree.hpp"
+#include "utility.hpp"
+
+namespace ft {
+
+template < class T,
+           class Compare = ft::less<T>,
+           class Alloc   = std::allocator<T>,
+           class Policy  = ft::rb_plain_policy >
+class multiset {
+    template <typename P>
+    struct set_key_compare
+    {
+        const T &operator()( const P &x ) const { return x; }
+    };
+
+public:
+    typedef T                               key_type;
+    typedef T                               value_type;
+    typedef Compare                         key_compare;
+    typedef Compare                         value_compare;
+    typedef typename Alloc::reference       reference;
+    typedef typename Alloc::const_reference const_reference;
+    typedef typename Alloc::pointer         pointer;
+    typedef typename Alloc::const_pointer   const_pointer;
+
+private:
+    typedef rb_tree<key_type,
+                    value_type,
+                    set_key_compare<value_type>,
+                    key_compare,
+                    Alloc,
+                    Policy>
+                 rb_tree_type;
+    rb_tree_type _rb_tree;
+
+public:
+    typedef typename rb_tree_type::allocator_type  allocator_type;
+    typedef typename rb_tree_type::size_type       size_type;
+    typedef typename rb_tree_type::difference_type difference_type;
+
+    typedef typename rb_tree_type::iterator         iterator;
+    typedef typename rb_tree_type::const_iterator   const_iterator;
+    typedef typename rb_tree_type::reverse_iterator reverse_iterator;
+    typedef
+        typename rb_tree_type::const_reverse_iterator const_reverse_iterator;
+
+    // Constructors
+    explicit multiset( const key_compare    &comp  = key_compare(),
+                       const allocator_type &alloc = allocator_type() ) :
+        _rb_tree( comp, alloc ) {};
+
+    template <class InputIterator>
+    multiset( InputIterator         first,
+              InputIterator         last,
+              const key_compare    &comp  = key_compare(),
+              const allocator_type &alloc = allocator_type() ) :
+        _rb_tree( comp, alloc )
+    {
+        _rb_tree.insert_range_equal( first, last );
+    };
+
+    multiset( const multiset &s ) : _rb_tree( s._rb_tree ) {};
+
+    // Destructor
+    ~multiset() { clear(); };
+
+    // Assignment operator
+    multiset &operator=( const multiset &s )
+    {
+        if ( this != &s )
+            _rb_tree = s._rb_tree;
+        return *this;
+    };
+
+    // Iterators
+    iterator       begin() { return _rb_tree.begin(); };
+    const_iterator begin() const { return _rb_tree.begin(); };
+
+    iterator       end() { return _rb_tree.end(); };
+    const_iterator end() const { return _rb_tree.end(); };
+
+    reverse_iterator       rbegin() { return _rb_tree.rbegin(); };
+    const_reverse_iterator rbegin() const { return _rb_tree.rbegin(); };
+
+    reverse_iterator       rend() { return _rb_tree.rend(); };
+    const_reverse_iterator rend() const { return _rb_tree.rend(); };
+
+    // Capacity
+    bool      empty() const { return _rb_tree.empty(); };
+    size_type size() const { return _rb_tree.size(); };
+    size_type max_size() const { return _rb_tree.max_size(); };
+
+    // Modifiers
+    /**
+     * @brief Inserts an element after the equivalent ones.
+     *
+     * @param val The value to insert.
+     * @return iterator The iterator to the inserted element.
+     */
+    iterator insert( const value_type &val )
+    {
+        return _rb_tree.insert_equal( val );
+    };
+
+    /**
+     * @brief Inserts an element right before position when it belongs there,
+     * in amortized constant time, and after the equivalent ones otherwise.
+     *
+     * @param position The position to insert before.
+     * @param val The value to insert.
+     * @return iterator The iterator to the inserted element.
+     */
+    iterator insert( iterator position, const value_type &val )
+    {
+        return _rb_tree.insert_equal( position, val );
+    };
+
+    /**
+     * @brief Inserts a range of elements into the multiset. An empty multiset
+     * is built from a sorted range in linear time.
+     *
+     * @tparam InputIterator The type of the iterator.
+     * @param first The first element of the range.
+     * @param last The last element of the range.
+     */
+    template <class InputIterator>
+    void insert( InputIterator first, InputIterator last )
+    {
+        _rb_tree.insert_range_equal( first, last );
+    };
+
+    /**
+     * @brief Erases an element from the multiset.
+     *
+     * @param position The position of the element to erase.
+     */
+    void erase( iterator position ) { _rb_tree.erase( position ); };
+
+    /**
+     * @brief Erases the elements equivalent to val, in O(log n) plus one
+     * deallocation per element.
+     *
+     * @param val The value to erase.
+     * @return size_type The number of elements erased.
+     */
+    size_type erase( const value_type &val )
+    {
+        return _rb_tree.erase_equal( val );
+    };
+
+    /**
+     * @brief Erases a range of elements from the multiset, in O(log n) plus
+     * one deallocation per element.
+     *
+     * @param first The first element of the range.
+     * @param last The element past the range.
+     */
+    void erase( iterator first, iterator last )
+    {
+        _rb_tree.erase( first, last );
+    };
+
+    /**
+     * @brief Swaps the contents of two multisets.
+     *
+     * @param x The multiset to swap with.
+     */
+    void swap( multiset &s ) { _rb_tree.swap( s._rb_tree ); };
+
+    /**
+     * @brief Clears the multiset.
+     */
+    void clear() { _rb_tree.clear(); };
+
+    // Observers
+    key_compare key_comp() const { return _rb_tree.key_comp(); };
+
+    value_compare value_comp() const { return _rb_tree.key_comp(); };
+
+    // Operations
+    /**
+     * @brief Finds the first element equivalent to a given value.
+     *
+     * @param val The value to find.
+     * @return iterator The iterator to the element, or end() if not found.
+     */
+    iterator find( const value_type &val ) const
+    {
+        return iterator( _rb_tree.search( val ) );
+    };
+
+    /**
+     * @brief Counts the elements equivalent to a given value, in
+     * O(log n + count).
+     *
+     * @param val The value to count.
+     * @return size_type The number of equivalent elements.
+     */
+    size_type count( const value_type &val ) const
+    {
+        return _rb_tree.count_equal( val );
+    };
+
+    /**
+     * @brief Finds the first element not less than a given value.
+     *
+     * @param val The value to search for.
+     * @return iterator The iterator to the element, or end() if not found.
+     */
+    iterator lower_bound( const value_type &val ) const
+    {
+        return _rb_tree.lower_bound( val );
+    };
+
+    /**
+     * @brief Finds the first element greater than a given value.
+     *
+     * @param val The value to search for.
+     * @return iterator The iterator to the element, or end() if not found.
+     */
+    iterator upper_bound( const value_type &val ) const
+    {
+        return _rb_tree.upper_bound( val );
+    };
+
+    /**
+     * @brief Finds the range of elements equivalent to a given value, in a
+     * single descent from the root down to the first of them.
+     *
+     * @param val The value to search for.
+     * @return ft::pair<iterator, iterator> A pair containing the lower and
+     * upper bounds of the range.
+     */
+    ft::pair<iterator, iterator> equal_range( const value_type &val ) const
+    {
+        return _rb_tree.equal_range( val );
+    };
+
+    // Allocator
+    allocator_type get_allocator() const { return _rb_tree.get_allocator(); };
+
+    // Non-member functions
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator==( const multiset<T1, C1, A1, P1> &lhs,
+                            const multiset<T1, C1, A1, P1> &rhs );
+
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator<( const multiset<T1, C1, A1, P1> &lhs,
+                           const multiset<T1, C1, A1, P1> &rhs );
+};
+
+template < MULTISET_TEMPLATE_ARGS >
+inline bool operator==( const MULTISET_CLASS_TYPE &lhs,
+                        const MULTISET_CLASS_TYPE &rhs )
+{
+    return lhs._rb_tree == rhs._rb_tree;
+}
+
+template < MULTISET_TEMPLATE_ARGS >
+inline bool operator!=( const MULTISET_CLASS_TYPE &lhs,
+                        const MULTISET_CLASS_TYPE &rhs )
+{
+    return !( lhs == rhs );
+}
+
+template < MULTISET_TEMPLATE_ARGS >
+inline bool operator<( const MULTISET_CLASS_TYPE &lhs,
+                       const MULTISET_CLASS_TYPE &rhs )
+{
+    return lhs._rb_tree < rhs._rb_tree;
+}
+
+template < MULTISET_TEMPLATE_ARGS >
+inline bool operator<=( const MULTISET_CLASS_TYPE &lhs,
+                        const MULTISET_CLASS_TYPE &rhs )
+{
+    return !( rhs < lhs );
+}
+
+template < MULTISET_TEMPLATE_ARGS >
+inline bool operator>( const MULTISET_CLASS_TYPE &lhs,
+                       const MULTISET_CLASS_TYPE &rhs )
+{
+    return rhs < lhs;
+}
+
+template < MULTISET_TEMPLATE_ARGS >
+inline bool operator>=( const MULTISET_CLASS_TYPE &lhs,
+                        const MULTISET_CLASS_TYPE &rhs )
+{
+    return !( lhs < rhs );
+}
+
+template < MULTISET_TEMPLATE_ARGS >
+inline void swap( MULTISET_CLASS_TYPE &lhs, MULTISET_CLASS_TYPE &rhs )
+{
+    lhs.swap( rhs );
+}
+
+template < MULTISET_TEMPLATE_ARGS >
+struct is_swap_relocatable< MULTISET_CLASS_TYPE > : bool_constant<true> {};
+
+} // namespace ft
+
+#endif // MULTISET_HPP
@@ -0,0 +1,131 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef NODE_HANDLE_HPP
+#define NODE_HANDLE_HPP
+
+#include "utility.hpp"
+#include <algorithm>
+#include <cstddef>
+
+namespace ft {
+
+/**
+ * @brief Owns a node extracted from an ft::set or an ft::map, see
+ * set::extract. The node keeps its value and is relinked, without allocating,
+ * when the handle is inserted into a container with an equal allocator. A
+ * handle that still holds its node destroys it.
+ *
+ * C++98 has no move semantics, so copying or assigning a handle transfers the
+ * node, as std::auto_ptr does, and leaves the source empty.
+ *
+ * @tparam T The value type of the container.
+ * @tparam Node The node type of its tree.
+ * @tparam Alloc The allocator type of the container, for nodes.
+ */
+template < typename T, typename Node, typename Alloc >
+class node_handle {
+public:
+    typedef T     value_type;
+    typedef Alloc allocator_type;
+
+    node_handle() : _node( NULL ), _alloc() {};
+
+    /**
+     * @brief Takes ownership of an unlinked node allocated with alloc.
+     */
+    explicit node_handle( Node                 *node,
+                          const allocator_type &alloc = allocator_type() ) :
+        _node( node ),
+        _alloc( alloc ) {};
+
+    node_handle( const node_handle &x ) :
+        _node( const_cast<node_handle &>( x ).release() ), _alloc( x._alloc )
+    {};
+
+    ~node_handle() { _destroy(); };
+
+    node_handle &operator=( const node_handle &rhs )
+    {
+        if ( this != &rhs ) {
+            _destroy();
+            _alloc = rhs._alloc;
+            _node  = const_cast<node_handle &>( rhs ).release();
+        }
+        return *this;
+    };
+
+    bool empty() const { return _node == NULL; };
+
+    value_type &value() const { return _node->data; };
+
+    allocator_type get_allocator() const { return _alloc; };
+
+    // Accessors
+    Node *base() const { return _node; };
+
+    /**
+     * @brief Gives up the node without destroying it.
+     */
+    Node *release()
+    {
+        Node *node = _node;
+        _node      = NULL;
+        return node;
+    };
+
+    void swap( node_handle &x )
+    {
+        std::swap( _node, x._node );
+        std::swap( _alloc, x._alloc );
+    };
+
+private:
+    typedef typename Alloc::template rebind<T>::other value_allocator_type;
+
+    void _destroy()
+    {
+        if ( _node == NULL ) {
+            return;
+        }
+        value_allocator_type value_alloc( _alloc );
+        value_alloc.destroy( &_node->data );
+        _alloc.deallocate( _node, 1 );
+        _node = NULL;
+    };
+
+    Node          *_node;
+    allocator_type _alloc;
+};
+
+/**
+ * @brief The node handle of ft::map, which also gives access to the key, so
+ * an entry can be given a new key and inserted back without reallocating.
+ */
+template < typename Key, typename T, typename Node, typename Alloc >
+class map_node_handle
+    : public node_handle<ft::pair<const Key, T>, Node, Alloc> {
+    typedef node_handle<ft::pair<const Key, T>, Node, Alloc> handle_type;
+
+public:
+    typedef Key   key_type;
+    typedef T     mapped_type;
+    typedef Alloc allocator_type;
+
+    map_node_handle() : handle_type() {};
+
+    explicit map_node_handle( Node                 *node,
+                              const allocator_type &alloc = allocator_type() ) :
+        handle_type( node, alloc ) {};
+
+    key_type &key() const
+    {
+        return const_cast<key_type &>( this->value().first );
+    };
+
+    mapped_type &mapped() const { return this->value().second; };
+};
+
+} // namespace ft
+
+#endif // NODE_HANDLE_HPP
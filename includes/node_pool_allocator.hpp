@@ -0,0 +1,229 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef NODE_POOL_ALLOCATOR_HPP
+#define NODE_POOL_ALLOCATOR_HPP
+
+#include "malloc_allocator.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace ft {
+
+template < typename T >
+struct _alignment_probe
+{
+    char _c;
+    T    _t;
+};
+
+/**
+ * @brief Allocator for node based containers such as ft::map and ft::set.
+ * Single objects are carved from slabs of SlabBytes bytes and recycled
+ * through a free list, so inserting and erasing elements rarely calls malloc.
+ * Requests for more than one object go to malloc.
+ *
+ * Copies of an allocator share its pool, which is freed with the last copy.
+ * An allocator rebound to another type starts a pool of its own. A tree whose
+ * allocator is the only owner of its pool releases every slab at once when it
+ * is cleared or destroyed, see allocator_can_release. The pool is not
+ * thread-safe.
+ *
+ * @tparam T The type of the elements to allocate.
+ * @tparam SlabBytes The size of the slabs the objects are carved from.
+ */
+template < typename T, size_t SlabBytes = 64 * 1024 >
+class node_pool_allocator : public malloc_allocator<T> {
+public:
+    typedef typename malloc_allocator<T>::pointer   pointer;
+    typedef typename malloc_allocator<T>::size_type size_type;
+    typedef ft::bool_constant<false>                can_reallocate;
+    typedef ft::bool_constant<true>                 can_release;
+
+    template < typename U >
+    struct rebind
+    {
+        typedef node_pool_allocator<U, SlabBytes> other;
+    };
+
+    node_pool_allocator() : _pool( NULL ) {};
+    node_pool_allocator( const node_pool_allocator &x )
+        : malloc_allocator<T>( x ), _pool( x._share() ) {};
+    template < typename U >
+    node_pool_allocator( const node_pool_allocator<U, SlabBytes> & )
+        : _pool( NULL ) {};
+    ~node_pool_allocator() { _drop(); };
+
+    node_pool_allocator &operator=( const node_pool_allocator &rhs )
+    {
+        _pool_type *pool = rhs._share();
+        _drop();
+        _pool = pool;
+        return *this;
+    };
+
+    /**
+     * @brief Allocates uninitialized storage for n elements. A single element
+     * comes from the free list or the current slab.
+     */
+    pointer allocate( size_type n, const void * = 0 )
+    {
+        if ( n != 1 )
+            return malloc_allocator<T>::allocate( n );
+        _pool_type *pool = _get();
+        void       *p    = pool->free_list;
+        if ( p != NULL ) {
+            pool->free_list = *static_cast<void **>( p );
+        } else {
+            if ( pool->cursor == pool->end )
+                _grow( pool );
+            p = pool->cursor;
+            pool->cursor += _chunk_size;
+        }
+        return static_cast<pointer>( p );
+    };
+
+    void deallocate( pointer p, size_type n )
+    {
+        if ( n != 1 ) {
+            malloc_allocator<T>::deallocate( p, n );
+            return;
+        }
+        *reinterpret_cast<void **>( p ) = _pool->free_list;
+        _pool->free_list                = p;
+    };
+
+    /**
+     * @brief Frees every slab of the pool, invalidating all the single
+     * elements allocated from it, see allocator_can_release.
+     *
+     * @return false, leaving the pool untouched, when other copies share it.
+     */
+    bool release()
+    {
+        if ( _pool == NULL )
+            return true;
+        if ( _pool->refs != 1 )
+            return false;
+        _free_slabs( _pool );
+        return true;
+    };
+
+    /**
+     * @brief Whether two allocators share a pool, so each one can deallocate
+     * what the other allocated.
+     */
+    bool shares_pool( const node_pool_allocator &x ) const
+    {
+        return _get() == x._get();
+    };
+
+private:
+    // Hides malloc_allocator::reallocate, pooled elements cannot be resized
+    pointer reallocate( pointer p, size_type old_n, size_type new_n );
+
+    struct _pool_type
+    {
+        size_t refs;
+        void  *slabs;
+        char  *cursor;
+        char  *end;
+        void  *free_list;
+    };
+
+    enum {
+        _align = sizeof( _alignment_probe<T> ) - sizeof( T ) > sizeof( void * )
+                   ? sizeof( _alignment_probe<T> ) - sizeof( T )
+                   : sizeof( void * ),
+        _chunk_size = ( sizeof( T ) + _align - 1 ) / _align * _align,
+        // Each slab starts with the link to the previous one
+        _slab_header = ( sizeof( void * ) + _align - 1 ) / _align * _align,
+        _slab_size   = SlabBytes > _slab_header + _chunk_size
+                         ? SlabBytes
+                         : _slab_header + _chunk_size
+    };
+
+    // Creates the pool on first use, so that copies made before allocating
+    // still share it
+    _pool_type *_get() const
+    {
+        if ( _pool == NULL ) {
+            _pool = static_cast<_pool_type *>(
+                std::malloc( sizeof( _pool_type ) ) );
+            if ( _pool == NULL )
+                throw std::bad_alloc();
+            _pool->refs  = 1;
+            _pool->slabs = NULL;
+            _free_slabs( _pool );
+        }
+        return _pool;
+    };
+
+    _pool_type *_share() const
+    {
+        _pool_type *pool = _get();
+        pool->refs++;
+        return pool;
+    };
+
+    void _drop()
+    {
+        if ( _pool != NULL && --_pool->refs == 0 ) {
+            _free_slabs( _pool );
+            std::free( _pool );
+        }
+        _pool = NULL;
+    };
+
+    static void _grow( _pool_type *pool )
+    {
+        size_t chunks = ( _slab_size - _slab_header ) / _chunk_size;
+        char  *slab   = static_cast<char *>( std::malloc( _slab_size ) );
+        if ( slab == NULL )
+            throw std::bad_alloc();
+        *reinterpret_cast<void **>( slab ) = pool->slabs;
+        pool->slabs                        = slab;
+        pool->cursor                       = slab + _slab_header;
+        pool->end = pool->cursor + chunks * _chunk_size;
+    };
+
+    static void _free_slabs( _pool_type *pool )
+    {
+        while ( pool->slabs != NULL ) {
+            void *next = *static_cast<void **>( pool->slabs );
+            std::free( pool->slabs );
+            pool->slabs = next;
+        }
+        pool->cursor    = NULL;
+        pool->end       = NULL;
+        pool->free_list = NULL;
+    };
+
+    mutable _pool_type *_pool;
+};
+
+template < typename T, typename U, size_t SlabBytes >
+inline bool operator==( const node_pool_allocator<T, SlabBytes> &,
+                        const node_pool_allocator<U, SlabBytes> & )
+{
+    return false;
+}
+
+template < typename T, size_t SlabBytes >
+inline bool operator==( const node_pool_allocator<T, SlabBytes> &lhs,
+                        const node_pool_allocator<T, SlabBytes> &rhs )
+{
+    return lhs.shares_pool( rhs );
+}
+
+template < typename T, typename U, size_t SlabBytes >
+inline bool operator!=( const node_pool_allocator<T, SlabBytes> &lhs,
+                        const node_pool_allocator<U, SlabBytes> &rhs )
+{
+    return !( lhs == rhs );
+}
+
+} // namespace ft
+
+#endif // NODE_POOL_ALLOCATOR_HPP
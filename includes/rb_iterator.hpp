@@ -6,12 +6,17 @@
 
 #include "iterator_traits.hpp"
 #include "rb_node.hpp"
+#include "rb_policy.hpp"
 
 using namespace ft;
 
 namespace ft {
 
-template < typename Iterator >
+/**
+ * @brief Bidirectional iterator over the nodes of an rb_tree, stepping as the
+ * Policy of the tree does, see rb_plain_policy.
+ */
+template < typename Iterator, typename Policy = rb_plain_policy >
 class rb_iterator : public iterator< bidirectional_iterator_tag, Iterator > {
 public:
     typedef Iterator                                            iterator_type;
@@ -21,87 +26,96 @@ public:
     typedef typename iterator_traits<Iterator>::difference_type difference_type;
     typedef rb_node<value_type>                                 node;
     typedef node                                               *node_pointer;
+    typedef rb_node_base::base_ptr                              base_ptr;
+
+private:
+    typedef typename Policy::template traits<value_type> policy_traits;
 
+public:
     // Constructors
     rb_iterator() : _node( NULL ) {};
 
-    explicit rb_iterator( node_pointer nptr ) : _node( nptr ) {};
+    explicit rb_iterator( base_ptr nptr ) : _node( nptr ) {};
 
     template < typename OtherIt >
-    rb_iterator( const rb_iterator<OtherIt> &it ) : _node( it.base() ) {};
+    rb_iterator( const rb_iterator<OtherIt, Policy> &it ) :
+        _node( it.base() ) {};
 
     // Destructor
     ~rb_iterator() {};
 
     // Operators
     template < typename OtherIt >
-    rb_iterator &operator=( const rb_iterator< OtherIt > &it )
+    rb_iterator &operator=( const rb_iterator< OtherIt, Policy > &it )
     {
         _node = it.base();
         return *this;
     };
 
-    reference operator*() const { return _node->data; };
+    reference operator*() const
+    {
+        return static_cast<node_pointer>( _node )->data;
+    };
 
     rb_iterator operator++( int )
     {
-        node_pointer tmp = _node;
-        _node            = node::successor( _node );
+        base_ptr tmp = _node;
+        _node        = policy_traits::successor( _node );
         return rb_iterator( tmp );
     };
 
     rb_iterator &operator++()
     {
-        _node = node::successor( _node );
+        _node = policy_traits::successor( _node );
         return *this;
     };
 
     rb_iterator operator--( int )
     {
-        node_pointer tmp = _node;
-        _node            = node::predecessor( _node );
+        base_ptr tmp = _node;
+        _node        = policy_traits::predecessor( _node );
         return rb_iterator( tmp );
     };
 
     rb_iterator &operator--()
     {
-        _node = node::predecessor( _node );
+        _node = policy_traits::predecessor( _node );
         return *this;
     };
 
     pointer operator->() const { return &( operator*() ); };
 
     // Accessors
-    node_pointer base() const { return _node; };
+    base_ptr base() const { return _node; };
 
 protected:
-    node_pointer _node;
+    base_ptr _node;
 };
 
-template < typename Iterator >
-inline bool operator==( const rb_iterator< Iterator > &lhs,
-                        const rb_iterator< Iterator > &rhs )
+template < typename Iterator, typename Policy >
+inline bool operator==( const rb_iterator< Iterator, Policy > &lhs,
+                        const rb_iterator< Iterator, Policy > &rhs )
 {
     return lhs.base() == rhs.base();
 }
 
-template < typename Iterator >
-inline bool operator!=( const rb_iterator< Iterator > &lhs,
-                        const rb_iterator< Iterator > &rhs )
+template < typename Iterator, typename Policy >
+inline bool operator!=( const rb_iterator< Iterator, Policy > &lhs,
+                        const rb_iterator< Iterator, Policy > &rhs )
 {
     return lhs.base() != rhs.base();
 }
 
-template < typename It1, typename It2 >
-inline bool operator==( const rb_iterator< It1 > &lhs,
-                        const rb_iterator< It2 > &rhs )
+template < typename It1, typename It2, typename Policy >
+inline bool operator==( const rb_iterator< It1, Policy > &lhs,
+                        const rb_iterator< It2, Policy > &rhs )
 {
     return lhs.base() == rhs.base();
 }
 
-template < typename It1, typename It2 >
-inline bool operator!=( const rb_iterator< It1 > &lhs,
-                        const rb_iterator< It2 > &rhs )
+template < typename It1, typename It2, typename Policy >
+inline bool operator!=( const rb_iterator< It1, Policy > &lhs,
+                        const rb_iterator< It2, Policy > &rhs )
 {
     return lhs.base() != rhs.base();
 }
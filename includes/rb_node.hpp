@@ -10,88 +10,120 @@ namespace ft {
 
 typedef enum rb_node_color { RED = true, BLACK = false } t_rb_node_color;
 
-template <typename T>
-struct rb_node
+/**
+ * @brief The links of a red-black tree node: the parent pointer, with the
+ * color packed in its low bit, and the two children. Missing children are
+ * NULL. Each tree owns a header node whose parent is the root and whose left
+ * and right are the leftmost and rightmost nodes. The header is red and is
+ * the parent of the root, which is how iterators recognize it.
+ */
+struct rb_node_base
 {
-    typedef rb_node<T> node;
-    typedef node      *node_pointer;
+    typedef rb_node_base       *base_ptr;
+    typedef const rb_node_base *const_base_ptr;
+
+    rb_node_base() : _parent_color( 0 ), left( NULL ), right( NULL ) {}
 
-    explicit rb_node( const T      &_data,
-                      node_pointer  _root,
-                      node_pointer  _leaf,
-                      node_pointer  _parent = NULL,
-                      node_pointer  _left   = NULL,
-                      node_pointer  _right  = NULL,
-                      rb_node_color _color  = BLACK ) :
-        data( _data ),
-        root( _root ), leaf( _leaf ), parent( _parent ), left( _left ),
-        right( _right ), color( _color )
+    base_ptr parent() const
     {
+        return reinterpret_cast<base_ptr>( _parent_color & ~_color_bit );
     }
 
-    // Public attributes
-    T             data;
-    node_pointer  root;
-    node_pointer  leaf;
-    node_pointer  parent;
-    node_pointer  left;
-    node_pointer  right;
-    rb_node_color color;
-
-    // Member functions
-    static node_pointer minimum( node_pointer node )
+    rb_node_color color() const
+    {
+        return ( _parent_color & _color_bit ) ? BLACK : RED;
+    }
+
+    void set_parent( base_ptr p )
     {
-        while ( node->left != node->leaf ) {
+        _parent_color = reinterpret_cast<size_t>( p )
+                      | ( _parent_color & _color_bit );
+    }
+
+    void set_color( rb_node_color c )
+    {
+        _parent_color = ( _parent_color & ~_color_bit )
+                      | ( c == BLACK ? _color_bit : 0 );
+    }
+
+    void set_parent_and_color( base_ptr p, rb_node_color c )
+    {
+        _parent_color = reinterpret_cast<size_t>( p )
+                      | ( c == BLACK ? _color_bit : 0 );
+    }
+
+    static base_ptr minimum( base_ptr node )
+    {
+        while ( node->left != NULL ) {
             node = node->left;
         }
         return node;
     }
 
-    static node_pointer maximum( node_pointer node )
+    static base_ptr maximum( base_ptr node )
     {
-        while ( node->right != node->leaf ) {
+        while ( node->right != NULL ) {
             node = node->right;
         }
         return node;
     }
 
-    static node_pointer successor( node_pointer x )
+    /**
+     * @brief The next node in order, the header after the rightmost node.
+     */
+    static base_ptr successor( base_ptr x )
     {
-        if ( x == x->leaf ) {
-            return maximum( get_root( x ) );
-        }
-        if ( x->right != x->leaf ) {
+        if ( x->right != NULL ) {
             return minimum( x->right );
         }
-        node_pointer y = x->parent;
-        while ( y != y->leaf && x == y->right ) {
+        base_ptr y = x->parent();
+        while ( x == y->right ) {
             x = y;
-            y = y->parent;
+            y = y->parent();
         }
-        return y;
+        // x reached the header from the root of a tree without right subtree
+        return x->right != y ? y : x;
     }
 
-    static node_pointer predecessor( node_pointer x )
+    /**
+     * @brief The previous node in order, the rightmost node before the header.
+     */
+    static base_ptr predecessor( base_ptr x )
     {
-        if ( x == x->leaf ) {
-            return maximum( get_root( x ) );
+        if ( x->color() == RED && x->parent()->parent() == x ) {
+            return x->right;
         }
-        if ( x->left != x->leaf ) {
+        if ( x->left != NULL ) {
             return maximum( x->left );
         }
-        node_pointer y = x->parent;
-        while ( y != y->leaf && x == y->left ) {
+        base_ptr y = x->parent();
+        while ( x == y->left ) {
             x = y;
-            y = y->parent;
+            y = y->parent();
         }
         return y;
     }
 
-    // Accessors
-    static node_pointer get_root( node_pointer node )
-    {
-        return node->leaf->root;
-    }
+private:
+    enum { _color_bit = 1 };
+
+    size_t _parent_color;
+
+public:
+    base_ptr left;
+    base_ptr right;
+};
+
+template <typename T>
+struct rb_node : public rb_node_base
+{
+    typedef rb_node<T> node;
+    typedef node      *node_pointer;
+
+    explicit rb_node( const T &_data ) : data( _data ) {}
+
+    // Public attributes
+    T data;
 };
 
 } // namespace ft
@@ -0,0 +1,213 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef RB_POLICY_HPP
+#define RB_POLICY_HPP
+
+#include "rb_node.hpp"
+#include <cstddef>
+
+namespace ft {
+
+/**
+ * @brief The default policy of rb_tree: nodes hold their links and value
+ * only, and every hook compiles to nothing.
+ *
+ * A policy chooses what else a node keeps and keeps it up to date as the tree
+ * changes shape. `Policy::traits<T>` provides:
+ * - `node`, the node type, derived from rb_node<T>;
+ * - `init( x )`, for a new node that will be linked as a leaf;
+ * - `update( x )`, to recompute x from its children;
+ * - `copy( x, y )`, when x takes the place of y, or clones it;
+ * - `adjust_path( x, end, delta )`, when a leaf was linked, delta 1, or a
+ * node unlinked, delta -1, below x and up to the header end;
+ * - `update_path( x, end )`, to recompute x and its ancestors below end after
+ * a subtree was grafted under x;
+ * - `successor( x )` and `predecessor( x )`, the steps of the iterators;
+ * - `link( x, end )`, after x was linked as a leaf, and `unlink( x, end )`,
+ * before x is unlinked;
+ * - `connect( x, y, end )`, when y became the next node after x, either of
+ * them being the header end after the last or before the first node;
+ * - `thread( end )`, after the tree below end was built or copied at once.
+ */
+struct rb_plain_policy
+{
+    template < typename T >
+    struct traits
+    {
+        typedef rb_node<T>             node;
+        typedef rb_node_base::base_ptr base_ptr;
+
+        static void init( base_ptr ) {};
+        static void update( base_ptr ) {};
+        static void copy( base_ptr, base_ptr ) {};
+        static void adjust_path( base_ptr, base_ptr, ptrdiff_t ) {};
+        static void update_path( base_ptr, base_ptr ) {};
+
+        static base_ptr successor( base_ptr x )
+        {
+            return rb_node_base::successor( x );
+        };
+
+        static base_ptr predecessor( base_ptr x )
+        {
+            return rb_node_base::predecessor( x );
+        };
+
+        static void link( base_ptr, base_ptr ) {};
+        static void unlink( base_ptr, base_ptr ) {};
+        static void connect( base_ptr, base_ptr, base_ptr ) {};
+        static void thread( base_ptr ) {};
+    };
+};
+
+/**
+ * @brief A red-black tree node that also counts the nodes of its subtree.
+ */
+template < typename T >
+struct rb_ranked_node : public rb_node<T>
+{
+    explicit rb_ranked_node( const T &_data ) : rb_node<T>( _data ) {}
+
+    size_t count;
+};
+
+/**
+ * @brief Order statistics policy: every node counts the nodes of its subtree,
+ * so trees find the k-th element, the rank of a key and the distance between
+ * two iterators in O(log n). Costs a word per node and a walk up to the root
+ * on each insertion and erasure.
+ */
+struct rb_rank_policy
+{
+    template < typename T >
+    struct traits : public rb_plain_policy::traits<T>
+    {
+        typedef rb_ranked_node<T>      node;
+        typedef rb_node_base::base_ptr base_ptr;
+
+        static size_t count( base_ptr x )
+        {
+            return x == NULL ? 0 : static_cast<node *>( x )->count;
+        };
+
+        static void init( base_ptr x ) { static_cast<node *>( x )->count = 1; };
+
+        static void update( base_ptr x )
+        {
+            static_cast<node *>( x )->count
+                = count( x->left ) + count( x->right ) + 1;
+        };
+
+        static void copy( base_ptr x, base_ptr y )
+        {
+            static_cast<node *>( x )->count = count( y );
+        };
+
+        static void adjust_path( base_ptr x, base_ptr end, ptrdiff_t delta )
+        {
+            for ( ; x != end; x = x->parent() ) {
+                static_cast<node *>( x )->count += delta;
+            }
+        };
+
+        static void update_path( base_ptr x, base_ptr end )
+        {
+            for ( ; x != end; x = x->parent() ) {
+                update( x );
+            }
+        };
+    };
+};
+
+/**
+ * @brief A red-black tree node that also links to the previous and next nodes
+ * in order.
+ */
+template < typename T >
+struct rb_threaded_node : public rb_node<T>
+{
+    typedef rb_node_base::base_ptr base_ptr;
+
+    explicit rb_threaded_node( const T &_data ) : rb_node<T>( _data ) {}
+
+    base_ptr prev;
+    base_ptr next;
+};
+
+/**
+ * @brief Threaded policy: every node links to its neighbours in order, so
+ * iterators move in O(1) worst case time by following one pointer instead of
+ * climbing parent chains. Costs two words per node and a few stores on each
+ * insertion and erasure.
+ */
+struct rb_threaded_policy
+{
+    template < typename T >
+    struct traits : public rb_plain_policy::traits<T>
+    {
+        typedef rb_threaded_node<T>    node;
+        typedef rb_node_base::base_ptr base_ptr;
+
+        static base_ptr successor( base_ptr x )
+        {
+            return static_cast<node *>( x )->next;
+        };
+
+        // The header has no links, its predecessor is the rightmost node
+        static base_ptr predecessor( base_ptr x )
+        {
+            if ( x->color() == RED && x->parent()->parent() == x ) {
+                return x->right;
+            }
+            return static_cast<node *>( x )->prev;
+        };
+
+        static void connect( base_ptr x, base_ptr y, base_ptr end )
+        {
+            if ( x != end ) {
+                static_cast<node *>( x )->next = y;
+            }
+            if ( y != end ) {
+                static_cast<node *>( y )->prev = x;
+            }
+        };
+
+        static void link( base_ptr x, base_ptr end )
+        {
+            base_ptr p = x->parent();
+            if ( p == end ) {
+                connect( end, x, end );
+                connect( x, end, end );
+            } else if ( x == p->left ) {
+                connect( static_cast<node *>( p )->prev, x, end );
+                connect( x, p, end );
+            } else {
+                connect( x, static_cast<node *>( p )->next, end );
+                connect( p, x, end );
+            }
+        };
+
+        static void unlink( base_ptr x, base_ptr end )
+        {
+            connect( static_cast<node *>( x )->prev,
+                     static_cast<node *>( x )->next,
+                     end );
+        };
+
+        static void thread( base_ptr end )
+        {
+            base_ptr prev = end;
+            for ( base_ptr x = end->left; x != end;
+                  x          = rb_node_base::successor( x ) ) {
+                connect( prev, x, end );
+                prev = x;
+            }
+            connect( prev, end, end );
+        };
+    };
+};
+
+} // namespace ft
+
+#endif // RB_POLICY_HPP
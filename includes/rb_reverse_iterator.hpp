@@ -18,10 +18,11 @@ class rb_reverse_iterator
 
 public:
     typedef Iterator iterator_type;
-    typedef typedef typename iterator_traits<Iterator>::value_type value_type;
-    typename iterator_traits<Iterator>::iterator_category iterator_category;
-    typedef typename iterator_traits<Iterator>::pointer   pointer;
-    typedef typename iterator_traits<Iterator>::reference reference;
+    typedef typename iterator_traits<Iterator>::iterator_category
+                                                          iterator_category;
+    typedef typename iterator_traits<Iterator>::value_type value_type;
+    typedef typename iterator_traits<Iterator>::pointer    pointer;
+    typedef typename iterator_traits<Iterator>::reference  reference;
     typedef typename iterator_traits<Iterator>::difference_type difference_type;
 
 protected:
@@ -29,7 +30,7 @@ protected:
 
 public:
     // Constructors
-    rb_reverse_iterator() : _it( NULL ) {};
+    rb_reverse_iterator() : _it() {};
 
     explicit rb_reverse_iterator( iterator_type it ) : _it( it ) {};
 
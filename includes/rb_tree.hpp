@@ -6,16 +6,20 @@
 
 #include "algorithm.hpp"
 #include "functional.hpp"
+#include "memory.hpp"
 #include "rb_iterator.hpp"
+#include "rb_policy.hpp"
 #include "reverse_iterator.hpp"
 #include "utility.hpp"
+#include "vector.hpp"
+#include <climits>
 #include <iostream>
 #include <memory.h>
 
 #define RB_TEMPLATE_ARGS                                                       \
     typename Key, typename T, typename KeyOfValue, typename Compare,           \
-        typename Alloc
-#define RB_CLASS_TYPE rb_tree< Key, T, KeyOfValue, Compare, Alloc >
+        typename Alloc, typename Policy
+#define RB_CLASS_TYPE rb_tree< Key, T, KeyOfValue, Compare, Alloc, Policy >
 
 namespace ft {
 
@@ -23,14 +27,18 @@ template < typename Key,
            typename T,
            typename KeyOfValue,
            typename Compare,
-           typename Alloc = std::allocator< T > >
+           typename Alloc  = std::allocator< T >,
+           typename Policy = rb_plain_policy >
 class rb_tree {
+    typedef typename Policy::template traits<T> policy_traits;
 
 public:
-    typedef Key                                                  key_type;
-    typedef T                                                    value_type;
-    typedef Compare                                              key_compare;
-    typedef typename Alloc::template rebind< rb_node<T> >::other allocator_type;
+    typedef Key                                 key_type;
+    typedef T                                   value_type;
+    typedef Compare                             key_compare;
+    typedef Policy                              policy_type;
+    typedef typename policy_traits::node        node;
+    typedef typename Alloc::template rebind< node >::other allocator_type;
 
     typedef value_type       &reference;
     typedef const value_type &const_reference;
@@ -39,19 +47,55 @@ public:
     typedef ptrdiff_t         difference_type;
     typedef size_t            size_type;
 
-    typedef ft::rb_iterator<pointer>             iterator;
-    typedef ft::rb_iterator<const_pointer>       const_iterator;
-    typedef ft::reverse_iterator<iterator>       reverse_iterator;
-    typedef ft::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ft::rb_iterator<pointer, Policy>       iterator;
+    typedef ft::rb_iterator<const_pointer, Policy> const_iterator;
+    typedef ft::reverse_iterator<iterator>         reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>   const_reverse_iterator;
 
-    typedef rb_node<value_type> node;
-    typedef node               *node_pointer;
-    typedef const node         *const_node_pointer;
+    typedef node                  *node_pointer;
+    typedef const node            *const_node_pointer;
+    typedef rb_node_base           base_type;
+    typedef rb_node_base::base_ptr base_ptr;
 
 private:
+    typedef typename Alloc::template rebind<T>::other value_allocator_type;
+
+    // A tree detached from the header while splitting and joining, with a
+    // black root and the number of black nodes on its paths to the leaves
+    struct _subtree
+    {
+        base_ptr  root;
+        size_type black_height;
+    };
+
+    // Ranges up to this length are erased node by node
+    enum { _small_range = 16 };
+
+    // The height of a red-black tree is at most twice the log of its size
+    enum { _max_height = 2 * CHAR_BIT * sizeof( size_type ) };
+
+    enum _set_operation { _set_union, _set_intersection, _set_difference };
+
+    // Set operations and merge search from the previous match when the keys
+    // of the smaller tree are closer than this on average in the larger one
+    enum { _finger_distance = 16 };
+
+    // Walks an array of pointers to values as the values themselves, to build
+    // a tree from elements picked in other trees
+    struct _value_ptr_iterator
+    {
+        const value_type *const *ptr;
+
+        const value_type &operator*() const { return **ptr; };
+        _value_ptr_iterator &operator++()
+        {
+            ++ptr;
+            return *this;
+        };
+    };
+
     allocator_type _alloc;
-    node_pointer   _root;
-    node_pointer   _sentinel;
+    base_type      _header;
     size_type      _size;
     key_compare    _comp;
 
@@ -60,31 +104,20 @@ public:
     explicit rb_tree( const key_compare    &comp  = key_compare(),
                       const allocator_type &alloc = allocator_type() ) :
         _alloc( alloc ),
-        _root( NULL ), _sentinel( NULL ), _size( 0 ), _comp( comp )
+        _header(), _size( 0 ), _comp( comp )
     {
-        _sentinel = _alloc.allocate( 1 );
-        _alloc.construct( _sentinel, create_node( value_type(), BLACK ) );
-        _root = _sentinel;
+        _reset_header();
     };
 
-    rb_tree( const rb_tree &rbt ) : _alloc( rbt._alloc )
+    rb_tree( const rb_tree &rbt ) :
+        _alloc( rbt._alloc ), _header(), _size( 0 ), _comp( rbt._comp )
     {
-        _sentinel = _alloc.allocate( 1 );
-        _alloc.construct( _sentinel, create_node( value_type(), BLACK ) );
-        _root = _sentinel;
-        _copy( rbt._root );
-        _size = rbt._size;
-        _comp = rbt._comp;
+        _reset_header();
+        _copy( rbt );
     };
 
     // Destructor
-    ~rb_tree()
-    {
-        _clear( _root );
-        _alloc.destroy( _sentinel );
-        _alloc.deallocate( _sentinel, 1 );
-        _size = 0;
-    };
+    ~rb_tree() { clear(); };
 
     // Assignment operator
     rb_tree &operator=( const rb_tree &rhs )
@@ -92,24 +125,20 @@ public:
         if ( this == &rhs ) {
             return *this;
         }
-        this->~rb_tree();
-        _alloc    = rhs._alloc;
-        _sentinel = _alloc.allocate( 1 );
-        _alloc.construct( _sentinel, create_node( value_type(), BLACK ) );
-        _root = _sentinel;
-        _copy( rhs._root );
-        _size = rhs._size;
-        _comp = rhs._comp;
+        clear();
+        _alloc = rhs._alloc;
+        _comp  = rhs._comp;
+        _copy( rhs );
         return *this;
     };
 
     // Iterators
 
-    iterator       begin() { return iterator( minimum( _root ) ); };
-    const_iterator begin() const { return const_iterator( minimum( _root ) ); };
+    iterator       begin() { return iterator( _header.left ); };
+    const_iterator begin() const { return const_iterator( _header.left ); };
 
-    iterator       end() { return iterator( _sentinel ); };
-    const_iterator end() const { return const_iterator( _sentinel ); };
+    iterator       end() { return iterator( _end() ); };
+    const_iterator end() const { return const_iterator( _end() ); };
 
     reverse_iterator       rbegin() { return reverse_iterator( end() ); };
     const_reverse_iterator rbegin() const
@@ -137,435 +166,1485 @@ public:
 
     // Modifiers
 
-    void insert( value_type val )
+    /**
+     * @brief Inserts val unless an element with an equivalent key exists, in
+     * a single descent from the root.
+     *
+     * @param val The value to insert.
+     * @return ft::pair<iterator, bool> The element with the key of val, and
+     * whether it was inserted.
+     */
+    ft::pair<iterator, bool> insert_unique( const value_type &val )
     {
-        node_pointer z = search( KeyOfValue()( val ) );
-        if ( z != _sentinel ) {
-            _erase( z );
+        base_ptr parent = NULL;
+        bool     left   = true;
+        base_ptr j      = _unique_position( KeyOfValue()( val ), parent, left );
+        if ( j != NULL ) {
+            return ft::make_pair( iterator( j ), false );
         }
-        _insert( val );
+        return ft::make_pair( _link( val, parent, left ), true );
     };
 
-    void insert( value_type val, node_pointer nptr )
+    /**
+     * @brief Inserts an element with key k unless one exists, in a single
+     * descent from the root. Nothing is constructed when k is found.
+     *
+     * @param k The key of the element.
+     * @param construct The functor called with the uninitialized storage of
+     * the element in a new node, to construct it there with key k.
+     * @return ft::pair<iterator, bool> The element with key k, and whether it
+     * was inserted.
+     */
+    template < typename Construct >
+    ft::pair<iterator, bool> emplace_unique( const key_type  &k,
+                                             const Construct &construct )
     {
-        node_pointer z = search( KeyOfValue()( val ), nptr );
-        if ( z != _sentinel ) {
-            _erase( z );
+        base_ptr parent = NULL;
+        bool     left   = true;
+        base_ptr j      = _unique_position( k, parent, left );
+        if ( j != NULL ) {
+            return ft::make_pair( iterator( j ), false );
         }
-        _insert( val );
+        return ft::make_pair(
+            _link_node( _construct_node( construct ), parent, left ), true );
     };
 
-    iterator insert_unique( value_type val ) { return _insert( val ); };
+    /**
+     * @brief Links the node of a handle unless an element with an equivalent
+     * key exists. The node is relinked when the handle and the tree have equal
+     * allocators, and its value copied into a new node otherwise. Either way
+     * the handle ends up empty if the value was inserted, and keeps its node
+     * if not.
+     *
+     * @param nh The handle, from extract.
+     * @return ft::pair<iterator, bool> The element with the key of the node,
+     * and whether it was inserted, end() and false for an empty handle.
+     */
+    template < typename NodeHandle >
+    ft::pair<iterator, bool> insert_node( NodeHandle &nh )
+    {
+        if ( nh.empty() ) {
+            return ft::make_pair( end(), false );
+        }
+        base_ptr parent = NULL;
+        bool     left   = true;
+        base_ptr j      = _unique_position( _key( nh.base() ), parent, left );
+        if ( j != NULL ) {
+            return ft::make_pair( iterator( j ), false );
+        }
+        if ( nh.get_allocator() == _alloc ) {
+            return ft::make_pair( _link_node( nh.release(), parent, left ),
+                                  true );
+        }
+        iterator it = _link( nh.value(), parent, left );
+        nh          = NodeHandle();
+        return ft::make_pair( it, true );
+    };
 
-    void erase( key_type k )
+    /**
+     * @brief Unlinks the node of pos from the tree without destroying it.
+     *
+     * @return NodeHandle The handle that owns the node from then on.
+     */
+    template < typename NodeHandle >
+    NodeHandle extract( iterator pos )
     {
-        node_pointer nptr = search( k );
-        if ( nptr == _sentinel ) {
+        base_ptr z = pos.base();
+        _unlink( z );
+        _reset_node( z );
+        return NodeHandle( static_cast<node_pointer>( z ), _alloc );
+    };
+
+    /**
+     * @brief Moves the elements of src whose keys are not in this tree,
+     * relinking their nodes when the allocators are equal and copying them
+     * otherwise. The other elements stay in src.
+     */
+    void merge( rb_tree &src )
+    {
+        if ( &src == this ) {
             return;
         }
-        _erase( nptr );
+        // The keys of src come in order, so each search can start from the
+        // previous one, see _pick_set_operation
+        bool     relink      = src._alloc == _alloc;
+        bool     from_finger = src._size * _finger_distance >= _size;
+        base_ptr finger      = _header.left;
+        for ( base_ptr x = src._header.left, next; x != src._end(); x = next ) {
+            next       = policy_traits::successor( x );
+            base_ptr y = from_finger ? _lower_bound_from( finger, _key( x ) )
+                                     : _lower_bound( _key( x ) );
+            if ( y != _end() && !_comp( _key( x ), _key( y ) ) ) {
+                finger = y;
+                continue;
+            }
+            base_ptr parent = NULL;
+            bool     left   = true;
+            _slot_before( y, parent, left );
+            if ( relink ) {
+                src._unlink( x );
+                _reset_node( x );
+                finger = _link_node( static_cast<node_pointer>( x ),
+                                     parent,
+                                     left ).base();
+            } else {
+                finger = _link( static_cast<node_pointer>( x )->data,
+                                parent,
+                                left ).base();
+                src._erase( x );
+            }
+        }
     };
 
-    void swap( rb_tree &rbt )
+    /**
+     * @brief Inserts the values of [first, last) whose keys are not in the
+     * tree yet. An empty tree given a strictly increasing forward range is
+     * built balanced in linear time, other ranges are inserted one by one at
+     * end().
+     */
+    template < typename InputIt >
+    void insert_range( InputIt first, InputIt last )
+    {
+        typename ft::iterator_traits<InputIt>::iterator_category category;
+        _insert_range( first, last, category );
+    };
+
+    /**
+     * @brief Inserts val unless an element with an equivalent key exists.
+     * When val belongs right before or right after hint, it is linked there
+     * without a descent from the root, so inserting sorted keys at end() takes
+     * amortized constant time. Otherwise this falls back to insert_unique.
+     *
+     * @param hint The position to try first.
+     * @param val The value to insert.
+     * @return iterator The element with the key of val.
+     */
+    iterator insert_unique( iterator hint, const value_type &val )
+    {
+        base_ptr        pos = hint.base();
+        const key_type &k   = KeyOfValue()( val );
+        if ( pos == _end() ) {
+            if ( _size > 0 && _comp( _key( _header.right ), k ) ) {
+                return _link( val, _header.right, false );
+            }
+            return insert_unique( val ).first;
+        }
+        if ( _comp( k, _key( pos ) ) ) {
+            if ( pos == _header.left ) {
+                return _link( val, pos, true );
+            }
+            base_ptr before = policy_traits::predecessor( pos );
+            if ( !_comp( _key( before ), k ) ) {
+                return insert_unique( val ).first;
+            }
+            // One of the two nodes has a free slot between them
+            if ( before->right == NULL ) {
+                return _link( val, before, false );
+            }
+            return _link( val, pos, true );
+        }
+        if ( _comp( _key( pos ), k ) ) {
+            if ( pos == _header.right ) {
+                return _link( val, pos, false );
+            }
+            base_ptr after = policy_traits::successor( pos );
+            if ( !_comp( k, _key( after ) ) ) {
+                return insert_unique( val ).first;
+            }
+            if ( pos->right == NULL ) {
+                return _link( val, pos, false );
+            }
+            return _link( val, after, true );
+        }
+        return hint;
+    };
+
+    // Insertion of equivalent keys, for ft::multimap and ft::multiset
+
+    /**
+     * @brief Inserts val after the elements with an equivalent key, so equal
+     * keys stay in insertion order.
+     */
+    iterator insert_equal( const value_type &val ) { return _insert( val ); };
+
+    /**
+     * @brief Inserts val right before hint when its key belongs there, without
+     * a descent from the root, and after the elements with an equivalent key
+     * otherwise. Inserting at end() or at upper_bound( k ) thus appends to
+     * the elements with key k.
+     *
+     * @param hint The position to insert before.
+     * @param val The value to insert.
+     * @return iterator The inserted element.
+     */
+    iterator insert_equal( iterator hint, const value_type &val )
     {
-        allocator_type tmp_alloc = rbt._alloc;
-        node_pointer   tmp_root  = rbt._root;
-        node_pointer   tmp_sent  = rbt._sentinel;
-        size_type      tmp_size  = rbt._size;
-        key_compare    tmp_comp  = rbt._comp;
+        base_ptr        pos = hint.base();
+        const key_type &k   = KeyOfValue()( val );
+        if ( pos != _end() && _comp( _key( pos ), k ) ) {
+            return _insert( val );
+        }
+        if ( pos != _header.left
+             && _comp( k, _key( policy_traits::predecessor( pos ) ) ) ) {
+            return _insert( val );
+        }
+        base_ptr parent = NULL;
+        bool     left   = true;
+        _slot_before( pos, parent, left );
+        return _link( val, parent, left );
+    };
 
-        rbt._alloc    = _alloc;
-        rbt._root     = _root;
-        rbt._sentinel = _sentinel;
-        rbt._size     = _size;
-        rbt._comp     = _comp;
+    /**
+     * @brief Inserts the values of [first, last), equal keys included. An
+     * empty tree given a sorted forward range is built balanced in linear
+     * time, other ranges are inserted one by one at end().
+     */
+    template < typename InputIt >
+    void insert_range_equal( InputIt first, InputIt last )
+    {
+        typename ft::iterator_traits<InputIt>::iterator_category category;
+        _insert_range_equal( first, last, category );
+    };
 
-        _alloc    = tmp_alloc;
-        _root     = tmp_root;
-        _sentinel = tmp_sent;
-        _size     = tmp_size;
-        _comp     = tmp_comp;
+    /**
+     * @brief Erases the elements with a key equivalent to k, in O(log n) plus
+     * one free per element, see erase( first, last ).
+     *
+     * @return size_type The number of elements erased.
+     */
+    size_type erase_equal( const key_type &k )
+    {
+        ft::pair<iterator, iterator> range = equal_range( k );
+        return erase( range.first, range.second );
+    };
+
+    void erase( iterator pos ) { _erase( pos.base() ); };
+
+    size_type erase( const key_type &k )
+    {
+        base_ptr nptr = search( k );
+        if ( nptr == _end() ) {
+            return 0;
+        }
+        _erase( nptr );
+        return 1;
+    };
+
+    /**
+     * @brief Erases [first, last) in O(log n) plus one free per element: the
+     * tree is split around the range, which is freed whole, and the two outer
+     * parts are joined back. Short ranges are erased one node at a time.
+     *
+     * @return size_type The number of elements erased.
+     */
+    size_type erase( iterator first, iterator last )
+    {
+        if ( first == begin() && last == end() ) {
+            size_type n = _size;
+            clear();
+            return n;
+        }
+        size_type n  = 0;
+        iterator  it = first;
+        for ( ; it != last && n < _small_range; ++it ) {
+            n++;
+        }
+        if ( it == last ) {
+            while ( first != last ) {
+                _erase( ( first++ ).base() );
+            }
+            return n;
+        }
+        return _erase_range( first.base(), last.base() );
+    };
+
+    void swap( rb_tree &rbt )
+    {
+        allocator_type tmp_alloc  = rbt._alloc;
+        base_type      tmp_header = rbt._header;
+        size_type      tmp_size   = rbt._size;
+        key_compare    tmp_comp   = rbt._comp;
+
+        rbt._alloc  = _alloc;
+        rbt._header = _header;
+        rbt._size   = _size;
+        rbt._comp   = _comp;
+
+        _alloc  = tmp_alloc;
+        _header = tmp_header;
+        _size   = tmp_size;
+        _comp   = tmp_comp;
+
+        _relink_header();
+        rbt._relink_header();
     };
 
     void clear()
     {
-        _clear( _root );
-        _root = _sentinel;
+        _clear_all( typename bool_constant<
+                    allocator_can_release<allocator_type>::value>::type() );
+        _reset_header();
         _size = 0;
     };
 
-    // Operations
-
-    node_pointer search( key_type k ) const { return _search( _root, k ); };
+    // Operations, K is key_type or, with a transparent comparator, any type
+    // the comparator accepts
 
-    node_pointer search( key_type k, node_pointer nptr ) const
+    template < typename K >
+    base_ptr search( const K &k ) const
     {
-        return _search( nptr, k );
+        return _search( k );
     };
 
-    size_type count( const key_type &k ) const
+    template < typename K >
+    size_type count( const K &k ) const
     {
-        node_pointer nptr = search( k );
-        if ( nptr == _sentinel ) {
+        base_ptr nptr = search( k );
+        if ( nptr == _end() ) {
             return 0;
         }
         return 1;
     };
 
-    iterator lower_bound( const key_type &k )
+    // The number of elements with a key equivalent to k, in O(log n + count)
+    template < typename K >
+    size_type count_equal( const K &k ) const
     {
-        node_pointer node = _root;
-        node_pointer y    = _sentinel;
-        while ( node != _sentinel ) {
-            if ( !_comp( KeyOfValue()( node->data ), k ) ) {
-                y    = node;
-                node = node->left;
+        ft::pair<base_ptr, base_ptr> range = _equal_range( k );
+        size_type                    n     = 0;
+        for ( base_ptr x = range.first; x != range.second; n++ ) {
+            x = policy_traits::successor( x );
+        }
+        return n;
+    };
+
+    template < typename K >
+    iterator lower_bound( const K &k )
+    {
+        return iterator( _lower_bound( k ) );
+    };
+
+    template < typename K >
+    const_iterator lower_bound( const K &k ) const
+    {
+        return const_iterator( _lower_bound( k ) );
+    };
+
+    template < typename K >
+    iterator upper_bound( const K &k )
+    {
+        return iterator( _upper_bound( k ) );
+    };
+
+    template < typename K >
+    const_iterator upper_bound( const K &k ) const
+    {
+        return const_iterator( _upper_bound( k ) );
+    };
+
+    template < typename K >
+    ft::pair<const_iterator, const_iterator>
+    equal_range( const K &k ) const
+    {
+        ft::pair<base_ptr, base_ptr> range = _equal_range( k );
+        return ft::pair<const_iterator, const_iterator>(
+            const_iterator( range.first ), const_iterator( range.second ) );
+    };
+
+    template < typename K >
+    ft::pair<iterator, iterator> equal_range( const K &k )
+    {
+        ft::pair<base_ptr, base_ptr> range = _equal_range( k );
+        return ft::pair<iterator, iterator>( iterator( range.first ),
+                                             iterator( range.second ) );
+    };
+
+    // Set operations, in O(min(m log n, n + m)) comparisons for trees of m
+    // and n elements, m <= n, plus linear time to build the result
+
+    /**
+     * @brief Replaces the elements of this tree with those of a or b, taking
+     * the element of a when both have the key.
+     */
+    void assign_union( const rb_tree &a, const rb_tree &b )
+    {
+        _assign_set_operation( a, b, _set_union );
+    };
+
+    /**
+     * @brief Replaces the elements of this tree with those of a whose keys
+     * are in b.
+     */
+    void assign_intersection( const rb_tree &a, const rb_tree &b )
+    {
+        _assign_set_operation( a, b, _set_intersection );
+    };
+
+    /**
+     * @brief Replaces the elements of this tree with those of a whose keys
+     * are not in b.
+     */
+    void assign_difference( const rb_tree &a, const rb_tree &b )
+    {
+        _assign_set_operation( a, b, _set_difference );
+    };
+
+    // Order statistics, only with rb_rank_policy
+
+    /**
+     * @brief The node at index k in order, the header when k >= size().
+     */
+    base_ptr nth( size_type k ) const
+    {
+        base_ptr x = _root();
+        while ( x != NULL ) {
+            size_type left = policy_traits::count( x->left );
+            if ( k < left ) {
+                x = x->left;
+            } else if ( k == left ) {
+                return x;
             } else {
-                node = node->right;
+                k -= left + 1;
+                x  = x->right;
             }
         }
-        return iterator( y );
+        return _end();
     };
 
-    const_iterator lower_bound( const key_type &k ) const
+    /**
+     * @brief The number of elements whose key is less than k, which is the
+     * index of lower_bound( k ).
+     */
+    template < typename K >
+    size_type rank( const K &k ) const
     {
-        node_pointer node = _root;
-        node_pointer y    = _sentinel;
-        while ( node != _sentinel ) {
-            if ( !_comp( KeyOfValue()( node->data ), k ) ) {
-                y    = node;
-                node = node->left;
+        base_ptr  x = _root();
+        size_type r = 0;
+        while ( x != NULL ) {
+            if ( _comp( _key( x ), k ) ) {
+                r += policy_traits::count( x->left ) + 1;
+                x  = x->right;
             } else {
-                node = node->right;
+                x = x->left;
             }
         }
-        return iterator( y );
+        return r;
     };
 
-    iterator upper_bound( const key_type &k )
+    /**
+     * @brief The index of the node of an iterator in order, size() for end().
+     */
+    size_type index_of( const_iterator it ) const
     {
-        node_pointer node = _root;
-        node_pointer y    = _sentinel;
-        while ( node != _sentinel ) {
-            if ( _comp( k, KeyOfValue()( node->data ) ) ) {
-                y    = node;
-                node = node->left;
-            } else {
-                node = node->right;
+        base_ptr x = it.base();
+        if ( x == _end() ) {
+            return _size;
+        }
+        size_type r = policy_traits::count( x->left );
+        for ( ; x != _root(); x = x->parent() ) {
+            if ( x == x->parent()->right ) {
+                r += policy_traits::count( x->parent()->left ) + 1;
             }
         }
-        return iterator( y );
+        return r;
     };
 
-    const_iterator upper_bound( const key_type &k ) const
+private:
+    // Member functions
+    base_ptr _end() const { return const_cast<base_ptr>( &_header ); };
+
+    base_ptr _root() const { return _header.parent(); };
+
+    void _set_root( base_ptr nptr )
     {
-        node_pointer node = _root;
-        node_pointer y    = _sentinel;
-        while ( node != _sentinel ) {
-            if ( _comp( k, KeyOfValue()( node->data ) ) ) {
-                y    = node;
-                node = node->left;
-            } else {
-                node = node->right;
+        _header.set_parent( nptr );
+        if ( nptr != NULL ) {
+            nptr->set_parent( _end() );
+        }
+    };
+
+    /**
+     * @brief Empties the header: no root, and the end as leftmost and
+     * rightmost node.
+     */
+    void _reset_header()
+    {
+        _header.set_parent( NULL );
+        _header.set_color( RED );
+        _header.left  = _end();
+        _header.right = _end();
+    };
+
+    /**
+     * @brief Points the root back to this header after the header was copied
+     * from another tree.
+     */
+    void _relink_header()
+    {
+        if ( _root() == NULL ) {
+            _reset_header();
+        } else {
+            _root()->set_parent( _end() );
+            policy_traits::connect( _end(), _header.left, _end() );
+            policy_traits::connect( _header.right, _end(), _end() );
+        }
+    };
+
+    static const key_type &_key( base_ptr nptr )
+    {
+        return KeyOfValue()( static_cast<const_node_pointer>( nptr )->data );
+    };
+
+    static bool _is_black( base_ptr nptr )
+    {
+        return nptr == NULL || nptr->color() == BLACK;
+    };
+
+    node_pointer _create_node( const value_type &val )
+    {
+        node_pointer         z = _alloc.allocate( 1 );
+        value_allocator_type value_alloc( _alloc );
+        try {
+            value_alloc.construct( &z->data, val );
+        } catch ( ... ) {
+            _alloc.deallocate( z, 1 );
+            throw;
+        }
+        _reset_node( z );
+        return z;
+    };
+
+    template < typename Construct >
+    node_pointer _construct_node( const Construct &construct )
+    {
+        node_pointer z = _alloc.allocate( 1 );
+        try {
+            construct( &z->data );
+        } catch ( ... ) {
+            _alloc.deallocate( z, 1 );
+            throw;
+        }
+        _reset_node( z );
+        return z;
+    };
+
+    // Makes z a red leaf without parent, ready to be linked
+    static void _reset_node( base_ptr z )
+    {
+        z->set_parent_and_color( NULL, RED );
+        z->left  = NULL;
+        z->right = NULL;
+        policy_traits::init( z );
+    };
+
+    void _destroy_node( base_ptr nptr )
+    {
+        node_pointer         z = static_cast<node_pointer>( nptr );
+        value_allocator_type value_alloc( _alloc );
+        value_alloc.destroy( &z->data );
+        _alloc.deallocate( z, 1 );
+    };
+
+    /**
+     * @brief Copies the shape and colors of the nodes of rbt into this empty
+     * tree, in linear time and without comparisons.
+     */
+    void _copy( const rb_tree &rbt )
+    {
+        if ( rbt._root() == NULL ) {
+            return;
+        }
+        _set_root( _clone( rbt._root() ) );
+        _header.left  = base_type::minimum( _root() );
+        _header.right = base_type::maximum( _root() );
+        _size         = rbt._size;
+        policy_traits::thread( _end() );
+    };
+
+    node_pointer _clone_node( base_ptr nptr, base_ptr parent )
+    {
+        node_pointer z =
+            _create_node( static_cast<node_pointer>( nptr )->data );
+        z->set_parent_and_color( parent, nptr->color() );
+        policy_traits::copy( z, nptr );
+        return z;
+    };
+
+    /**
+     * @brief Clones the subtree of nptr, recursing into right subtrees and
+     * looping down the left spine. On failure the partial clone is freed.
+     */
+    base_ptr _clone( base_ptr nptr )
+    {
+        base_ptr top = _clone_node( nptr, NULL );
+        try {
+            if ( nptr->right != NULL ) {
+                top->right = _clone( nptr->right );
+                top->right->set_parent( top );
             }
+            base_ptr parent = top;
+            for ( nptr = nptr->left; nptr != NULL; nptr = nptr->left ) {
+                base_ptr y   = _clone_node( nptr, parent );
+                parent->left = y;
+                if ( nptr->right != NULL ) {
+                    y->right = _clone( nptr->right );
+                    y->right->set_parent( y );
+                }
+                parent = y;
+            }
+        } catch ( ... ) {
+            _clear( top );
+            throw;
         }
-        return iterator( y );
+        return top;
     };
 
-    ft::pair<const_iterator, const_iterator>
-    equal_range( const key_type &k ) const
+    void _assign_set_operation( const rb_tree  &a,
+                                const rb_tree  &b,
+                                _set_operation op )
     {
-        return ft::pair<const_iterator, const_iterator>( lower_bound( k ),
-                                                         upper_bound( k ) );
+        rb_tree result( _comp, _alloc );
+        result._pick_set_operation( a, b, op );
+        swap( result );
     };
 
-    ft::pair<iterator, iterator> equal_range( const key_type &k )
+    /**
+     * @brief Builds this empty tree from the result of a set operation on a
+     * and b. Walks the smaller tree in order and finds each of its keys in the
+     * larger one, then builds the tree from the picked elements in linear
+     * time.
+     */
+    void
+    _pick_set_operation( const rb_tree &a, const rb_tree &b, _set_operation op )
     {
-        return ft::pair<iterator, iterator>( lower_bound( k ),
-                                             upper_bound( k ) );
+        bool           a_small = a._size <= b._size;
+        const rb_tree &small   = a_small ? a : b;
+        const rb_tree &large   = a_small ? b : a;
+        // Which elements make the result: keys only in the larger tree, keys
+        // only in the smaller one, keys in both, taken from a
+        bool keep_large = op == _set_union
+                       || ( op == _set_difference && !a_small );
+        bool keep_small = op == _set_union
+                       || ( op == _set_difference && a_small );
+        bool keep_both = op != _set_difference;
+
+        ft::vector<const value_type *> picked;
+        picked.reserve( op == _set_union          ? a._size + b._size
+                        : op == _set_intersection ? small._size
+                                                  : a._size );
+        // Climbing from the previous match takes O(log d) levels for keys d
+        // apart, but a level up costs more than a level down from the root,
+        // whose upper levels stay in cache. next is the first element of the
+        // larger tree not walked yet.
+        bool     from_finger = small._size * _finger_distance >= large._size;
+        base_ptr finger      = large._header.left;
+        base_ptr next        = finger;
+        for ( base_ptr x = small._header.left; x != small._end();
+              x          = policy_traits::successor( x ) ) {
+            finger     = from_finger
+                           ? large._lower_bound_from( finger, _key( x ) )
+                           : large._lower_bound( _key( x ) );
+            bool found = finger != large._end()
+                      && !_comp( _key( x ), _key( finger ) );
+            if ( keep_large ) {
+                _pick( picked, next, finger );
+                next = found ? policy_traits::successor( finger ) : finger;
+            }
+            if ( found && keep_both ) {
+                picked.push_back( _value( a_small ? x : finger ) );
+            } else if ( !found && keep_small ) {
+                picked.push_back( _value( x ) );
+            }
+        }
+        if ( keep_large ) {
+            _pick( picked, next, large._end() );
+        }
+        if ( !picked.empty() ) {
+            _value_ptr_iterator first = { &picked[0] };
+            _assign_sorted( first, picked.size() );
+        }
     };
 
-private:
-    // Member functions
-    void _copy( node_pointer nptr )
+    static const value_type *_value( base_ptr nptr )
     {
-        if ( nptr != nptr->leaf ) {
-            insert_unique( nptr->data );
-            _copy( nptr->left );
-            _copy( nptr->right );
+        return &static_cast<const_node_pointer>( nptr )->data;
+    };
+
+    static void _pick( ft::vector<const value_type *> &picked,
+                       base_ptr                         first,
+                       base_ptr                         last )
+    {
+        for ( ; first != last; first = policy_traits::successor( first ) ) {
+            picked.push_back( _value( first ) );
         }
     };
 
-    void _clear( node_pointer nptr )
+    template < typename InputIt >
+    void _insert_range( InputIt first, InputIt last, std::input_iterator_tag )
     {
-        if ( nptr == _sentinel ) {
+        for ( ; first != last; ++first ) {
+            insert_unique( end(), *first );
+        }
+    };
+
+    template < typename ForwardIt >
+    void
+    _insert_range( ForwardIt first, ForwardIt last, std::forward_iterator_tag )
+    {
+        size_type n = _sorted_length( first, last, true );
+        if ( _size > 0 || n == 0 ) {
+            _insert_range( first, last, std::input_iterator_tag() );
             return;
         }
-        _clear( nptr->left );
-        _clear( nptr->right );
-        _alloc.destroy( nptr );
-        _alloc.deallocate( nptr, 1 );
+        _assign_sorted( first, n );
     };
 
-    iterator _insert( value_type val )
+    template < typename InputIt >
+    void
+    _insert_range_equal( InputIt first, InputIt last, std::input_iterator_tag )
     {
-        node_pointer x = _root;
-        node_pointer y = _sentinel;
-        node_pointer z = _alloc.allocate( 1 );
-        _alloc.construct( z, create_node( val, RED ) );
-        while ( x != _sentinel ) {
-            y = x;
-            if ( _comp( KeyOfValue()( z->data ), KeyOfValue()( x->data ) ) ) {
-                x = x->left;
-            } else {
-                x = x->right;
+        for ( ; first != last; ++first ) {
+            insert_equal( end(), *first );
+        }
+    };
+
+    template < typename ForwardIt >
+    void _insert_range_equal( ForwardIt                 first,
+                              ForwardIt                 last,
+                              std::forward_iterator_tag )
+    {
+        size_type n = _sorted_length( first, last, false );
+        if ( _size > 0 || n == 0 ) {
+            _insert_range_equal( first, last, std::input_iterator_tag() );
+            return;
+        }
+        _assign_sorted( first, n );
+    };
+
+    /**
+     * @brief Builds this empty tree from the n sorted values
+     * starting at first.
+     */
+    template < typename ForwardIt >
+    void _assign_sorted( ForwardIt first, size_type n )
+    {
+        if ( n == 0 ) {
+            return;
+        }
+        // Only the deepest level can be incomplete, its nodes are red
+        size_type depth = 0;
+        while ( ( n >> ( depth + 1 ) ) != 0 ) {
+            depth++;
+        }
+        _set_root( _build( first, n, 0, depth > 0 ? depth : size_type( -1 ) ) );
+        _header.left  = base_type::minimum( _root() );
+        _header.right = base_type::maximum( _root() );
+        _size         = n;
+        policy_traits::thread( _end() );
+    };
+
+    /**
+     * @brief The length of [first, last) if its keys are increasing, strictly
+     * when unique, 0 otherwise.
+     */
+    template < typename ForwardIt >
+    size_type
+    _sorted_length( ForwardIt first, ForwardIt last, bool unique ) const
+    {
+        if ( first == last ) {
+            return 0;
+        }
+        size_type n    = 1;
+        ForwardIt prev = first;
+        for ( ++first; first != last; ++prev, ++first, ++n ) {
+            if ( unique ) {
+                if ( !_comp( KeyOfValue()( *prev ), KeyOfValue()( *first ) ) ) {
+                    return 0;
+                }
+            } else if ( _comp( KeyOfValue()( *first ),
+                               KeyOfValue()( *prev ) ) ) {
+                return 0;
             }
         }
-        z->parent = y;
-        if ( y == _sentinel ) {
-            _root = z;
-        } else if ( _comp( KeyOfValue()( z->data ),
-                           KeyOfValue()( y->data ) ) ) {
-            y->left = z;
+        return n;
+    };
+
+    /**
+     * @brief Builds a perfectly balanced tree from the n sorted values
+     * starting at first, which is advanced past them, in order. Nodes at
+     * red_depth are red, the others black.
+     */
+    template < typename ForwardIt >
+    base_ptr _build( ForwardIt &first,
+                     size_type  n,
+                     size_type  depth,
+                     size_type  red_depth )
+    {
+        if ( n == 0 ) {
+            return NULL;
+        }
+        size_type    half = ( n - 1 ) / 2;
+        base_ptr     left = _build( first, half, depth + 1, red_depth );
+        node_pointer z    = NULL;
+        try {
+            z = _create_node( *first );
+        } catch ( ... ) {
+            _clear( left );
+            throw;
+        }
+        ++first;
+        z->set_color( depth == red_depth ? RED : BLACK );
+        z->left = left;
+        if ( left != NULL ) {
+            left->set_parent( z );
+        }
+        try {
+            z->right = _build( first, n - 1 - half, depth + 1, red_depth );
+        } catch ( ... ) {
+            _clear( z );
+            throw;
+        }
+        if ( z->right != NULL ) {
+            z->right->set_parent( z );
+        }
+        policy_traits::update( z );
+        return z;
+    };
+
+    void _clear_all( false_type ) { _clear( _root() ); };
+
+    // Frees the slabs of a pooled allocator at once, without visiting the
+    // nodes when there is nothing to destroy in them
+    void _clear_all( true_type )
+    {
+        if ( is_trivially_destructible<T>::value && _alloc.release() ) {
+            return;
+        }
+        _clear( _root() );
+        _alloc.release();
+    };
+
+    size_type _clear( base_ptr nptr )
+    {
+        size_type n = 0;
+        while ( nptr != NULL ) {
+            n += _clear( nptr->right );
+            base_ptr left = nptr->left;
+            _destroy_node( nptr );
+            nptr = left;
+            n++;
+        }
+        return n;
+    };
+
+    iterator _insert( const value_type &val )
+    {
+        base_ptr x    = _root();
+        base_ptr y    = _end();
+        bool     left = true;
+        while ( x != NULL ) {
+            y    = x;
+            left = _comp( KeyOfValue()( val ), _key( x ) );
+            x    = left ? x->left : x->right;
+        }
+        return _link( val, y, left );
+    };
+
+    /**
+     * @brief Finds where a node with key k would be linked, in a single
+     * descent from the root.
+     *
+     * @return base_ptr The element with a key equivalent to k, or NULL, with
+     * parent and left set to the free slot for k.
+     */
+    base_ptr _unique_position( const key_type &k, base_ptr &parent, bool &left )
+    {
+        base_ptr x = _root();
+        parent     = _end();
+        left       = true;
+        while ( x != NULL ) {
+            parent = x;
+            left   = _comp( k, _key( x ) );
+            x      = left ? x->left : x->right;
+        }
+        // The only candidate equivalent key is the one right before k
+        base_ptr j = parent;
+        if ( left ) {
+            if ( j == _header.left ) {
+                return NULL;
+            }
+            j = policy_traits::predecessor( j );
+        }
+        if ( _comp( _key( j ), k ) ) {
+            return NULL;
+        }
+        return j;
+    };
+
+    /**
+     * @brief The free slot right before y, the lower bound of a key missing
+     * from the tree: left of y, or right of the node before it.
+     */
+    void _slot_before( base_ptr y, base_ptr &parent, bool &left ) const
+    {
+        if ( y != _end() && y->left == NULL ) {
+            parent = y;
+            left   = true;
         } else {
-            y->right = z;
-            z->left  = _sentinel;
-            z->right = _sentinel;
-            z->color = RED;
+            parent = y == _end() ? _header.right
+                                 : policy_traits::predecessor( y );
+            left   = false;
         }
+    };
+
+    /**
+     * @brief Links a new node holding val as the left or right child of
+     * parent, which must be free, and rebalances the tree.
+     */
+    iterator _link( const value_type &val, base_ptr parent, bool left )
+    {
+        return _link_node( _create_node( val ), parent, left );
+    };
+
+    // Links the unlinked node z as _link does
+    iterator _link_node( node_pointer z, base_ptr parent, bool left )
+    {
+        z->set_parent( parent );
+        if ( parent == _end() ) {
+            _set_root( z );
+            _header.left  = z;
+            _header.right = z;
+        } else if ( left ) {
+            parent->left = z;
+            if ( parent == _header.left ) {
+                _header.left = z;
+            }
+        } else {
+            parent->right = z;
+            if ( parent == _header.right ) {
+                _header.right = z;
+            }
+        }
+        policy_traits::adjust_path( parent, _end(), 1 );
+        policy_traits::link( z, _end() );
         _insert_fix( z );
-        _sentinel->root = _root;
         _size++;
         return iterator( z );
     };
 
-    void _insert_fix( node_pointer z )
+    /**
+     * @brief Restores the red-black properties after linking the red node z.
+     *
+     * @return bool Whether the root was red and turned black, which adds one
+     * to the black height of the tree.
+     */
+    bool _insert_fix( base_ptr z )
     {
-        node_pointer y;
-        while ( z->parent->color == RED ) {
-            if ( z->parent == z->parent->parent->left ) {
-                y = z->parent->parent->right;
-                if ( y->color == RED ) {
-                    z->parent->color         = BLACK;
-                    y->color                 = BLACK;
-                    z->parent->parent->color = RED;
-                    z                        = z->parent->parent;
+        base_ptr y;
+        while ( z != _root() && z->parent()->color() == RED ) {
+            base_ptr p = z->parent();
+            base_ptr g = p->parent();
+            if ( p == g->left ) {
+                y = g->right;
+                if ( !_is_black( y ) ) {
+                    p->set_color( BLACK );
+                    y->set_color( BLACK );
+                    g->set_color( RED );
+                    z = g;
                 } else {
-                    if ( z == z->parent->right ) {
-                        z = z->parent;
+                    if ( z == p->right ) {
+                        z = p;
                         _left_rotate( z );
+                        p = z->parent();
                     }
-                    z->parent->color         = BLACK;
-                    z->parent->parent->color = RED;
-                    _right_rotate( z->parent->parent );
+                    p->set_color( BLACK );
+                    g->set_color( RED );
+                    _right_rotate( g );
                 }
             } else {
-                y = z->parent->parent->left;
-                if ( y->color == RED ) {
-                    z->parent->color         = BLACK;
-                    y->color                 = BLACK;
-                    z->parent->parent->color = RED;
-                    z                        = z->parent->parent;
+                y = g->left;
+                if ( !_is_black( y ) ) {
+                    p->set_color( BLACK );
+                    y->set_color( BLACK );
+                    g->set_color( RED );
+                    z = g;
                 } else {
-                    if ( z == z->parent->left ) {
-                        z = z->parent;
+                    if ( z == p->left ) {
+                        z = p;
                         _right_rotate( z );
+                        p = z->parent();
                     }
-                    z->parent->color         = BLACK;
-                    z->parent->parent->color = RED;
-                    _left_rotate( z->parent->parent );
+                    p->set_color( BLACK );
+                    g->set_color( RED );
+                    _left_rotate( g );
                 }
             }
         }
-        _root->color = BLACK;
+        bool grown = _root()->color() == RED;
+        _root()->set_color( BLACK );
+        return grown;
     };
 
-    void _left_rotate( node_pointer x )
+    void _left_rotate( base_ptr x )
     {
-        node_pointer y;
+        base_ptr y;
         y        = x->right;
         x->right = y->left;
-        if ( y->left != _sentinel ) {
-            y->left->parent = x;
-        }
-        y->parent = x->parent;
-        if ( x->parent == _sentinel ) {
-            _root = y;
-        } else if ( x == x->parent->left ) {
-            x->parent->left = y;
+        if ( y->left != NULL ) {
+            y->left->set_parent( x );
+        }
+        if ( x == _root() ) {
+            _set_root( y );
+        } else if ( x == x->parent()->left ) {
+            y->set_parent( x->parent() );
+            x->parent()->left = y;
         } else {
-            x->parent->right = y;
+            y->set_parent( x->parent() );
+            x->parent()->right = y;
         }
-        y->left   = x;
-        x->parent = y;
+        y->left = x;
+        x->set_parent( y );
+        policy_traits::copy( y, x );
+        policy_traits::update( x );
     };
 
-    void _right_rotate( node_pointer x )
+    void _right_rotate( base_ptr x )
     {
-        node_pointer y;
+        base_ptr y;
         y       = x->left;
         x->left = y->right;
-        if ( y->right != _sentinel ) {
-            y->right->parent = x;
-        }
-        y->parent = x->parent;
-        if ( x->parent == _sentinel ) {
-            _root = y;
-        } else if ( x == x->parent->right ) {
-            x->parent->right = y;
+        if ( y->right != NULL ) {
+            y->right->set_parent( x );
+        }
+        if ( x == _root() ) {
+            _set_root( y );
+        } else if ( x == x->parent()->right ) {
+            y->set_parent( x->parent() );
+            x->parent()->right = y;
         } else {
-            x->parent->left = y;
+            y->set_parent( x->parent() );
+            x->parent()->left = y;
         }
-        y->right  = x;
-        x->parent = y;
+        y->right = x;
+        x->set_parent( y );
+        policy_traits::copy( y, x );
+        policy_traits::update( x );
     };
 
-    void _transplant( node_pointer u, node_pointer v )
+    void _transplant( base_ptr u, base_ptr v )
     {
-        if ( u->parent == _sentinel ) {
-            _root = v;
-        } else if ( u == u->parent->left ) {
-            u->parent->left = v;
+        base_ptr p = u->parent();
+        if ( u == _root() ) {
+            _set_root( v );
+            return;
+        } else if ( u == p->left ) {
+            p->left = v;
         } else {
-            u->parent->right = v;
+            p->right = v;
+        }
+        if ( v != NULL ) {
+            v->set_parent( p );
         }
-        v->parent = u->parent;
     };
 
-    void _erase( node_pointer z )
+    void _erase( base_ptr z )
+    {
+        _unlink( z );
+        _destroy_node( z );
+    };
+
+    // Takes z out of the tree and rebalances it, leaving z allocated
+    void _unlink( base_ptr z )
     {
-        node_pointer    x                = NULL;
-        node_pointer    y                = z;
-        t_rb_node_color y_original_color = y->color;
-        if ( z->left == _sentinel ) {
-            x = z->right;
+        base_ptr      x                = NULL;
+        base_ptr      x_parent         = NULL;
+        base_ptr      y                = z;
+        rb_node_color y_original_color = y->color();
+        policy_traits::unlink( z, _end() );
+        if ( z == _header.left ) {
+            _header.left = z->right ? base_type::minimum( z->right )
+                                    : z->parent();
+        }
+        if ( z == _header.right ) {
+            _header.right = z->left ? base_type::maximum( z->left )
+                                    : z->parent();
+        }
+        if ( z->left == NULL || z->right == NULL ) {
+            policy_traits::adjust_path( z->parent(), _end(), -1 );
+        }
+        if ( z->left == NULL ) {
+            x        = z->right;
+            x_parent = z->parent();
             _transplant( z, z->right );
-        } else if ( z->right == _sentinel ) {
-            x = z->left;
+        } else if ( z->right == NULL ) {
+            x        = z->left;
+            x_parent = z->parent();
             _transplant( z, z->left );
         } else {
-            y                = minimum( z->right );
-            y_original_color = y->color;
+            y                = base_type::minimum( z->right );
+            y_original_color = y->color();
             x                = y->right;
-            if ( z != z->right ) {
-                _transplant( y, y->right );
-                y->right         = z->right;
-                y->right->parent = y;
+            policy_traits::adjust_path( y->parent(), _end(), -1 );
+            if ( y->parent() == z ) {
+                x_parent = y;
             } else {
-                x->parent = y;
+                x_parent = y->parent();
+                _transplant( y, y->right );
+                y->right = z->right;
+                y->right->set_parent( y );
             }
             _transplant( z, y );
-            y->left         = z->left;
-            y->left->parent = y;
-            y->color        = z->color;
+            y->left = z->left;
+            y->left->set_parent( y );
+            y->set_color( z->color() );
+            policy_traits::copy( y, z );
         }
-        _alloc.destroy( z );
-        _alloc.deallocate( z, 1 );
         if ( y_original_color == BLACK ) {
-            _erase_fix( x );
+            _erase_fix( x, x_parent );
         }
-        _sentinel->root = _root;
         _size--;
     };
 
-    void _erase_fix( node_pointer x )
+    /**
+     * @brief Restores the black heights after erasing. x may be NULL, so its
+     * parent is passed along.
+     */
+    void _erase_fix( base_ptr x, base_ptr x_parent )
     {
-        node_pointer w;
+        base_ptr w;
 
-        while ( x != _root && x->color == BLACK ) {
-            if ( x == x->parent->left ) {
-                w = x->parent->right;
+        while ( x != _root() && _is_black( x ) ) {
+            if ( x == x_parent->left ) {
+                w = x_parent->right;
 
-                if ( w->color == RED ) {
-                    w->color         = BLACK;
-                    x->parent->color = RED;
-                    _left_rotate( x->parent );
-                    w = x->parent->right;
+                if ( w->color() == RED ) {
+                    w->set_color( BLACK );
+                    x_parent->set_color( RED );
+                    _left_rotate( x_parent );
+                    w = x_parent->right;
                 }
-                if ( w->left->color == BLACK && w->right->color == BLACK ) {
-                    w->color = RED;
-                    x        = x->parent;
+                if ( _is_black( w->left ) && _is_black( w->right ) ) {
+                    w->set_color( RED );
+                    x        = x_parent;
+                    x_parent = x_parent->parent();
                 } else {
-                    if ( w->right->color == BLACK ) {
-                        w->left->color = BLACK;
-                        w->color       = RED;
+                    if ( _is_black( w->right ) ) {
+                        w->left->set_color( BLACK );
+                        w->set_color( RED );
                         _right_rotate( w );
-                        w = x->parent->right;
+                        w = x_parent->right;
+                    }
+                    w->set_color( x_parent->color() );
+                    x_parent->set_color( BLACK );
+                    if ( w->right != NULL ) {
+                        w->right->set_color( BLACK );
                     }
-                    w->color         = x->parent->color;
-                    x->parent->color = BLACK;
-                    w->right->color  = BLACK;
-                    _left_rotate( x->parent );
-                    x = _root;
+                    _left_rotate( x_parent );
+                    x = _root();
                 }
             } else {
-                w = x->parent->left;
+                w = x_parent->left;
 
-                if ( w->color == RED ) {
-                    w->color         = BLACK;
-                    x->parent->color = RED;
-                    _right_rotate( x->parent );
-                    w = x->parent->left;
+                if ( w->color() == RED ) {
+                    w->set_color( BLACK );
+                    x_parent->set_color( RED );
+                    _right_rotate( x_parent );
+                    w = x_parent->left;
                 }
-                if ( w->right->color == BLACK && w->left->color == BLACK ) {
-                    w->color = RED;
-                    x        = x->parent;
+                if ( _is_black( w->right ) && _is_black( w->left ) ) {
+                    w->set_color( RED );
+                    x        = x_parent;
+                    x_parent = x_parent->parent();
                 } else {
-                    if ( w->left->color == BLACK ) {
-                        w->right->color = BLACK;
-                        w->color        = RED;
+                    if ( _is_black( w->left ) ) {
+                        w->right->set_color( BLACK );
+                        w->set_color( RED );
                         _left_rotate( w );
-                        w = x->parent->left;
+                        w = x_parent->left;
+                    }
+                    w->set_color( x_parent->color() );
+                    x_parent->set_color( BLACK );
+                    if ( w->left != NULL ) {
+                        w->left->set_color( BLACK );
                     }
-                    w->color         = x->parent->color;
-                    x->parent->color = BLACK;
-                    w->left->color   = BLACK;
-                    _right_rotate( x->parent );
-                    x = _root;
+                    _right_rotate( x_parent );
+                    x = _root();
                 }
             }
         }
-        x->color = BLACK;
+        if ( x != NULL ) {
+            x->set_color( BLACK );
+        }
     };
 
-    node_pointer minimum( node_pointer nptr ) const
+    /**
+     * @brief Frees the nodes of [first, last), where last is not the end or
+     * first is not the beginning, by splitting the tree around them.
+     */
+    size_type _erase_range( base_ptr first, base_ptr last )
     {
-        return node::minimum( nptr );
+        _subtree  tree = { _root(), 0 };
+        _subtree  before, inner, after;
+        base_ptr  pivot = NULL;
+        base_ptr  prev  = first == _header.left
+                            ? _end()
+                            : policy_traits::predecessor( first );
+        size_type n     = 0;
+        base_ptr  path[_max_height + 2];
+        for ( base_ptr x = tree.root; x != NULL; x = x->left ) {
+            tree.black_height += x->color() == BLACK;
+        }
+        if ( last == _end() ) {
+            _path( tree.root, first, path );
+            _split( tree, path, before, pivot, after );
+            n = _clear( after.root ) + 1;
+            _destroy_node( pivot );
+            tree = before;
+        } else {
+            _path( tree.root, last, path );
+            _split( tree, path, inner, pivot, after );
+            if ( first == _header.left ) {
+                n    = _clear( inner.root );
+                tree = _join( _subtree(), pivot, after );
+            } else {
+                base_ptr head = NULL;
+                _path( inner.root, first, path );
+                _split( inner, path, before, head, inner );
+                n = _clear( inner.root ) + 1;
+                _destroy_node( head );
+                tree = _join( before, pivot, after );
+            }
+        }
+        _set_root( tree.root );
+        if ( tree.root == NULL ) {
+            _reset_header();
+        } else {
+            _header.left  = base_type::minimum( tree.root );
+            _header.right = base_type::maximum( tree.root );
+            policy_traits::connect( prev, last, _end() );
+        }
+        _size -= n;
+        return n;
+    };
+
+    /**
+     * @brief Takes a child of a node apart as a tree of its own, turning its
+     * root black.
+     */
+    static _subtree _detach( base_ptr x, size_type black_height )
+    {
+        _subtree tree = { x, black_height };
+        if ( x != NULL ) {
+            x->set_parent( NULL );
+            if ( x->color() == RED ) {
+                x->set_color( BLACK );
+                tree.black_height++;
+            }
+        }
+        return tree;
     };
 
-    node_pointer maximum( node_pointer nptr ) const
+    /**
+     * @brief Fills path with the nodes from root down to x, followed by NULL.
+     */
+    static void _path( base_ptr root, base_ptr x, base_ptr *path )
     {
-        return node::maximum( nptr );
+        size_type depth = 0;
+        for ( base_ptr y = x; y != root; y = y->parent() ) {
+            depth++;
+        }
+        path[depth + 1] = NULL;
+        for ( size_type i = depth + 1; i-- > 0; x = x->parent() ) {
+            path[i] = x;
+        }
     };
 
-    node_pointer successor( node_pointer nptr ) const
+    /**
+     * @brief Splits tree into the nodes before the last node of path, that
+     * node, and the nodes after it. path holds the nodes from the root of tree
+     * down to it, see _path, so the split needs no comparison and works
+     * among equal keys. Each level of the descent joins one node and subtree
+     * back, for O(log n) in total as the joined trees grow in black height.
+     */
+    void _split( _subtree        tree,
+                 const base_ptr *path,
+                 _subtree       &less,
+                 base_ptr       &equal,
+                 _subtree       &greater )
     {
-        return node::successor( nptr );
+        base_ptr  x        = tree.root;
+        size_type children = tree.black_height - ( x->color() == BLACK );
+        base_ptr  next     = path[1];
+        _subtree  left     = _detach( x->left, children );
+        _subtree  right    = _detach( x->right, children );
+        if ( next != NULL && next == left.root ) {
+            _subtree rest;
+            _split( left, path + 1, less, equal, rest );
+            greater = _join( rest, x, right );
+        } else if ( next != NULL ) {
+            _subtree rest;
+            _split( right, path + 1, rest, equal, greater );
+            less = _join( left, x, rest );
+        } else {
+            less    = left;
+            equal   = x;
+            greater = right;
+        }
     };
 
-    node_pointer predecessor( node_pointer nptr ) const
+    /**
+     * @brief Joins the trees left and right, whose keys are all less and
+     * greater than the one of the node k, with k between them. k goes down
+     * the spine of the taller tree to the level of the shorter one and is
+     * linked there as a red node, then the insertion fixup rebalances, which
+     * costs O(1 + the difference in black heights).
+     */
+    _subtree _join( _subtree left, base_ptr k, _subtree right )
     {
-        return node::predecessor( nptr );
+        _subtree tree;
+        k->left  = left.root;
+        k->right = right.root;
+        if ( left.black_height == right.black_height ) {
+            k->set_parent_and_color( NULL, BLACK );
+            _link_children( k );
+            tree.root         = k;
+            tree.black_height = left.black_height + 1;
+            return tree;
+        }
+        bool      taller_left = left.black_height > right.black_height;
+        _subtree  taller      = taller_left ? left : right;
+        size_type target      = taller_left ? right.black_height
+                                            : left.black_height;
+        base_ptr  parent      = NULL;
+        base_ptr  c           = taller.root;
+        size_type height      = taller.black_height;
+        while ( height != target || !_is_black( c ) ) {
+            height -= c->color() == BLACK;
+            parent  = c;
+            c       = taller_left ? c->right : c->left;
+        }
+        if ( taller_left ) {
+            k->left       = c;
+            parent->right = k;
+        } else {
+            k->right     = c;
+            parent->left = k;
+        }
+        k->set_parent_and_color( parent, RED );
+        _link_children( k );
+        _set_root( taller.root );
+        policy_traits::update_path( k, _end() );
+        tree.black_height = taller.black_height + _insert_fix( k );
+        tree.root         = _root();
+        return tree;
     };
 
-    node_pointer _search( node_pointer nptr, key_type k ) const
+    void _link_children( base_ptr x )
     {
-        if ( nptr == _sentinel
-             || ( !_comp( k, KeyOfValue()( nptr->data ) )
-                  && !_comp( KeyOfValue()( nptr->data ), k ) ) ) {
-            return nptr;
+        if ( x->left != NULL ) {
+            x->left->set_parent( x );
         }
-        if ( _comp( k, KeyOfValue()( nptr->data ) ) ) {
-            return _search( nptr->left, k );
+        if ( x->right != NULL ) {
+            x->right->set_parent( x );
         }
-        return _search( nptr->right, k );
+        policy_traits::update( x );
     };
 
-    node create_node( value_type val, t_rb_node_color color )
+    // One comparison per level down to the lower bound, then one to check it
+    template < typename K >
+    base_ptr _search( const K &k ) const
     {
-        return node(
-            val, _root, _sentinel, _sentinel, _sentinel, _sentinel, color );
-    }
+        base_ptr y = _lower_bound( k );
+        if ( y == _end() || _comp( k, _key( y ) ) ) {
+            return _end();
+        }
+        return y;
+    };
+
+    template < typename K >
+    base_ptr _lower_bound( const K &k ) const
+    {
+        return _lower_bound( _root(), _end(), k );
+    };
+
+    // The first node not less than k in the subtree of node, y if none is
+    template < typename K >
+    base_ptr _lower_bound( base_ptr node, base_ptr y, const K &k ) const
+    {
+        while ( node != NULL ) {
+            if ( !_comp( _key( node ), k ) ) {
+                y    = node;
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return y;
+    };
+
+    /**
+     * @brief The first node not less than k, knowing that the nodes before x
+     * are less than k. Climbs from x until an ancestor is not less than k,
+     * then searches down from there, so the comparisons grow with the log of
+     * the distance from x to the result rather than with the height.
+     */
+    template < typename K >
+    base_ptr _lower_bound_from( base_ptr x, const K &k ) const
+    {
+        if ( x == _end() || !_comp( _key( x ), k ) ) {
+            return x;
+        }
+        for ( base_ptr y = x->parent(); y != _end(); x = y, y = y->parent() ) {
+            if ( x == y->left && !_comp( _key( y ), k ) ) {
+                return _lower_bound( x->right, y, k );
+            }
+        }
+        return _lower_bound( x->right, _end(), k );
+    };
+
+    template < typename K >
+    base_ptr _upper_bound( const K &k ) const
+    {
+        return _upper_bound( _root(), _end(), k );
+    };
+
+    // The first node greater than k in the subtree of node, y if none is
+    template < typename K >
+    base_ptr _upper_bound( base_ptr node, base_ptr y, const K &k ) const
+    {
+        while ( node != NULL ) {
+            if ( _comp( k, _key( node ) ) ) {
+                y    = node;
+                node = node->left;
+            } else {
+                node = node->right;
+            }
+        }
+        return y;
+    };
+
+    /**
+     * @brief The lower and upper bounds of k, sharing the descent from the
+     * root down to the first node with a key equivalent to k.
+     */
+    template < typename K >
+    ft::pair<base_ptr, base_ptr> _equal_range( const K &k ) const
+    {
+        base_ptr node = _root();
+        base_ptr y    = _end();
+        while ( node != NULL ) {
+            if ( _comp( _key( node ), k ) ) {
+                node = node->right;
+            } else if ( _comp( k, _key( node ) ) ) {
+                y    = node;
+                node = node->left;
+            } else {
+                return ft::make_pair( _lower_bound( node->left, node, k ),
+                                      _upper_bound( node->right, y, k ) );
+            }
+        }
+        return ft::make_pair( y, y );
+    };
 };
 
 template < RB_TEMPLATE_ARGS >
@@ -95,7 +95,13 @@ public:
         return *this;
     };
 
-    pointer operator->() const { return &( operator*() ); };
+    // Goes through the operator-> of the underlying iterator, whose reference
+    // may be a proxy that has no address
+    pointer operator->() const
+    {
+        iterator_type tmp = _it;
+        return _arrow( --tmp );
+    };
 
     reference operator[]( difference_type n ) const { return *operator+( n ); };
 
@@ -132,6 +138,19 @@ public:
 
 protected:
     iterator_type _it;
+
+private:
+    template < typename It >
+    static pointer _arrow( const It &it )
+    {
+        return it.operator->();
+    };
+
+    template < typename T >
+    static pointer _arrow( T *p )
+    {
+        return p;
+    };
 };
 
 template < typename Iterator >
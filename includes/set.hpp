@@ -4,10 +4,12 @@
 #ifndef SET_HPP
 #define SET_HPP
 
-#define SET_TEMPLATE_ARGS typename T, typename Compare, typename Alloc
-#define SET_CLASS_TYPE set<T, Compare, Alloc>
+#define SET_TEMPLATE_ARGS                                                      \
+    typename T, typename Compare, typename Alloc, typename Policy
+#define SET_CLASS_TYPE set<T, Compare, Alloc, Policy>
 
 #include "functional.hpp"
+#include "node_handle.hpp"
 #include "rb_tree.hpp"
 #include "utility.hpp"
 #include <memory.h>
@@ -16,12 +18,13 @@ namespace ft {
 
 template < class T,
            class Compare = ft::less<T>,
-           class Alloc   = std::allocator<T> >
+           class Alloc   = std::allocator<T>,
+           class Policy  = ft::rb_plain_policy >
 class set {
     template <typename P>
     struct set_key_compare
     {
-        T operator()( const P &x ) const { return x; }
+        const T &operator()( const P &x ) const { return x; }
     };
 
 public:
@@ -39,7 +42,8 @@ private:
                     value_type,
                     set_key_compare<value_type>,
                     key_compare,
-                    Alloc>
+                    Alloc,
+                    Policy>
                  rb_tree_type;
     rb_tree_type _rb_tree;
 
@@ -53,6 +57,8 @@ public:
     typedef typename rb_tree_type::reverse_iterator reverse_iterator;
     typedef
         typename rb_tree_type::const_reverse_iterator const_reverse_iterator;
+    typedef node_handle<T, typename rb_tree_type::node, allocator_type>
+        node_type;
 
     // Constructors
     explicit set( const key_compare    &comp  = key_compare(),
@@ -66,8 +72,7 @@ public:
          const allocator_type &alloc = allocator_type() ) :
         _rb_tree( comp, alloc )
     {
-        while ( first != last )
-            insert( *first++ );
+        _rb_tree.insert_range( first, last );
     };
 
     set( const set &s ) : _rb_tree( s._rb_tree ) {};
@@ -112,11 +117,7 @@ public:
      */
     ft::pair<iterator, bool> insert( const value_type &val )
     {
-        iterator it = find( val );
-        if ( it == end() ) {
-            return ft::make_pair( _rb_tree.insert_unique( val ), true );
-        }
-        return ft::make_pair( it, false );
+        return _rb_tree.insert_unique( val );
     };
 
     /**
@@ -128,12 +129,7 @@ public:
      */
     iterator insert( iterator position, const value_type &val )
     {
-        iterator it = find( val );
-        if ( it != end() ) {
-            return it;
-        }
-        _rb_tree.insert( val, position.base() );
-        return find( val );
+        return _rb_tree.insert_unique( position, val );
     };
 
     /**
@@ -146,8 +142,7 @@ public:
     template <class InputIterator>
     void insert( InputIterator first, InputIterator last )
     {
-        while ( first != last )
-            insert( *first++ );
+        _rb_tree.insert_range( first, last );
     };
 
     /**
@@ -156,7 +151,7 @@ public:
      * @param position The position of the element to erase.
      * @return iterator The position of the next element.
      */
-    void erase( iterator position ) { _rb_tree.erase( *position ); };
+    void erase( iterator position ) { _rb_tree.erase( position ); };
 
     /**
      * @brief Erases an element from the set.
@@ -164,26 +159,40 @@ public:
      * @param k The key of the element to erase.
      * @return size_type The number of elements erased.
      */
-    size_type erase( const value_type &val )
-    {
-        iterator it = find( val );
-        if ( it == end() ) {
-            return 0;
-        }
-        erase( it );
-        return 1;
-    };
+    size_type erase( const value_type &val ) { return _rb_tree.erase( val ); };
 
     /**
-     * @brief Erases a range of elements from the set.
+     * @brief Erases a range of elements from the set, in O(log n) plus one
+     * deallocation per element.
      *
      * @param first The first element of the range.
-     * @param last The last element of the range.
+     * @param last The element past the range.
      */
     void erase( iterator first, iterator last )
     {
-        while ( first != last )
-            erase( first++ );
+        _rb_tree.erase( first, last );
+    };
+
+    /**
+     * @brief Erases the elements less than a given value.
+     *
+     * @param val The first value to keep.
+     * @return size_type The number of elements erased.
+     */
+    size_type erase_before( const value_type &val )
+    {
+        return _rb_tree.erase( begin(), lower_bound( val ) );
+    };
+
+    /**
+     * @brief Erases the elements greater than a given value.
+     *
+     * @param val The last value to keep.
+     * @return size_type The number of elements erased.
+     */
+    size_type erase_after( const value_type &val )
+    {
+        return _rb_tree.erase( upper_bound( val ), end() );
     };
 
     /**
@@ -198,6 +207,50 @@ public:
      */
     void clear() { _rb_tree.clear(); };
 
+    /**
+     * @brief Unlinks an element from the set without destroying it.
+     *
+     * @param pos The iterator to the element.
+     * @return node_type A handle that owns the element, to insert it into
+     * another set without reallocating.
+     */
+    node_type extract( iterator pos )
+    {
+        return _rb_tree.template extract<node_type>( pos );
+    };
+
+    /**
+     * @brief Unlinks the element equivalent to val, if any, from the set.
+     *
+     * @return node_type A handle that owns the element, or an empty handle.
+     */
+    node_type extract( const value_type &val )
+    {
+        iterator it = find( val );
+        if ( it == end() )
+            return node_type();
+        return extract( it );
+    };
+
+    /**
+     * @brief Links the element of a node handle unless the set holds an
+     * equivalent one. The handle gives up the element if it was inserted, so
+     * it can be a temporary from extract.
+     *
+     * @return ft::pair<iterator, bool> The element equivalent to the one of
+     * the handle, and whether it was inserted.
+     */
+    ft::pair<iterator, bool> insert( const node_type &nh )
+    {
+        return _rb_tree.insert_node( const_cast<node_type &>( nh ) );
+    };
+
+    /**
+     * @brief Moves the elements of src that are not in the set, relinking
+     * their nodes when the allocators compare equal.
+     */
+    void merge( set &src ) { _rb_tree.merge( src._rb_tree ); };
+
     // Observers
     key_compare key_comp() const { return _rb_tree.key_comp(); };
 
@@ -260,36 +313,133 @@ public:
      */
     ft::pair<iterator, iterator> equal_range( const value_type &val ) const
     {
-        return ft::make_pair( lower_bound( val ), upper_bound( val ) );
+        return _rb_tree.equal_range( val );
+    };
+
+    /**
+     * @brief Finds an element equivalent to k, comparing k with the elements
+     * directly instead of converting it to value_type. This and the lookups
+     * below only exist when key_compare declares is_transparent.
+     *
+     * @param k A value of any type key_compare can compare with the elements.
+     */
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           iterator>::type
+    find( const K &k ) const
+    {
+        return iterator( _rb_tree.search( k ) );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           size_type>::type
+    count( const K &k ) const
+    {
+        return _rb_tree.count( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           iterator>::type
+    lower_bound( const K &k ) const
+    {
+        return _rb_tree.lower_bound( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           iterator>::type
+    upper_bound( const K &k ) const
+    {
+        return _rb_tree.upper_bound( k );
+    };
+
+    template < typename K >
+    typename ft::enable_if<ft::_is_transparent<Compare, K>::value,
+                           ft::pair<iterator, iterator> >::type
+    equal_range( const K &k ) const
+    {
+        return _rb_tree.equal_range( k );
+    };
+
+    // Order statistics, only with ft::rb_rank_policy
+
+    /**
+     * @brief Finds the element at index k in order, in O(log n).
+     *
+     * @param k The index of the element.
+     * @return iterator The iterator to the element, or end() if k is not less
+     * than size().
+     */
+    iterator nth( size_type k ) const { return iterator( _rb_tree.nth( k ) ); };
+
+    /**
+     * @brief Counts the elements less than a given value, in O(log n).
+     *
+     * @param val The value to rank.
+     * @return size_type The index of lower_bound( val ).
+     */
+    size_type rank( const value_type &val ) const
+    {
+        return _rb_tree.rank( val );
+    };
+
+    /**
+     * @brief Finds the index of an element in order, in O(log n).
+     *
+     * @param it An iterator to the element, or end() for size().
+     */
+    size_type index_of( iterator it ) const { return _rb_tree.index_of( it ); };
+
+    /**
+     * @brief Counts the increments from first to last, in O(log n).
+     */
+    difference_type distance( iterator first, iterator last ) const
+    {
+        return difference_type( index_of( last ) )
+             - difference_type( index_of( first ) );
     };
 
     // Allocator
     allocator_type get_allocator() const { return _rb_tree.get_allocator(); };
 
     // Non-member functions
-    template <typename T1, typename C1, typename A1>
-    friend bool operator==( const set<T1, C1, A1> &lhs,
-                            const set<T1, C1, A1> &rhs );
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator==( const set<T1, C1, A1, P1> &lhs,
+                            const set<T1, C1, A1, P1> &rhs );
+
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator!=( const set<T1, C1, A1, P1> &lhs,
+                            const set<T1, C1, A1, P1> &rhs );
 
-    template <typename T1, typename C1, typename A1>
-    friend bool operator!=( const set<T1, C1, A1> &lhs,
-                            const set<T1, C1, A1> &rhs );
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator<( const set<T1, C1, A1, P1> &lhs,
+                           const set<T1, C1, A1, P1> &rhs );
 
-    template <typename T1, typename C1, typename A1>
-    friend bool operator<( const set<T1, C1, A1> &lhs,
-                           const set<T1, C1, A1> &rhs );
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator<=( const set<T1, C1, A1, P1> &lhs,
+                            const set<T1, C1, A1, P1> &rhs );
 
-    template <typename T1, typename C1, typename A1>
-    friend bool operator<=( const set<T1, C1, A1> &lhs,
-                            const set<T1, C1, A1> &rhs );
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator>( const set<T1, C1, A1, P1> &lhs,
+                           const set<T1, C1, A1, P1> &rhs );
 
-    template <typename T1, typename C1, typename A1>
-    friend bool operator>( const set<T1, C1, A1> &lhs,
-                           const set<T1, C1, A1> &rhs );
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend bool operator>=( const set<T1, C1, A1, P1> &lhs,
+                            const set<T1, C1, A1, P1> &rhs );
 
-    template <typename T1, typename C1, typename A1>
-    friend bool operator>=( const set<T1, C1, A1> &lhs,
-                            const set<T1, C1, A1> &rhs );
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend set<T1, C1, A1, P1> set_union( const set<T1, C1, A1, P1> &,
+                                          const set<T1, C1, A1, P1> & );
+
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend set<T1, C1, A1, P1> set_intersection( const set<T1, C1, A1, P1> &,
+                                                 const set<T1, C1, A1, P1> & );
+
+    template <typename T1, typename C1, typename A1, typename P1>
+    friend set<T1, C1, A1, P1> set_difference( const set<T1, C1, A1, P1> &,
+                                               const set<T1, C1, A1, P1> & );
 };
 
 template < SET_TEMPLATE_ARGS >
@@ -334,6 +484,49 @@ inline void swap( SET_CLASS_TYPE &lhs, SET_CLASS_TYPE &rhs )
     lhs.swap( rhs );
 }
 
+/**
+ * @brief The elements of lhs and rhs, with the element of lhs when both have
+ * its key. Finds the keys of the smaller of the two in the other, from the
+ * root or from the previous match when they are close, in O(min(m log n,
+ * n + m)) comparisons for sizes m <= n, then builds the balanced result in
+ * linear time.
+ */
+template < SET_TEMPLATE_ARGS >
+inline SET_CLASS_TYPE
+set_union( const SET_CLASS_TYPE &lhs, const SET_CLASS_TYPE &rhs )
+{
+    SET_CLASS_TYPE result( lhs.key_comp(), lhs.get_allocator() );
+    result._rb_tree.assign_union( lhs._rb_tree, rhs._rb_tree );
+    return result;
+}
+
+/**
+ * @brief The elements of lhs whose keys are in rhs, see set_union.
+ */
+template < SET_TEMPLATE_ARGS >
+inline SET_CLASS_TYPE
+set_intersection( const SET_CLASS_TYPE &lhs, const SET_CLASS_TYPE &rhs )
+{
+    SET_CLASS_TYPE result( lhs.key_comp(), lhs.get_allocator() );
+    result._rb_tree.assign_intersection( lhs._rb_tree, rhs._rb_tree );
+    return result;
+}
+
+/**
+ * @brief The elements of lhs whose keys are not in rhs, see set_union.
+ */
+template < SET_TEMPLATE_ARGS >
+inline SET_CLASS_TYPE
+set_difference( const SET_CLASS_TYPE &lhs, const SET_CLASS_TYPE &rhs )
+{
+    SET_CLASS_TYPE result( lhs.key_comp(), lhs.get_allocator() );
+    result._rb_tree.assign_difference( lhs._rb_tree, rhs._rb_tree );
+    return result;
+}
+
+template < SET_TEMPLATE_ARGS >
+struct is_swap_relocatable< SET_CLASS_TYPE > : bool_constant<true> {};
+
 } // namespace ft
 
 #endif // SET_HPP
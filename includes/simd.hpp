@@ -0,0 +1,237 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include "type_traits.hpp"
+#include <cstddef>
+
+/**
+ * On x86-64 with GCC or clang, contiguous arithmetic ranges are compared with
+ * SSE2, which every x86-64 CPU has, or with AVX2 when the CPU running the
+ * program supports it. The AVX2 kernels are compiled with a target attribute,
+ * so the library itself needs no -mavx2. Build with -DFT_NO_SIMD to compare
+ * one element at a time everywhere.
+ */
+#if defined( __x86_64__ ) && defined( __GNUC__ ) && !defined( FT_NO_SIMD )
+#define FT_SIMD_X86 1
+#include <immintrin.h>
+#define FT_TARGET_AVX2 __attribute__( ( target( "avx2" ) ) )
+#else
+#define FT_SIMD_X86 0
+#endif
+
+namespace ft {
+
+enum simd_level { SIMD_NONE, SIMD_SSE2, SIMD_AVX2 };
+
+/**
+ * @brief The widest instruction set the comparison kernels may use on this
+ * CPU, detected on the first call.
+ */
+inline simd_level _simd_level()
+{
+#if FT_SIMD_X86
+    static const simd_level level = ( __builtin_cpu_init(),
+                                      __builtin_cpu_supports( "avx2" ) )
+                                        ? SIMD_AVX2
+                                        : SIMD_SSE2;
+    return level;
+#else
+    return SIMD_NONE;
+#endif
+}
+
+/**
+ * @brief Element types whose contiguous ranges the kernels compare: integers
+ * bytewise, float and double with the IEEE comparisons.
+ */
+template < typename T >
+struct _is_simd_comparable
+    : bool_constant<is_integral<T>::value> {};
+
+template <>
+struct _is_simd_comparable<float> : bool_constant<true> {};
+
+template <>
+struct _is_simd_comparable<double> : bool_constant<true> {};
+
+/**
+ * @brief Finds the first index where a and b differ. With ordered, pairs of
+ * elements that are unordered (a NaN) do not count as a difference, which is
+ * what lexicographical_compare skips over; without it they do, as for equal.
+ *
+ * @return size_t The first differing index, or n when there is none.
+ */
+template < typename T >
+size_t _mismatch_scalar( const T *a, const T *b, size_t n, bool ordered )
+{
+    size_t i = 0;
+    if ( ordered ) {
+        while ( i < n && !( a[i] < b[i] ) && !( b[i] < a[i] ) )
+            ++i;
+    } else {
+        while ( i < n && a[i] == b[i] )
+            ++i;
+    }
+    return i;
+}
+
+#if FT_SIMD_X86
+
+inline size_t
+_mismatch_bytes_sse2( const unsigned char *a, const unsigned char *b, size_t n )
+{
+    size_t i = 0;
+    for ( ; i + 16 <= n; i += 16 ) {
+        __m128i  va   = _mm_loadu_si128( ( const __m128i * ) ( a + i ) );
+        __m128i  vb   = _mm_loadu_si128( ( const __m128i * ) ( b + i ) );
+        unsigned mask = _mm_movemask_epi8( _mm_cmpeq_epi8( va, vb ) );
+        if ( mask != 0xFFFF )
+            return i + __builtin_ctz( ~mask );
+    }
+    return i + _mismatch_scalar( a + i, b + i, n - i, false );
+}
+
+inline FT_TARGET_AVX2 size_t
+_mismatch_bytes_avx2( const unsigned char *a, const unsigned char *b, size_t n )
+{
+    size_t i = 0;
+    for ( ; i + 64 <= n; i += 64 ) {
+        const __m256i *pa = ( const __m256i * ) ( a + i );
+        const __m256i *pb = ( const __m256i * ) ( b + i );
+        __m256i        lo = _mm256_cmpeq_epi8( _mm256_loadu_si256( pa ),
+                                        _mm256_loadu_si256( pb ) );
+        __m256i        hi = _mm256_cmpeq_epi8( _mm256_loadu_si256( pa + 1 ),
+                                        _mm256_loadu_si256( pb + 1 ) );
+        if ( _mm256_movemask_epi8( _mm256_and_si256( lo, hi ) ) != -1 )
+            break;
+    }
+    for ( ; i + 32 <= n; i += 32 ) {
+        __m256i  va   = _mm256_loadu_si256( ( const __m256i * ) ( a + i ) );
+        __m256i  vb   = _mm256_loadu_si256( ( const __m256i * ) ( b + i ) );
+        unsigned mask = _mm256_movemask_epi8( _mm256_cmpeq_epi8( va, vb ) );
+        if ( mask != 0xFFFFFFFFu )
+            return i + __builtin_ctz( ~mask );
+    }
+    return i + _mismatch_bytes_sse2( a + i, b + i, n - i );
+}
+
+inline size_t
+_mismatch_sse2( const float *a, const float *b, size_t n, bool ordered )
+{
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 ) {
+        __m128 va = _mm_loadu_ps( a + i );
+        __m128 vb = _mm_loadu_ps( b + i );
+        int    mask;
+        if ( ordered )
+            mask = _mm_movemask_ps(
+                _mm_or_ps( _mm_cmplt_ps( va, vb ), _mm_cmpgt_ps( va, vb ) ) );
+        else
+            mask = ~_mm_movemask_ps( _mm_cmpeq_ps( va, vb ) ) & 0xF;
+        if ( mask != 0 )
+            return i + __builtin_ctz( mask );
+    }
+    return i + _mismatch_scalar( a + i, b + i, n - i, ordered );
+}
+
+inline size_t
+_mismatch_sse2( const double *a, const double *b, size_t n, bool ordered )
+{
+    size_t i = 0;
+    for ( ; i + 2 <= n; i += 2 ) {
+        __m128d va = _mm_loadu_pd( a + i );
+        __m128d vb = _mm_loadu_pd( b + i );
+        int     mask;
+        if ( ordered )
+            mask = _mm_movemask_pd(
+                _mm_or_pd( _mm_cmplt_pd( va, vb ), _mm_cmpgt_pd( va, vb ) ) );
+        else
+            mask = ~_mm_movemask_pd( _mm_cmpeq_pd( va, vb ) ) & 0x3;
+        if ( mask != 0 )
+            return i + __builtin_ctz( mask );
+    }
+    return i + _mismatch_scalar( a + i, b + i, n - i, ordered );
+}
+
+inline FT_TARGET_AVX2 size_t
+_mismatch_avx2( const float *a, const float *b, size_t n, bool ordered )
+{
+    size_t i = 0;
+    for ( ; i + 8 <= n; i += 8 ) {
+        __m256 va   = _mm256_loadu_ps( a + i );
+        __m256 vb   = _mm256_loadu_ps( b + i );
+        __m256 diff = ordered ? _mm256_cmp_ps( va, vb, _CMP_NEQ_OQ )
+                              : _mm256_cmp_ps( va, vb, _CMP_NEQ_UQ );
+        int    mask = _mm256_movemask_ps( diff );
+        if ( mask != 0 )
+            return i + __builtin_ctz( mask );
+    }
+    return i + _mismatch_sse2( a + i, b + i, n - i, ordered );
+}
+
+inline FT_TARGET_AVX2 size_t
+_mismatch_avx2( const double *a, const double *b, size_t n, bool ordered )
+{
+    size_t i = 0;
+    for ( ; i + 4 <= n; i += 4 ) {
+        __m256d va   = _mm256_loadu_pd( a + i );
+        __m256d vb   = _mm256_loadu_pd( b + i );
+        __m256d diff = ordered ? _mm256_cmp_pd( va, vb, _CMP_NEQ_OQ )
+                               : _mm256_cmp_pd( va, vb, _CMP_NEQ_UQ );
+        int     mask = _mm256_movemask_pd( diff );
+        if ( mask != 0 )
+            return i + __builtin_ctz( mask );
+    }
+    return i + _mismatch_sse2( a + i, b + i, n - i, ordered );
+}
+
+#endif // FT_SIMD_X86
+
+/**
+ * @brief Finds the first index where the integers of a and b differ, by
+ * comparing their bytes.
+ */
+template < typename T >
+size_t _simd_mismatch( const T *a, const T *b, size_t n, bool )
+{
+#if FT_SIMD_X86
+    const unsigned char *ba = reinterpret_cast<const unsigned char *>( a );
+    const unsigned char *bb = reinterpret_cast<const unsigned char *>( b );
+    if ( _simd_level() == SIMD_AVX2 )
+        return _mismatch_bytes_avx2( ba, bb, n * sizeof( T ) ) / sizeof( T );
+    return _mismatch_bytes_sse2( ba, bb, n * sizeof( T ) ) / sizeof( T );
+#else
+    return _mismatch_scalar( a, b, n, false );
+#endif
+}
+
+inline size_t
+_simd_mismatch( const float *a, const float *b, size_t n, bool ordered )
+{
+#if FT_SIMD_X86
+    if ( _simd_level() == SIMD_AVX2 )
+        return _mismatch_avx2( a, b, n, ordered );
+    return _mismatch_sse2( a, b, n, ordered );
+#else
+    return _mismatch_scalar( a, b, n, ordered );
+#endif
+}
+
+inline size_t
+_simd_mismatch( const double *a, const double *b, size_t n, bool ordered )
+{
+#if FT_SIMD_X86
+    if ( _simd_level() == SIMD_AVX2 )
+        return _mismatch_avx2( a, b, n, ordered );
+    return _mismatch_sse2( a, b, n, ordered );
+#else
+    return _mismatch_scalar( a, b, n, ordered );
+#endif
+}
+
+} // namespace ft
+
+#endif // SIMD_HPP
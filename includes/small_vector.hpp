@@ -0,0 +1,919 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#ifndef SMALL_VECTOR_HPP
+#define SMALL_VECTOR_HPP
+
+#include "algorithm.hpp"
+#include "config.hpp"
+#include "iterator.hpp"
+#include "memory.hpp"
+#include "type_traits.hpp"
+#include "vector.hpp"
+#include <memory>
+#include <stdexcept>
+
+#if FT_CXX11
+#include <type_traits>
+#endif
+
+namespace ft {
+
+/**
+ * @brief A vector that stores up to N elements inline and only allocates
+ * once it grows past them. It has the interface of ft::vector and grows
+ * following the same vector_growth_policy.
+ *
+ * Unlike ft::vector, moving or swapping an inline small_vector moves its
+ * elements one by one.
+ *
+ * @tparam T The type of the elements.
+ * @tparam N The number of elements stored inline.
+ * @tparam Alloc The allocator used past N elements.
+ */
+template < typename T, size_t N = 8, typename Alloc = std::allocator<T> >
+class small_vector {
+public:
+    typedef T                                         value_type;
+    typedef Alloc                                     allocator_type;
+    typedef typename allocator_type::reference        reference;
+    typedef typename allocator_type::const_reference  const_reference;
+    typedef typename allocator_type::pointer          pointer;
+    typedef typename allocator_type::const_pointer    const_pointer;
+    typedef typename allocator_type::difference_type  difference_type;
+    typedef typename allocator_type::size_type        size_type;
+    typedef ft::random_access_iterator<pointer>       iterator;
+    typedef ft::random_access_iterator<const_pointer> const_iterator;
+    typedef ft::reverse_iterator<iterator>            reverse_iterator;
+    typedef ft::reverse_iterator<const_iterator>      const_reverse_iterator;
+
+    static const size_type inline_capacity = N;
+
+protected:
+    /**
+     * @brief Raw storage for the inline elements, aligned for any scalar and,
+     * with GNU compilers, for over-aligned element types.
+     */
+    union inline_storage
+    {
+        char        bytes[( N > 0 ? N : 1 ) * sizeof( T )];
+        long double align_long_double;
+        long long   align_long_long;
+        void       *align_pointer;
+#if defined( __GNUC__ )
+        char align_element
+            __attribute__( ( aligned( ft::alignment_of<T>::value ) ) );
+#endif
+    };
+
+    allocator_type _alloc;
+    pointer        _data;
+    size_type      _size;
+    size_type      _capacity;
+    inline_storage _buffer;
+
+public:
+    explicit small_vector( const allocator_type &alloc = allocator_type() ) :
+        _alloc( alloc ), _data( _inline_data() ), _size( 0 ), _capacity( N ) {};
+
+    explicit small_vector( size_type             n,
+                           const value_type     &val   = value_type(),
+                           const allocator_type &alloc = allocator_type() ) :
+        _alloc( alloc ),
+        _data( _inline_data() ), _size( 0 ), _capacity( N )
+    {
+        reserve( n );
+        ft::uninitialized_fill_n( _alloc, _data, n, val );
+        _size = n;
+    };
+
+    template < typename Iterator >
+    small_vector( Iterator              first,
+                  Iterator              last,
+                  const allocator_type &alloc = allocator_type() ) :
+        _alloc( alloc ),
+        _data( _inline_data() ), _size( 0 ), _capacity( N )
+    {
+        typename ft::is_integral<Iterator>::type is_integral;
+        _construct( first, last, is_integral );
+    };
+
+    small_vector( const small_vector &x ) :
+        _alloc( x._alloc ), _data( _inline_data() ), _size( 0 ), _capacity( N )
+    {
+        reserve( x._size );
+        ft::uninitialized_copy_n( _alloc, x._data, x._size, _data );
+        _size = x._size;
+    };
+
+#if FT_CXX11
+    /**
+     * @brief Steals the heap storage of x, or moves its inline elements.
+     *
+     * @param x Another small_vector object of the same type, left empty.
+     */
+    small_vector( small_vector &&x ) noexcept(
+        std::is_nothrow_move_constructible<T>::value ) :
+        _alloc( std::move( x._alloc ) ),
+        _data( _inline_data() ), _size( 0 ), _capacity( N )
+    {
+        _steal( x );
+    };
+#endif
+
+    ~small_vector()
+    {
+        clear();
+        _release();
+    };
+
+    /**
+     * @brief Copies the contents of x, reusing the current storage when it is
+     * large enough.
+     *
+     * @param x Another small_vector object of the same type.
+     * @return small_vector& A reference to this small_vector.
+     */
+    small_vector &operator=( const small_vector &x )
+    {
+        if ( this == &x )
+            return *this;
+        if ( x._size > _capacity ) {
+            clear();
+            reserve( x._size );
+            ft::uninitialized_copy_n( _alloc, x._data, x._size, _data );
+        } else if ( x._size <= _size ) {
+            ft::copy( x._data, x._data + x._size, _data );
+            ft::destroy_n( _alloc, _data + x._size, _size - x._size );
+        } else {
+            ft::copy( x._data, x._data + _size, _data );
+            ft::uninitialized_copy_n(
+                _alloc, x._data + _size, x._size - _size, _data + _size );
+        }
+        _size = x._size;
+        return *this;
+    };
+
+#if FT_CXX11
+    /**
+     * @brief Takes over the allocator and heap storage of x, or moves its
+     * inline elements, as the move constructor does.
+     *
+     * @param x Another small_vector object of the same type, left empty.
+     * @return small_vector& A reference to this small_vector.
+     */
+    small_vector &operator=( small_vector &&x ) noexcept(
+        std::is_nothrow_move_constructible<T>::value )
+    {
+        if ( this == &x )
+            return *this;
+        clear();
+        _release();
+        _data     = _inline_data();
+        _capacity = N;
+        _alloc    = std::move( x._alloc );
+        _steal( x );
+        return *this;
+    };
+#endif
+
+    // Iterators
+    iterator       begin() { return iterator( _data, _data, _data + _size ); };
+    const_iterator begin() const
+    {
+        return const_iterator( _data, _data, _data + _size );
+    };
+
+    iterator end() { return iterator( _data + _size, _data, _data + _size ); };
+    const_iterator end() const
+    {
+        return const_iterator( _data + _size, _data, _data + _size );
+    };
+
+    reverse_iterator       rbegin() { return reverse_iterator( end() ); };
+    const_reverse_iterator rbegin() const
+    {
+        return const_reverse_iterator( end() );
+    };
+
+    reverse_iterator       rend() { return reverse_iterator( begin() ); };
+    const_reverse_iterator rend() const
+    {
+        return const_reverse_iterator( begin() );
+    };
+
+    const_iterator cbegin() const { return begin(); };
+    const_iterator cend() const { return end(); };
+
+    const_reverse_iterator crbegin() const { return rbegin(); };
+    const_reverse_iterator crend() const { return rend(); };
+
+    // Capacity
+    size_type size() const { return _size; };
+    size_type max_size() const { return _alloc.max_size(); };
+
+    /**
+     * @brief Resizes the container so that it contains n elements.
+     *
+     * @param n The new container size, expressed in number of elements.
+     * @param val The value to initialize the new elements with.
+     */
+    void resize( size_type n, value_type val = value_type() )
+    {
+        if ( n > _size ) {
+            if ( n > _capacity )
+                reserve( _recommend( n ) );
+            ft::uninitialized_fill_n( _alloc, _data + _size, n - _size, val );
+        } else {
+            ft::destroy_n( _alloc, _data + n, _size - n );
+        }
+        _size = n;
+    };
+
+    size_type capacity() const { return _capacity; };
+    bool      empty() const { return ( _size == 0 ); };
+
+    /**
+     * @brief Whether the elements are stored inline, i.e. nothing has been
+     * allocated.
+     */
+    bool is_inline() const { return _data == _inline_data(); };
+
+    /**
+     * @brief Reserves the storage capacity for the container to be at least
+     * enough to contain n elements. Does nothing while n fits inline.
+     *
+     * @param n The size of the memory to reserve
+     */
+    void reserve( size_type n )
+    {
+        if ( n > _capacity ) {
+            if ( n > max_size() )
+                throw std::length_error( "small_vector::reserve" );
+            _reallocate( n );
+        }
+    };
+
+    /**
+     * @brief Shrinks the capacity to fit the size, moving the elements back
+     * inline when they fit.
+     */
+    void shrink_to_fit()
+    {
+        if ( !is_inline() && _size < _capacity )
+            _reallocate( _size );
+    };
+
+    // Element access
+    /**
+     * @brief Fetches the element at position n without bounds checking, use
+     * at() for a checked access. Checked by an assertion in
+     * FT_CONTAINERS_DEBUG builds.
+     *
+     * @param n The position of the element to fetch.
+     * @return reference A reference to the element at position n.
+     */
+    reference operator[]( size_type n )
+    {
+        FT_ASSERT( n < _size, "small_vector::operator[] index out of range" );
+        return _data[n];
+    };
+    const_reference operator[]( size_type n ) const
+    {
+        FT_ASSERT( n < _size, "small_vector::operator[] index out of range" );
+        return _data[n];
+    };
+
+    reference at( size_type n )
+    {
+        if ( n >= _size )
+            throw std::out_of_range( "small_vector::at" );
+        return _data[n];
+    };
+    const_reference at( size_type n ) const
+    {
+        if ( n >= _size )
+            throw std::out_of_range( "small_vector::at" );
+        return _data[n];
+    };
+
+    reference front()
+    {
+        FT_ASSERT( _size > 0, "small_vector::front on an empty vector" );
+        return _data[0];
+    };
+    const_reference front() const
+    {
+        FT_ASSERT( _size > 0, "small_vector::front on an empty vector" );
+        return _data[0];
+    };
+
+    reference back()
+    {
+        FT_ASSERT( _size > 0, "small_vector::back on an empty vector" );
+        return _data[_size - 1];
+    };
+    const_reference back() const
+    {
+        FT_ASSERT( _size > 0, "small_vector::back on an empty vector" );
+        return _data[_size - 1];
+    };
+
+    pointer       data() { return _data; };
+    const_pointer data() const { return _data; };
+
+    // Modifiers
+    /**
+     * @brief Replaces the contents with n copies of val.
+     *
+     * @param n Number of elements to assign
+     * @param val Value to assign
+     */
+    void assign( size_type n, const value_type &val )
+    {
+        value_type tmp( val );
+        clear();
+        reserve( n );
+        ft::uninitialized_fill_n( _alloc, _data, n, tmp );
+        _size = n;
+    };
+
+    /**
+     * @brief Replaces the contents with the elements of [first, last).
+     */
+    template < typename Iterator >
+    void assign( Iterator first, Iterator last )
+    {
+        clear();
+        insert( end(), first, last );
+    };
+
+    /**
+     * @brief Pushes a copy of val at the end of the vector. val may be an
+     * element of the vector.
+     *
+     * @param val The value to be copied to the new element.
+     */
+    void push_back( const value_type &val )
+    {
+        if ( _size == _capacity ) {
+            insert( end(), val );
+            return;
+        }
+        _alloc.construct( _data + _size, val );
+        _size++;
+    };
+
+#if FT_CXX11
+    void push_back( value_type &&val ) { emplace_back( std::move( val ) ); };
+
+    /**
+     * @brief Constructs a new element in place at the end of the vector.
+     *
+     * @param args The arguments forwarded to the constructor of the element.
+     * @return reference A reference to the new element.
+     */
+    template < typename... Args >
+    reference emplace_back( Args &&...args )
+    {
+        if ( _size == _capacity ) {
+            emplace( end(), std::forward<Args>( args )... );
+            return back();
+        }
+        ft::construct( _alloc, _data + _size, std::forward<Args>( args )... );
+        return _data[_size++];
+    };
+#endif
+
+    /**
+     * @brief Removes the last element in the vector.
+     */
+    void pop_back()
+    {
+        if ( _size > 0 ) {
+            _alloc.destroy( _data + _size - 1 );
+            _size--;
+        }
+    };
+
+    /**
+     * @brief Inserts a copy of val before position.
+     *
+     * @param position Iterator to the element before which val is inserted.
+     * @param val Value to be copied to the inserted element.
+     * @return Iterator pointing to the inserted element.
+     */
+    iterator insert( iterator position, const value_type &val )
+    {
+        size_type pos = position - begin();
+
+        if ( _size == _capacity ) {
+            size_type cap = _recommend( _size + 1 );
+            pointer   buf = _allocate( cap );
+            try {
+                _alloc.construct( buf + pos, val );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, 1 );
+            return begin() + pos;
+        }
+        value_type tmp( val );
+        _shift_right( pos, 1 );
+        _fill( pos, 1, tmp );
+        _size++;
+        return begin() + pos;
+    };
+
+#if FT_CXX11
+    iterator insert( iterator position, value_type &&val )
+    {
+        return emplace( position, std::move( val ) );
+    };
+
+    /**
+     * @brief Constructs a new element in place before position.
+     *
+     * @param position Iterator to the element before which the new element
+     * will be constructed. position may be the end() iterator.
+     * @param args The arguments forwarded to the constructor of the element.
+     * @return Iterator pointing to the new element.
+     */
+    template < typename... Args >
+    iterator emplace( iterator position, Args &&...args )
+    {
+        size_type pos = position - begin();
+
+        if ( _size == _capacity ) {
+            size_type cap = _recommend( _size + 1 );
+            pointer   buf = _allocate( cap );
+            try {
+                ft::construct(
+                    _alloc, buf + pos, std::forward<Args>( args )... );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, 1 );
+            return begin() + pos;
+        }
+        if ( pos == _size ) {
+            emplace_back( std::forward<Args>( args )... );
+            return begin() + pos;
+        }
+        value_type tmp( std::forward<Args>( args )... );
+        _shift_right( pos, 1 );
+        _data[pos] = std::move( tmp );
+        _size++;
+        return begin() + pos;
+    };
+#endif
+
+    /**
+     * @brief Inserts n copies of val before position.
+     *
+     * @param position Iterator to the element before which the elements are
+     * inserted.
+     * @param n Number of elements to insert.
+     * @param val Value to be copied to the inserted elements.
+     */
+    void insert( iterator position, size_type n, const value_type &val )
+    {
+        if ( position < begin() || position > end() )
+            throw std::out_of_range( "small_vector::insert" );
+        if ( n == 0 )
+            return;
+        if ( n > max_size() - _size )
+            throw std::length_error( "small_vector::insert" );
+        size_type pos = position - begin();
+        if ( _size + n > _capacity ) {
+            size_type cap = _recommend( _size + n );
+            pointer   buf = _allocate( cap );
+            try {
+                ft::uninitialized_fill_n( _alloc, buf + pos, n, val );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, n );
+            return;
+        }
+        value_type tmp( val );
+        _shift_right( pos, n );
+        _fill( pos, n, tmp );
+        _size += n;
+    };
+
+    /**
+     * @brief Inserts copies of the elements of [first, last) before position,
+     * see vector::insert.
+     *
+     * @param position Iterator to the element before which the elements are
+     * inserted.
+     * @param first The iterator to the first element to insert.
+     * @param last The iterator past the last element to insert.
+     */
+    template < typename Iterator >
+    void insert( iterator position, Iterator first, Iterator last )
+    {
+        typename ft::is_integral<Iterator>::type is_integral;
+        _insert_dispatch( position, first, last, is_integral );
+    };
+
+    /**
+     * @brief Erases the element at position.
+     *
+     * @return Iterator pointing to the element that followed the erased one.
+     */
+    iterator erase( iterator position )
+    {
+        if ( position < begin() || position >= end() )
+            throw std::out_of_range( "small_vector::erase" );
+        size_type pos = position - begin();
+        ft::move( _data + pos + 1, _data + _size, _data + pos );
+        _alloc.destroy( _data + _size - 1 );
+        _size--;
+        return begin() + pos;
+    };
+
+    /**
+     * @brief Erases the elements of [first, last).
+     *
+     * @return Iterator pointing to the element that followed the last element
+     * erased.
+     */
+    iterator erase( iterator first, iterator last )
+    {
+        if ( first < begin() || first > end() || last < begin()
+             || last > end() )
+            throw std::out_of_range( "small_vector::erase" );
+        if ( first == last )
+            return first;
+        size_type pos = first - begin();
+        size_type n   = last - first;
+        ft::move( _data + pos + n, _data + _size, _data + pos );
+        ft::destroy_n( _alloc, _data + _size - n, n );
+        _size -= n;
+        return begin() + pos;
+    };
+
+    /**
+     * @brief Exchanges the contents with x. Heap storage is swapped in O(1),
+     * inline elements are moved.
+     *
+     * @param x Another small_vector object of the same type.
+     */
+    void swap( small_vector &x )
+    {
+        if ( this == &x )
+            return;
+        if ( !is_inline() && !x.is_inline() ) {
+            pointer        tmp_data     = _data;
+            size_type      tmp_size     = _size;
+            size_type      tmp_capacity = _capacity;
+            allocator_type tmp_alloc    = _alloc;
+
+            _data     = x._data;
+            _size     = x._size;
+            _capacity = x._capacity;
+            _alloc    = x._alloc;
+
+            x._data     = tmp_data;
+            x._size     = tmp_size;
+            x._capacity = tmp_capacity;
+            x._alloc    = tmp_alloc;
+            return;
+        }
+        small_vector tmp( FT_MOVE( x ) );
+        x     = FT_MOVE( *this );
+        *this = FT_MOVE( tmp );
+    };
+
+    /**
+     * @brief Removes all elements, keeping the capacity.
+     */
+    void clear()
+    {
+        ft::destroy_n( _alloc, _data, _size );
+        _size = 0;
+    };
+
+    // Allocator accessor
+    allocator_type get_allocator() const { return _alloc; };
+
+protected:
+    pointer _inline_data()
+    {
+        return reinterpret_cast<pointer>( _buffer.bytes );
+    };
+    const_pointer _inline_data() const
+    {
+        return reinterpret_cast<const_pointer>( _buffer.bytes );
+    };
+
+    template < typename Integer >
+    void _construct( Integer n, Integer val, true_type )
+    {
+        assign( static_cast<size_type>( n ), static_cast<value_type>( val ) );
+    };
+
+    template < typename Iterator >
+    void _construct( Iterator first, Iterator last, false_type )
+    {
+        typename iterator_traits<Iterator>::iterator_category category;
+        try {
+            _range_insert( 0, first, last, category );
+        } catch ( ... ) {
+            clear();
+            _release();
+            throw;
+        }
+    };
+
+    template < typename Integer >
+    void
+    _insert_dispatch( iterator position, Integer n, Integer val, true_type )
+    {
+        insert( position, static_cast<size_type>( n ), val );
+    };
+
+    template < typename Iterator >
+    void _insert_dispatch( iterator position,
+                           Iterator first,
+                           Iterator last,
+                           false_type )
+    {
+        if ( position < begin() || position > end() )
+            throw std::out_of_range( "small_vector::insert" );
+        typename iterator_traits<Iterator>::iterator_category category;
+        _range_insert( position - begin(), first, last, category );
+    };
+
+    template < typename InputIt >
+    void _range_insert( size_type pos,
+                        InputIt   first,
+                        InputIt   last,
+                        input_iterator_tag )
+    {
+        size_type old_size = _size;
+        for ( ; first != last; ++first )
+            push_back( *first );
+        ft::rotate( _data + pos, _data + old_size, _data + _size );
+    };
+
+    template < typename ForwardIt >
+    void _range_insert( size_type pos,
+                        ForwardIt first,
+                        ForwardIt last,
+                        forward_iterator_tag )
+    {
+        size_type n = ft::distance( first, last );
+        if ( n == 0 )
+            return;
+        if ( n > ( max_size() - _size ) )
+            throw std::length_error( "small_vector::insert" );
+        if ( _size + n > _capacity ) {
+            size_type cap = _recommend( _size + n );
+            pointer   buf = _allocate( cap );
+            try {
+                ft::uninitialized_copy( _alloc,
+                                        ft::_unwrap( first ),
+                                        ft::_unwrap( last ),
+                                        buf + pos );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, n );
+            return;
+        }
+        _shift_right( pos, n );
+        _copy_into_gap( pos, n, ft::_unwrap( first ), ft::_unwrap( last ) );
+        _size += n;
+    };
+
+    /**
+     * @brief Fills the gap opened by _shift_right with copies of the n
+     * elements of [first, last), see vector::_copy_into_gap.
+     */
+    template < typename ForwardIt >
+    void _copy_into_gap( size_type pos,
+                         size_type n,
+                         ForwardIt first,
+                         ForwardIt last )
+    {
+        size_type live = _size - pos < n ? _size - pos : n;
+        ForwardIt mid  = first;
+        ft::advance( mid, live );
+        ft::copy( first, mid, _data + pos );
+        ft::uninitialized_copy( _alloc, mid, last, _data + pos + live );
+    };
+
+    /**
+     * @brief Frees the heap storage, if any. The elements must already be
+     * destroyed.
+     */
+    void _release()
+    {
+        if ( !is_inline() )
+            _alloc.deallocate( _data, _capacity );
+    };
+
+#if FT_CXX11
+    /**
+     * @brief Takes the elements of x into this empty, inline small_vector.
+     */
+    void _steal( small_vector &x )
+    {
+        if ( x.is_inline() ) {
+            ft::uninitialized_move_n( _alloc, x._data, x._size, _data );
+            _size = x._size;
+            x.clear();
+            return;
+        }
+        _data       = x._data;
+        _size       = x._size;
+        _capacity   = x._capacity;
+        x._data     = x._inline_data();
+        x._size     = 0;
+        x._capacity = N;
+    };
+#endif
+
+    pointer _allocate( size_type n )
+    {
+        pointer p = _alloc.allocate( n );
+        if ( p == NULL )
+            throw std::bad_alloc();
+        return p;
+    };
+
+    /**
+     * @brief Completes an insert into a new heap buffer, see
+     * vector::_relocate_around.
+     */
+    void
+    _relocate_around( pointer buf, size_type cap, size_type pos, size_type n )
+    {
+        size_type tail = _size - pos;
+        try {
+            ft::uninitialized_relocate_n(
+                _alloc, _data + pos, tail, buf + pos + n );
+        } catch ( ... ) {
+            ft::destroy_n( _alloc, buf + pos, n );
+            _alloc.deallocate( buf, cap );
+            throw;
+        }
+        try {
+            ft::uninitialized_relocate_n( _alloc, _data, pos, buf );
+        } catch ( ... ) {
+            ft::destroy_n( _alloc, buf + pos, n + tail );
+            _alloc.deallocate( buf, cap );
+            _size = pos;
+            throw;
+        }
+        _release();
+        _data     = buf;
+        _capacity = cap;
+        _size += n;
+    };
+
+    size_type _recommend( size_type n ) const
+    {
+        if ( n > max_size() )
+            throw std::length_error( "small_vector::reserve" );
+        return vector_growth_policy<value_type>::next_capacity(
+            _capacity, n, max_size() );
+    };
+
+    /**
+     * @brief Moves the elements to a buffer of n elements, which is the
+     * inline one when n fits in it.
+     *
+     * @param n The capacity of the new buffer, at least the current size.
+     */
+    void _reallocate( size_type n )
+    {
+        pointer tmp = _inline_data();
+        if ( n > N ) {
+            tmp = _alloc.allocate( n );
+            if ( tmp == NULL )
+                throw std::bad_alloc();
+        } else {
+            n = N;
+        }
+        if ( tmp == _data )
+            return;
+        try {
+            ft::uninitialized_relocate_n( _alloc, _data, _size, tmp );
+        } catch ( ... ) {
+            if ( tmp != _inline_data() )
+                _alloc.deallocate( tmp, n );
+            throw;
+        }
+        _release();
+        _data     = tmp;
+        _capacity = n;
+    };
+
+    /**
+     * @brief Opens a gap of n elements at pos, see vector::_shift_right.
+     */
+    void _shift_right( size_type pos, size_type n )
+    {
+        typename ft::is_trivially_copyable<value_type>::type is_trivial;
+        _shift_right( pos, n, is_trivial );
+    };
+
+    void _shift_right( size_type pos, size_type n, true_type )
+    {
+        ft::copy_backward( _data + pos, _data + _size, _data + _size + n );
+    };
+
+    void _shift_right( size_type pos, size_type n, false_type )
+    {
+        size_type tail = _size - pos;
+        if ( n >= tail ) {
+            ft::uninitialized_move_n(
+                _alloc, _data + pos, tail, _data + pos + n );
+        } else {
+            ft::uninitialized_move_n(
+                _alloc, _data + _size - n, n, _data + _size );
+            ft::move_backward( _data + pos, _data + _size - n, _data + _size );
+        }
+    };
+
+    /**
+     * @brief Fills the gap opened by _shift_right with copies of val.
+     */
+    void _fill( size_type pos, size_type n, const value_type &val )
+    {
+        for ( size_type i = pos; i < pos + n; i++ ) {
+            if ( i < _size )
+                _data[i] = val;
+            else
+                _alloc.construct( _data + i, val );
+        }
+    };
+};
+
+template < typename T, size_t N, typename Alloc >
+const typename small_vector<T, N, Alloc>::size_type
+    small_vector<T, N, Alloc>::inline_capacity;
+
+template < typename T, size_t N, typename Alloc >
+inline bool operator==( const small_vector<T, N, Alloc> &lhs,
+                        const small_vector<T, N, Alloc> &rhs )
+{
+    return ( lhs.size() == rhs.size()
+             && ft::equal( lhs.data(), lhs.data() + lhs.size(), rhs.data() ) );
+}
+
+template < typename T, size_t N, typename Alloc >
+inline bool operator!=( const small_vector<T, N, Alloc> &lhs,
+                        const small_vector<T, N, Alloc> &rhs )
+{
+    return !( lhs == rhs );
+}
+
+template < typename T, size_t N, typename Alloc >
+inline bool operator<( const small_vector<T, N, Alloc> &lhs,
+                       const small_vector<T, N, Alloc> &rhs )
+{
+    return ( ft::lexicographical_compare( lhs.data(),
+                                          lhs.data() + lhs.size(),
+                                          rhs.data(),
+                                          rhs.data() + rhs.size() ) );
+}
+
+template < typename T, size_t N, typename Alloc >
+inline bool operator<=( const small_vector<T, N, Alloc> &lhs,
+                        const small_vector<T, N, Alloc> &rhs )
+{
+    return !( rhs < lhs );
+}
+
+template < typename T, size_t N, typename Alloc >
+inline bool operator>( const small_vector<T, N, Alloc> &lhs,
+                       const small_vector<T, N, Alloc> &rhs )
+{
+    return rhs < lhs;
+}
+
+template < typename T, size_t N, typename Alloc >
+inline bool operator>=( const small_vector<T, N, Alloc> &lhs,
+                        const small_vector<T, N, Alloc> &rhs )
+{
+    return !( lhs < rhs );
+}
+
+template < typename T, size_t N, typename Alloc >
+inline void swap( small_vector<T, N, Alloc> &x, small_vector<T, N, Alloc> &y )
+{
+    x.swap( y );
+}
+
+} // namespace ft
+
+#endif // SMALL_VECTOR_HPP
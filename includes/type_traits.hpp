@@ -4,6 +4,7 @@
 #ifndef TYPE_TRAITS_HPP
 #define TYPE_TRAITS_HPP
 
+#include "config.hpp"
 #include <cstddef>
 
 struct true_type
@@ -14,6 +15,34 @@ struct false_type
 {
 };
 
+#if defined( __clang__ ) && defined( __has_feature )
+#if __has_feature( is_trivially_copyable )
+#define FT_IS_TRIVIALLY_COPYABLE( T ) __is_trivially_copyable( T )
+#endif
+#if __has_feature( is_trivially_destructible )
+#define FT_IS_TRIVIALLY_DESTRUCTIBLE( T ) __is_trivially_destructible( T )
+#endif
+#elif defined( __GNUC__ ) || defined( _MSC_VER )
+#if defined( _MSC_VER ) || __GNUC__ >= 5
+#define FT_IS_TRIVIALLY_COPYABLE( T ) __is_trivially_copyable( T )
+#else
+#define FT_IS_TRIVIALLY_COPYABLE( T )                                          \
+    ( __has_trivial_copy( T ) && __has_trivial_assign( T )                     \
+      && __has_trivial_destructor( T ) )
+#endif
+#define FT_IS_TRIVIALLY_DESTRUCTIBLE( T ) __has_trivial_destructor( T )
+#endif
+
+#ifndef FT_IS_TRIVIALLY_COPYABLE
+#define FT_IS_TRIVIALLY_COPYABLE( T )                                          \
+    ( ft::is_integral<T>::value || ft::is_floating_point<T>::value             \
+      || ft::is_pointer<T>::value )
+#endif
+
+#ifndef FT_IS_TRIVIALLY_DESTRUCTIBLE
+#define FT_IS_TRIVIALLY_DESTRUCTIBLE( T ) FT_IS_TRIVIALLY_COPYABLE( T )
+#endif
+
 namespace ft {
 
 template < typename T >
@@ -149,15 +178,15 @@ struct is_floating_point<float>
 template <>
 struct is_floating_point<double>
 {
-    enum { value = false };
-    typedef false_type type;
+    enum { value = true };
+    typedef true_type type;
 };
 
 template <>
 struct is_floating_point<long double>
 {
-    enum { value = false };
-    typedef false_type type;
+    enum { value = true };
+    typedef true_type type;
 };
 
 template < typename T >
@@ -216,6 +245,101 @@ struct is_volatile<volatile T>
     typedef true_type type;
 };
 
+/**
+ * @brief The alignment of T, found as the padding a char forces before a T in
+ * a struct.
+ */
+template < typename T >
+struct alignment_of
+{
+    struct _probe
+    {
+        char c;
+        T    t;
+    };
+    enum { value = sizeof( _probe ) - sizeof( T ) };
+};
+
+template < bool B >
+struct bool_constant
+{
+    enum { value = true };
+    typedef true_type type;
+};
+
+template <>
+struct bool_constant<false>
+{
+    enum { value = false };
+    typedef false_type type;
+};
+
+template < typename T, typename U >
+struct is_same
+{
+    enum { value = false };
+    typedef false_type type;
+};
+
+template < typename T >
+struct is_same<T, T>
+{
+    enum { value = true };
+    typedef true_type type;
+};
+
+/**
+ * @brief Whether T can be copied with memcpy, i.e. it has trivial copy
+ * operations and a trivial destructor. Uses the compiler builtins when they
+ * are available and falls back to scalar types otherwise.
+ */
+template < typename T >
+struct is_trivially_copyable
+    : bool_constant< FT_IS_TRIVIALLY_COPYABLE( T ) > {};
+
+/**
+ * @brief Whether destroying a T is a no-op, so destructor loops can be
+ * skipped.
+ */
+template < typename T >
+struct is_trivially_destructible
+    : bool_constant< FT_IS_TRIVIALLY_DESTRUCTIBLE( T ) > {};
+
+/**
+ * @brief Whether a T can be moved to another address with memcpy, leaving
+ * nothing to destroy at the old one. True for trivially copyable types,
+ * specialize it for types that do not point into themselves.
+ */
+template < typename T >
+struct is_trivially_relocatable : is_trivially_copyable<T> {};
+
+/**
+ * @brief Opt-in trait for types that are cheap to default-construct and have
+ * a swap that does not throw, like strings and containers. Without C++11 the
+ * containers relocate such elements by swapping them with default-constructed
+ * ones instead of copying their contents. Specialize it for your own types:
+ * `template <> struct is_swap_relocatable<T> : bool_constant<true> {};`
+ */
+template < typename T >
+struct is_swap_relocatable : bool_constant<false> {};
+
+/**
+ * @brief Whether the library moves a T by swapping it. Only done in C++98
+ * builds, C++11 moves elements directly.
+ */
+template < typename T >
+struct _moves_by_swap
+    : bool_constant< !FT_CXX11 && is_swap_relocatable<T>::value
+                     && !FT_IS_TRIVIALLY_COPYABLE( T ) > {};
+
+// Maps any well-formed type to void, to detect member typedefs in
+// partial specializations
+template < typename T >
+struct _void_type
+{
+    typedef void type;
+};
+
 template < bool B, typename T = void >
 struct enable_if
 {
@@ -8,6 +8,13 @@
 
 namespace ft {
 
+/**
+ * @brief Selects the pair constructor that initializes second with what a
+ * factory returns. The value is then built in place rather than copied from a
+ * temporary, e.g. right in the node of a map.
+ */
+struct from_factory_t {};
+
 template < typename T1, typename T2 >
 struct pair
 {
@@ -17,11 +24,13 @@ struct pair
     pair() : first(), second() {};
     pair( const T1 &x, const T2 &y ) : first( x ), second( y ) {};
 
+    template < typename Factory >
+    pair( const T1 &x, const Factory &make, from_factory_t ) :
+        first( x ), second( make() ) {};
+
     template < typename U, typename V >
     pair( const pair<U, V> &p ) : first( p.first ), second( p.second ) {};
 
-    ~pair() {};
-
     pair &operator=( const pair &p )
     {
         if ( this != &p ) {
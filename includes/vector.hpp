@@ -5,7 +5,9 @@
 #define VECTOR_HPP
 
 #include "algorithm.hpp"
+#include "config.hpp"
 #include "iterator.hpp"
+#include "memory.hpp"
 #include "type_traits.hpp"
 #include <cstring>
 #include <iostream>
@@ -14,6 +16,45 @@
 
 namespace ft {
 
+/**
+ * @brief Geometric growth: the capacity is multiplied by Num / Den every time
+ * the container runs out of room, which keeps repeated appends amortized O(1).
+ *
+ * @tparam Num The numerator of the growth factor.
+ * @tparam Den The denominator of the growth factor.
+ */
+template < size_t Num, size_t Den = 1 >
+struct geometric_growth
+{
+    /**
+     * @brief Computes the capacity to allocate when growing.
+     *
+     * @param capacity The current capacity.
+     * @param required The minimum capacity needed by the operation.
+     * @param max The maximum capacity the allocator can provide.
+     * @return size_t The new capacity, never less than required.
+     */
+    static size_t next_capacity( size_t capacity, size_t required, size_t max )
+    {
+        size_t grown = max;
+        if ( capacity <= max / Num )
+            grown = capacity * Num / Den;
+        if ( grown < required )
+            grown = required;
+        return grown < max ? grown : max;
+    };
+};
+
+/**
+ * @brief Growth policy hook of vector. Specialize it for an element type to
+ * change the growth factor of every vector holding that type, e.g.
+ * `template <> struct vector_growth_policy<T> : geometric_growth<3, 2> {};`
+ *
+ * @tparam T The type of the elements contained in the vector.
+ */
+template < typename T >
+struct vector_growth_policy : geometric_growth<2> {};
+
 template < typename T, typename Alloc = std::allocator<T> >
 class vector {
 public:
@@ -31,6 +72,10 @@ public:
     typedef ft::reverse_iterator<const_iterator>      const_reverse_iterator;
 
 protected:
+    typedef bool_constant< ft::is_trivially_relocatable<T>::value
+                           && ft::allocator_can_reallocate<Alloc>::value >
+        _reallocates_in_place;
+
     allocator_type _alloc;
     pointer        _data;
     size_type      _size;
@@ -53,10 +98,8 @@ public:
         if ( _data == NULL ) {
             throw std::bad_alloc();
         }
-        for ( size_t i = 0; i < _capacity; i++ ) {
-            _alloc.construct( _data + i, val );
-            _size++;
-        }
+        ft::uninitialized_fill_n( _alloc, _data, n, val );
+        _size = n;
     };
 
     template <typename Iterator>
@@ -73,34 +116,50 @@ public:
     template < typename Integer >
     void _handle_integral_type( Integer n, Integer val, true_type )
     {
-
-        _capacity = n;
-        _data     = _alloc.allocate( _capacity );
-        if ( _data == NULL )
-            throw std::bad_alloc();
-        for ( size_type i = 0; i < _capacity; i++ )
-            _alloc.construct( _data + i, val );
-        _size++;
+        reserve( n );
+        ft::uninitialized_fill_n( _alloc, _data, n, val );
+        _size = n;
     };
 
     template < typename Iterator >
     void _handle_integral_type( Iterator first, Iterator last, false_type )
     {
-        size_type n = ft::distance( first, last );
-        _capacity   = n;
-        _data       = _alloc.allocate( _capacity );
-        if ( _data == NULL )
-            throw std::bad_alloc();
-        for ( size_type i = 0; i < _capacity; i++ )
-            _alloc.construct( _data + i, *first++ );
-        _size++;
+        typename iterator_traits<Iterator>::iterator_category category;
+        try {
+            _range_initialize( first, last, category );
+        } catch ( ... ) {
+            clear();
+            _alloc.deallocate( _data, _capacity );
+            throw;
+        }
     };
 
     vector( const vector &x ) :
         _alloc( x.get_allocator() ), _data( NULL ), _size( 0 ), _capacity( 0 )
     {
-        *this = x;
+        _data = _alloc.allocate( x._size );
+        if ( _data == NULL )
+            throw std::bad_alloc();
+        _capacity = x._size;
+        ft::uninitialized_copy_n( _alloc, x._data, x._size, _data );
+        _size = x._size;
+    };
+
+#if FT_CXX11
+    /**
+     * @brief Steals the storage of x, which is left empty.
+     *
+     * @param x Another vector object of the same type.
+     */
+    vector( vector &&x ) noexcept :
+        _alloc( std::move( x._alloc ) ),
+        _data( x._data ), _size( x._size ), _capacity( x._capacity )
+    {
+        x._data     = NULL;
+        x._size     = 0;
+        x._capacity = 0;
     };
+#endif
 
     ~vector()
     {
@@ -108,30 +167,67 @@ public:
         _alloc.deallocate( _data, _capacity );
     };
 
+    /**
+     * @brief Copies the contents of x, reusing the current storage when it is
+     * large enough.
+     *
+     * @param x Another vector object of the same type.
+     * @return vector& A reference to this vector.
+     */
     vector &operator=( const vector &x )
     {
         if ( this == &x )
             return *this;
-        for ( size_type i = 0; i < _size; i++ )
-            _alloc.destroy( _data + i );
-        _alloc.deallocate( _data, _capacity );
-        _alloc    = x.get_allocator();
-        _size     = x.size();
-        _capacity = x.capacity();
-        _data     = _alloc.allocate( _capacity );
-        if ( _data == NULL )
-            throw std::bad_alloc();
-        for ( size_type i = 0; i < _size; i++ )
-            _alloc.construct( _data + i, x._data[i] );
+        if ( x._size > _capacity ) {
+            clear();
+            _alloc.deallocate( _data, _capacity );
+            _data     = NULL;
+            _capacity = 0;
+            _alloc    = x.get_allocator();
+            _data     = _alloc.allocate( x._size );
+            if ( _data == NULL )
+                throw std::bad_alloc();
+            _capacity = x._size;
+            ft::uninitialized_copy_n( _alloc, x._data, x._size, _data );
+        } else if ( x._size <= _size ) {
+            ft::copy( x._data, x._data + x._size, _data );
+            ft::destroy_n( _alloc, _data + x._size, _size - x._size );
+        } else {
+            ft::copy( x._data, x._data + _size, _data );
+            ft::uninitialized_copy_n(
+                _alloc, x._data + _size, x._size - _size, _data + _size );
+        }
+        _size = x._size;
+        return *this;
+    };
+
+#if FT_CXX11
+    /**
+     * @brief Takes over the storage of x and releases the current one.
+     *
+     * @param x Another vector object of the same type, left empty.
+     * @return vector& A reference to this vector.
+     */
+    vector &operator=( vector &&x ) noexcept
+    {
+        vector tmp( std::move( x ) );
+        swap( tmp );
         return *this;
     };
+#endif
 
     // Iterators
-    iterator       begin() { return iterator( _data ); };
-    const_iterator begin() const { return const_iterator( _data ); };
+    iterator       begin() { return iterator( _data, _data, _data + _size ); };
+    const_iterator begin() const
+    {
+        return const_iterator( _data, _data, _data + _size );
+    };
 
-    iterator       end() { return iterator( _data + _size ); };
-    const_iterator end() const { return const_iterator( _data + _size ); };
+    iterator end() { return iterator( _data + _size, _data, _data + _size ); };
+    const_iterator end() const
+    {
+        return const_iterator( _data + _size, _data, _data + _size );
+    };
 
     reverse_iterator       rbegin() { return reverse_iterator( end() ); };
     const_reverse_iterator rbegin() const
@@ -165,12 +261,10 @@ public:
     {
         if ( n > _size ) {
             if ( n > _capacity )
-                reserve( n );
-            for ( size_type i = _size; i < n; i++ )
-                _alloc.construct( _data + i, val );
+                reserve( _recommend( n ) );
+            ft::uninitialized_fill_n( _alloc, _data + _size, n - _size, val );
         } else {
-            for ( size_type i = n; i < _size; i++ )
-                _alloc.destroy( _data + i );
+            ft::destroy_n( _alloc, _data + n, _size - n );
         }
         _size = n;
     };
@@ -187,16 +281,9 @@ public:
     void reserve( size_type n )
     {
         if ( n > _capacity ) {
-            pointer tmp = _alloc.allocate( n );
-            if ( tmp == NULL )
-                throw std::bad_alloc();
-            for ( size_type i = 0; i < _size; i++ )
-                _alloc.construct( tmp + i, _data[i] );
-            for ( size_type i = 0; i < _size; i++ )
-                _alloc.destroy( _data + i );
-            _alloc.deallocate( _data, _capacity );
-            _data     = tmp;
-            _capacity = n;
+            if ( n > max_size() )
+                throw std::length_error( "vector::reserve" );
+            _reallocate( n );
         }
     };
 
@@ -208,22 +295,29 @@ public:
     void shrink_to_fit()
     {
         if ( _size < _capacity ) {
-            pointer tmp = _alloc.allocate( _size );
-            if ( tmp == NULL )
-                throw std::bad_alloc();
-            for ( size_type i = 0; i < _size; i++ )
-                _alloc.construct( tmp + i, _data[i] );
-            for ( size_type i = 0; i < _size; i++ )
-                _alloc.destroy( _data + i );
-            _alloc.deallocate( _data, _capacity );
-            _data     = tmp;
-            _capacity = _size;
+            _reallocate( _size );
         }
     };
 
     // Element access
-    reference       operator[]( size_type n ) { return at( n ); };
-    const_reference operator[]( size_type n ) const { return at( n ); };
+    /**
+     * @brief Fetches the element at position n without bounds checking, use
+     * at() for a checked access. Checked by an assertion in
+     * FT_CONTAINERS_DEBUG builds.
+     *
+     * @param n The position of the element to fetch.
+     * @return reference A reference to the element at position n.
+     */
+    reference operator[]( size_type n )
+    {
+        FT_ASSERT( n < _size, "vector::operator[] index out of range" );
+        return _data[n];
+    };
+    const_reference operator[]( size_type n ) const
+    {
+        FT_ASSERT( n < _size, "vector::operator[] index out of range" );
+        return _data[n];
+    };
 
     /**
      * @brief Fetches the element at position n in the vector.
@@ -244,11 +338,27 @@ public:
         return _data[n];
     };
 
-    reference       front() { return _data[0]; };
-    const_reference front() const { return _data[0]; };
+    reference front()
+    {
+        FT_ASSERT( _size > 0, "vector::front on an empty vector" );
+        return _data[0];
+    };
+    const_reference front() const
+    {
+        FT_ASSERT( _size > 0, "vector::front on an empty vector" );
+        return _data[0];
+    };
 
-    reference       back() { return _data[_size - 1]; };
-    const_reference back() const { return _data[_size - 1]; };
+    reference back()
+    {
+        FT_ASSERT( _size > 0, "vector::back on an empty vector" );
+        return _data[_size - 1];
+    };
+    const_reference back() const
+    {
+        FT_ASSERT( _size > 0, "vector::back on an empty vector" );
+        return _data[_size - 1];
+    };
 
     pointer       data() { return _data; };
     const_pointer data() const { return _data; };
@@ -269,18 +379,60 @@ public:
     };
 
     /**
-     * @brief Pushes a new element at the end of the vector.
+     * @brief Pushes a new element at the end of the vector. When the vector
+     * is full it goes through insert, so val may be an element of the vector.
      *
      * @param val The value to be copied (or moved) to the new element.
      */
     void push_back( const value_type &val )
     {
-        if ( _size == _capacity )
-            reserve( _capacity + 1 );
+        if ( _size == _capacity ) {
+            insert( end(), val );
+            return;
+        }
         _alloc.construct( _data + _size, val );
         _size++;
     };
 
+#if FT_CXX11
+    void push_back( value_type &&val ) { emplace_back( std::move( val ) ); };
+
+    /**
+     * @brief Constructs a new element in place at the end of the vector.
+     * When the vector is full the element is built in the new buffer before
+     * the old elements are relocated, so args may refer to an element of the
+     * vector itself.
+     *
+     * @param args The arguments forwarded to the constructor of the element.
+     * @return reference A reference to the new element.
+     */
+    template < typename... Args >
+    reference emplace_back( Args &&...args )
+    {
+        if ( _size < _capacity ) {
+            ft::construct(
+                _alloc, _data + _size, std::forward<Args>( args )... );
+            return _data[_size++];
+        }
+        if ( !_needs_new_buffer( 1 ) ) {
+            value_type tmp( std::forward<Args>( args )... );
+            reserve( _recommend( _size + 1 ) );
+            ft::construct( _alloc, _data + _size, std::move( tmp ) );
+            return _data[_size++];
+        }
+        size_type cap = _recommend( _size + 1 );
+        pointer   buf = _allocate( cap );
+        try {
+            ft::construct( _alloc, buf + _size, std::forward<Args>( args )... );
+        } catch ( ... ) {
+            _alloc.deallocate( buf, cap );
+            throw;
+        }
+        _relocate_around( buf, cap, _size, 1 );
+        return back();
+    };
+#endif
+
     /**
      * @brief Removes the last element in the vector, effectively reducing the
      * container size by one.
@@ -306,15 +458,73 @@ public:
     {
         size_type pos = position - begin();
 
+        if ( _needs_new_buffer( 1 ) ) {
+            size_type cap = _recommend( _size + 1 );
+            pointer   buf = _allocate( cap );
+            try {
+                _alloc.construct( buf + pos, val );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, 1 );
+            return begin() + pos;
+        }
+        value_type tmp( val );
         if ( _size == _capacity )
-            reserve( _capacity + 1 );
-        for ( size_type i = _size; i > pos; i-- )
-            _alloc.construct( _data + i, _data[i - 1] );
-        _alloc.construct( _data + pos, val );
+            reserve( _recommend( _size + 1 ) );
+        _shift_right( pos, 1 );
+        _fill( pos, 1, tmp );
         _size++;
         return begin() + pos;
     };
 
+#if FT_CXX11
+    iterator insert( iterator position, value_type &&val )
+    {
+        return emplace( position, std::move( val ) );
+    };
+
+    /**
+     * @brief Constructs a new element in place before position.
+     *
+     * @param position Iterator to the element before which the new element
+     * will be constructed. position may be the end() iterator.
+     * @param args The arguments forwarded to the constructor of the element.
+     * @return Iterator pointing to the new element.
+     */
+    template < typename... Args >
+    iterator emplace( iterator position, Args &&...args )
+    {
+        size_type pos = position - begin();
+
+        if ( _needs_new_buffer( 1 ) ) {
+            size_type cap = _recommend( _size + 1 );
+            pointer   buf = _allocate( cap );
+            try {
+                ft::construct(
+                    _alloc, buf + pos, std::forward<Args>( args )... );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, 1 );
+            return begin() + pos;
+        }
+        if ( pos == _size ) {
+            emplace_back( std::forward<Args>( args )... );
+            return begin() + pos;
+        }
+        value_type tmp( std::forward<Args>( args )... );
+        if ( _size == _capacity )
+            reserve( _recommend( _size + 1 ) );
+        _shift_right( pos, 1 );
+        _data[pos] = std::move( tmp );
+        _size++;
+        return begin() + pos;
+    };
+#endif
+
     /**
      * @brief Inserts elements at the specified location in the container.
      *
@@ -332,17 +542,32 @@ public:
             return;
         if ( n > max_size() - _size )
             throw std::length_error( "vector::insert" );
+        size_type pos = position - begin();
+        if ( _needs_new_buffer( n ) ) {
+            size_type cap = _recommend( _size + n );
+            pointer   buf = _allocate( cap );
+            try {
+                ft::uninitialized_fill_n( _alloc, buf + pos, n, val );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, n );
+            return;
+        }
+        value_type tmp( val );
         if ( _size + n > _capacity )
-            reserve( _size + n );
-        for ( size_type i = _capacity; i > _size; i-- )
-            _alloc.construct( _data + i - 1, _data[i - n - 1] );
-        for ( size_type i = 0; i < n; i++ )
-            _alloc.construct( _data + i, val );
+            reserve( _recommend( _size + n ) );
+        _shift_right( pos, n );
+        _fill( pos, n, tmp );
         _size += n;
     };
 
     /**
-     * @brief Template version of insert
+     * @brief Inserts copies of the elements of [first, last) before position.
+     * Forward ranges are measured first and copied with at most one
+     * reallocation, input ranges are appended in a single pass and rotated
+     * into place.
      *
      * @tparam Iterator The type of the iterator
      * @param position The position to insert the elements
@@ -352,21 +577,8 @@ public:
     template <typename Iterator>
     void insert( iterator position, Iterator first, Iterator last )
     {
-        if ( position < begin() || position > end() )
-            throw std::out_of_range( "vector::insert" );
-        size_type n = last - first;
-        if ( n == 0 )
-            return;
-        if ( n > ( max_size() - _size ) )
-            throw std::length_error( "vector::insert" );
-        if ( _size + n > _capacity )
-            reserve( _size + n );
-        size_type pos = position - begin();
-        for ( size_type i = _size; i > pos; i-- )
-            _alloc.construct( _data + i + n - 1, _data[i - 1] );
-        for ( size_type i = 0; i < n; i++ )
-            _alloc.construct( _data + pos + i, first[i] );
-        _size += n;
+        typename ft::is_integral<Iterator>::type is_integral;
+        _insert_dispatch( position, first, last, is_integral );
     };
 
     /**
@@ -382,9 +594,8 @@ public:
         if ( position < begin() || position >= end() )
             throw std::out_of_range( "vector::erase" );
         size_type pos = position - begin();
-        _alloc.destroy( _data + pos );
-        for ( size_type i = pos; i < _size - 1; i++ )
-            _alloc.construct( _data + i, _data[i + 1] );
+        ft::move( _data + pos + 1, _data + _size, _data + pos );
+        _alloc.destroy( _data + _size - 1 );
         _size--;
         return begin() + pos;
     };
@@ -408,10 +619,8 @@ public:
             return first;
         size_type pos = first - begin();
         size_type n   = last - first;
-        for ( size_type i = pos; i < _size - n; i++ )
-            _alloc.construct( _data + i, _data[i + n] );
-        for ( size_type i = _size - n; i < _size; i++ )
-            _alloc.destroy( _data + i );
+        ft::move( _data + pos + n, _data + _size, _data + pos );
+        ft::destroy_n( _alloc, _data + _size - n, n );
         _size -= n;
         return begin() + pos;
     };
@@ -447,13 +656,270 @@ public:
      */
     void clear()
     {
-        for ( size_type i = 0; i < _size; i++ )
-            _alloc.destroy( _data + i );
+        ft::destroy_n( _alloc, _data, _size );
         _size = 0;
     };
 
     // Allocator accessor
     allocator_type get_allocator() const { return _alloc; };
+
+protected:
+    template < typename InputIt >
+    void _range_initialize( InputIt first, InputIt last, input_iterator_tag )
+    {
+        for ( ; first != last; ++first )
+            push_back( *first );
+    };
+
+    template < typename ForwardIt >
+    void
+    _range_initialize( ForwardIt first, ForwardIt last, forward_iterator_tag )
+    {
+        reserve( ft::distance( first, last ) );
+        pointer built = ft::uninitialized_copy(
+            _alloc, ft::_unwrap( first ), ft::_unwrap( last ), _data );
+        _size = built - _data;
+    };
+
+    template < typename Integer >
+    void
+    _insert_dispatch( iterator position, Integer n, Integer val, true_type )
+    {
+        insert( position, static_cast<size_type>( n ), val );
+    };
+
+    template < typename Iterator >
+    void _insert_dispatch( iterator position,
+                           Iterator first,
+                           Iterator last,
+                           false_type )
+    {
+        if ( position < begin() || position > end() )
+            throw std::out_of_range( "vector::insert" );
+        typename iterator_traits<Iterator>::iterator_category category;
+        _range_insert( position - begin(), first, last, category );
+    };
+
+    template < typename InputIt >
+    void _range_insert( size_type pos,
+                        InputIt   first,
+                        InputIt   last,
+                        input_iterator_tag )
+    {
+        size_type old_size = _size;
+        for ( ; first != last; ++first )
+            push_back( *first );
+        ft::rotate( _data + pos, _data + old_size, _data + _size );
+    };
+
+    template < typename ForwardIt >
+    void _range_insert( size_type pos,
+                        ForwardIt first,
+                        ForwardIt last,
+                        forward_iterator_tag )
+    {
+        size_type n = ft::distance( first, last );
+        if ( n == 0 )
+            return;
+        if ( n > ( max_size() - _size ) )
+            throw std::length_error( "vector::insert" );
+        if ( _needs_new_buffer( n ) ) {
+            size_type cap = _recommend( _size + n );
+            pointer   buf = _allocate( cap );
+            try {
+                ft::uninitialized_copy( _alloc,
+                                        ft::_unwrap( first ),
+                                        ft::_unwrap( last ),
+                                        buf + pos );
+            } catch ( ... ) {
+                _alloc.deallocate( buf, cap );
+                throw;
+            }
+            _relocate_around( buf, cap, pos, n );
+            return;
+        }
+        if ( _size + n > _capacity )
+            reserve( _recommend( _size + n ) );
+        _shift_right( pos, n );
+        _copy_into_gap( pos, n, ft::_unwrap( first ), ft::_unwrap( last ) );
+        _size += n;
+    };
+
+    /**
+     * @brief Fills the gap opened by _shift_right with copies of the n
+     * elements of [first, last): assigned over the live slots, constructed in
+     * the others.
+     */
+    template < typename ForwardIt >
+    void _copy_into_gap( size_type pos,
+                         size_type n,
+                         ForwardIt first,
+                         ForwardIt last )
+    {
+        size_type live = _size - pos < n ? _size - pos : n;
+        ForwardIt mid  = first;
+        ft::advance( mid, live );
+        ft::copy( first, mid, _data + pos );
+        ft::uninitialized_copy( _alloc, mid, last, _data + pos + live );
+    };
+
+    /**
+     * @brief Computes the capacity to grow to so that at least n elements fit,
+     * following the growth policy of the element type.
+     *
+     * @param n The number of elements the container must be able to hold.
+     * @return size_type The capacity to reserve.
+     */
+    size_type _recommend( size_type n ) const
+    {
+        if ( n > max_size() )
+            throw std::length_error( "vector::reserve" );
+        return vector_growth_policy<value_type>::next_capacity(
+            _capacity, n, max_size() );
+    };
+
+    pointer _allocate( size_type n )
+    {
+        pointer p = _alloc.allocate( n );
+        if ( p == NULL )
+            throw std::bad_alloc();
+        return p;
+    };
+
+    /**
+     * @brief Whether inserting n elements needs a new buffer, which inserts
+     * then build directly. Buffers that the allocator resizes in place keep
+     * going through reserve.
+     */
+    bool _needs_new_buffer( size_type n ) const
+    {
+        return _size + n > _capacity && !_reallocates_in_place::value;
+    };
+
+    /**
+     * @brief Completes an insert into a new buffer: the n new elements are
+     * already constructed at buf + pos, the elements before pos are relocated
+     * in front of them and the others after them, so each element moves once.
+     * The strong guarantee holds when inserting at the end, otherwise a
+     * failure to relocate the prefix loses the suffix.
+     *
+     * @param buf The new buffer.
+     * @param cap The capacity of buf.
+     * @param pos The index of the new elements.
+     * @param n The number of new elements.
+     */
+    void
+    _relocate_around( pointer buf, size_type cap, size_type pos, size_type n )
+    {
+        size_type tail = _size - pos;
+        try {
+            ft::uninitialized_relocate_n(
+                _alloc, _data + pos, tail, buf + pos + n );
+        } catch ( ... ) {
+            ft::destroy_n( _alloc, buf + pos, n );
+            _alloc.deallocate( buf, cap );
+            throw;
+        }
+        try {
+            ft::uninitialized_relocate_n( _alloc, _data, pos, buf );
+        } catch ( ... ) {
+            ft::destroy_n( _alloc, buf + pos, n + tail );
+            _alloc.deallocate( buf, cap );
+            _size = pos;
+            throw;
+        }
+        _alloc.deallocate( _data, _capacity );
+        _data     = buf;
+        _capacity = cap;
+        _size += n;
+    };
+
+    /**
+     * @brief Moves the elements to a new buffer of n elements. Trivially
+     * relocatable elements are resized in place by allocators providing the
+     * reallocate extension, see allocator_can_reallocate.
+     *
+     * @param n The capacity of the new buffer, at least the current size.
+     */
+    void _reallocate( size_type n )
+    {
+        typename _reallocates_in_place::type in_place;
+        if ( _data != NULL )
+            _reallocate( n, in_place );
+        else
+            _reallocate( n, false_type() );
+    };
+
+    void _reallocate( size_type n, true_type )
+    {
+        _data     = _alloc.reallocate( _data, _capacity, n );
+        _capacity = n;
+    };
+
+    void _reallocate( size_type n, false_type )
+    {
+        pointer tmp = _alloc.allocate( n );
+        if ( tmp == NULL )
+            throw std::bad_alloc();
+        try {
+            ft::uninitialized_relocate_n( _alloc, _data, _size, tmp );
+        } catch ( ... ) {
+            _alloc.deallocate( tmp, n );
+            throw;
+        }
+        _alloc.deallocate( _data, _capacity );
+        _data     = tmp;
+        _capacity = n;
+    };
+
+    /**
+     * @brief Opens a gap of n elements at pos by shifting the tail to the
+     * right. The capacity must already hold size() + n elements. Slots of the
+     * gap below size() keep a live element, the others are uninitialized.
+     *
+     * @param pos The index of the first element of the gap.
+     * @param n The size of the gap.
+     */
+    void _shift_right( size_type pos, size_type n )
+    {
+        typename ft::is_trivially_copyable<value_type>::type is_trivial;
+        _shift_right( pos, n, is_trivial );
+    };
+
+    void _shift_right( size_type pos, size_type n, true_type )
+    {
+        ft::copy_backward( _data + pos, _data + _size, _data + _size + n );
+    };
+
+    void _shift_right( size_type pos, size_type n, false_type )
+    {
+        size_type tail = _size - pos;
+        if ( n >= tail ) {
+            ft::uninitialized_move_n(
+                _alloc, _data + pos, tail, _data + pos + n );
+        } else {
+            ft::uninitialized_move_n(
+                _alloc, _data + _size - n, n, _data + _size );
+            ft::move_backward( _data + pos, _data + _size - n, _data + _size );
+        }
+    };
+
+    /**
+     * @brief Fills the gap opened by _shift_right with copies of val.
+     *
+     * @param pos The index of the first element of the gap.
+     * @param n The size of the gap.
+     * @param val The value to copy.
+     */
+    void _fill( size_type pos, size_type n, const value_type &val )
+    {
+        for ( size_type i = pos; i < pos + n; i++ ) {
+            if ( i < _size )
+                _data[i] = val;
+            else
+                _alloc.construct( _data + i, val );
+        }
+    };
 };
 
 template < typename T, typename Alloc >
@@ -461,7 +927,7 @@ inline bool operator==( const vector<T, Alloc> &lhs,
                         const vector<T, Alloc> &rhs )
 {
     return ( lhs.size() == rhs.size()
-             && ft::equal( lhs.begin(), lhs.end(), rhs.begin() ) );
+             && ft::equal( lhs.data(), lhs.data() + lhs.size(), rhs.data() ) );
 }
 
 template < typename T, typename Alloc >
@@ -475,8 +941,10 @@ template < typename T, typename Alloc >
 inline bool operator<( const vector<T, Alloc> &lhs,
                        const vector<T, Alloc> &rhs )
 {
-    return ( ft::lexicographical_compare(
-        lhs.begin(), lhs.end(), rhs.begin(), rhs.end() ) );
+    return ( ft::lexicographical_compare( lhs.data(),
+                                          lhs.data() + lhs.size(),
+                                          rhs.data(),
+                                          rhs.data() + rhs.size() ) );
 }
 
 template < typename T, typename Alloc >
@@ -506,6 +974,9 @@ inline void swap( vector<T, Alloc> &x, vector<T, Alloc> &y )
     x.swap( y );
 }
 
+template < typename T, typename Alloc >
+struct is_swap_relocatable< vector<T, Alloc> > : bool_constant<true> {};
+
 } // namespace ft
 
 #endif // VECTOR_HPP
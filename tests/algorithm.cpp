@@ -3,10 +3,14 @@
  */
 #include "algorithm.hpp"
 #include "minunit.h"
+#include <algorithm>
 #include <functional>
 #include <iostream>
+#include <limits>
 #include <string>
 
+#define TEST_RANGE_SIZE 130
+
 bool is_palindrome( const std::string &s )
 {
     return ft::equal( s.begin(), s.begin() + s.size() / 2, s.rbegin() );
@@ -55,6 +59,84 @@ MU_TEST( test_algorithm_is_not_lexicographical_compare )
                "world is not lexicographically less than hello" );
 }
 
+// Checks the pointer versions against std for a difference at every index
+template < typename T >
+bool matches_std_on_each_difference()
+{
+    T  lhs[TEST_RANGE_SIZE];
+    T  rhs[TEST_RANGE_SIZE];
+    T *lend = lhs + TEST_RANGE_SIZE;
+    T *rend = rhs + TEST_RANGE_SIZE;
+    for ( int i = 0; i < TEST_RANGE_SIZE; i++ )
+        lhs[i] = rhs[i] = static_cast<T>( i % 50 - 20 );
+    for ( int n = 0; n < TEST_RANGE_SIZE; n++ ) {
+        if ( !ft::equal( lhs, lhs + n, rhs )
+             || ft::lexicographical_compare( lhs, lhs + n, rhs, rhs + n )
+             || !ft::lexicographical_compare( lhs, lhs + n, rhs, rhs + n + 1 ) )
+            return false;
+    }
+    for ( int i = 0; i < TEST_RANGE_SIZE; i++ ) {
+        T saved = rhs[i];
+        rhs[i]  = static_cast<T>( i % 2 ? saved + 1 : saved - 1 );
+        if ( ft::equal( lhs, lend, rhs )
+             || ft::lexicographical_compare( lhs, lend, rhs, rend )
+                    != std::lexicographical_compare( lhs, lend, rhs, rend ) )
+            return false;
+        rhs[i] = saved;
+    }
+    return true;
+}
+
+MU_TEST( test_algorithm_pointer_ranges )
+{
+    mu_check( matches_std_on_each_difference<char>() );
+    mu_check( matches_std_on_each_difference<short>() );
+    mu_check( matches_std_on_each_difference<int>() );
+    mu_check( matches_std_on_each_difference<long long>() );
+    mu_check( matches_std_on_each_difference<float>() );
+    mu_check( matches_std_on_each_difference<double>() );
+    mu_check( matches_std_on_each_difference<long double>() );
+}
+
+MU_TEST( test_algorithm_floating_point_semantics )
+{
+    double nan       = std::numeric_limits<double>::quiet_NaN();
+    double lhs[9]    = { 0.0, 1, 2, 3, 4, 5, 6, nan, 1 };
+    double rhs[9]    = { -0.0, 1, 2, 3, 4, 5, 6, nan, 2 };
+    float  flhs[9]   = { 0.0f, 1, 2, 3, 4, 5, 6, 7, 1 };
+    float  frhs[9]   = { -0.0f, 1, 2, 3, 4, 5, 6, 7, 1 };
+    mu_check( ft::equal( lhs, lhs + 7, rhs ) );
+    mu_check( !ft::equal( lhs, lhs + 8, lhs ) );
+    mu_check( ft::lexicographical_compare( lhs, lhs + 9, rhs, rhs + 9 ) );
+    mu_check( !ft::lexicographical_compare( rhs, rhs + 9, lhs, lhs + 9 ) );
+    mu_check( !ft::lexicographical_compare( lhs, lhs + 8, rhs, rhs + 8 ) );
+    mu_check( ft::equal( flhs, flhs + 9, frhs ) );
+    flhs[5] = std::numeric_limits<float>::quiet_NaN();
+    mu_check( !ft::equal( flhs, flhs + 9, frhs ) );
+    mu_check( !ft::lexicographical_compare( flhs, flhs + 9, frhs, frhs + 9 ) );
+}
+
+#if FT_SIMD_X86
+// The dispatch picks AVX2 where it can, the SSE2 kernels are checked directly
+MU_TEST( test_algorithm_sse2_kernels )
+{
+    unsigned char bytes[TEST_RANGE_SIZE] = {};
+    unsigned char other[TEST_RANGE_SIZE] = {};
+    float         floats[TEST_RANGE_SIZE] = {};
+    float         others[TEST_RANGE_SIZE] = {};
+    size_t        n                       = TEST_RANGE_SIZE;
+    for ( size_t i = 0; i < n; i++ ) {
+        other[i]  = 1;
+        others[i] = 1;
+        mu_assert_int_eq( i, ft::_mismatch_bytes_sse2( bytes, other, n ) );
+        mu_assert_int_eq( i, ft::_mismatch_sse2( floats, others, n, true ) );
+        other[i]  = 0;
+        others[i] = 0;
+    }
+    mu_assert_int_eq( n, ft::_mismatch_sse2( floats, others, n, false ) );
+}
+#endif
+
 MU_TEST_SUITE( suite_algorithm )
 {
     MU_RUN_TEST( test_algorithm_is_palindrome );
@@ -63,6 +145,11 @@ MU_TEST_SUITE( suite_algorithm )
     MU_RUN_TEST( test_algorithm_is_not_equal );
     MU_RUN_TEST( test_algorithm_is_lexicographical_compare );
     MU_RUN_TEST( test_algorithm_is_not_lexicographical_compare );
+    MU_RUN_TEST( test_algorithm_pointer_ranges );
+    MU_RUN_TEST( test_algorithm_floating_point_semantics );
+#if FT_SIMD_X86
+    MU_RUN_TEST( test_algorithm_sse2_kernels );
+#endif
 }
 
 int main()
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "aligned_allocator.hpp"
+#include "map.hpp"
+#include "minunit.h"
+#include "vector.hpp"
+
+#define TEST_VECTOR_SIZE 1000
+
+typedef ft::aligned_allocator<float>     float_alloc;
+typedef ft::aligned_allocator<char, 256> page_alloc;
+
+static bool is_aligned( const void *p, size_t align )
+{
+    return reinterpret_cast<size_t>( p ) % align == 0;
+}
+
+MU_TEST( test_aligned_allocator_allocate )
+{
+    mu_check( !ft::allocator_can_reallocate<float_alloc>::value );
+    float_alloc alloc;
+    float      *p = alloc.allocate( 3 );
+    mu_check( is_aligned( p, 64 ) );
+    alloc.deallocate( p, 3 );
+    page_alloc pages;
+    char      *c = pages.allocate( 0 );
+    mu_check( c != NULL && is_aligned( c, 256 ) );
+    pages.deallocate( c, 0 );
+}
+
+MU_TEST( test_aligned_allocator_vector )
+{
+    ft::vector<float, float_alloc> vecFloat;
+    for ( int i = 0; i < TEST_VECTOR_SIZE; i++ ) {
+        vecFloat.push_back( i );
+        mu_check( is_aligned( vecFloat.data(), float_alloc::alignment ) );
+    }
+    mu_assert_double_eq( 999.0, vecFloat.back() );
+    ft::vector<float, float_alloc> vecCopy( vecFloat );
+    mu_check( is_aligned( vecCopy.data(), 64 ) );
+    mu_check( vecCopy == vecFloat );
+}
+
+MU_TEST( test_aligned_allocator_map )
+{
+    typedef ft::aligned_allocator<ft::pair<const int, int> > pair_alloc;
+    ft::map<int, int, std::less<int>, pair_alloc >          mapInt;
+    for ( int i = 0; i < 100; i++ )
+        mapInt[i] = -i;
+    mu_assert_int_eq( 100, mapInt.size() );
+    mu_assert_int_eq( -42, mapInt[42] );
+}
+
+MU_TEST_SUITE( suite_aligned_allocator )
+{
+    MU_RUN_TEST( test_aligned_allocator_allocate );
+    MU_RUN_TEST( test_aligned_allocator_vector );
+    MU_RUN_TEST( test_aligned_allocator_map );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_aligned_allocator );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
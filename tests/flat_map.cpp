@@ -0,0 +1,221 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "flat_map.hpp"
+#include "minunit.h"
+#include <cstdlib>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#define TEST_RANDOM_OPERATIONS 20000
+
+typedef ft::flat_map<int, std::string> table;
+
+MU_TEST( test_flat_map_insert_find )
+{
+    table m;
+    mu_check( m.empty() && m.begin() == m.end() && m.find( 1 ) == m.end() );
+
+    mu_check( m.insert( ft::make_pair( 20, std::string( "b" ) ) ).second );
+    mu_check( m.insert( ft::make_pair( 10, std::string( "a" ) ) ).second );
+    mu_check( !m.insert( ft::make_pair( 10, std::string( "x" ) ) ).second );
+    m.insert( m.end(), ft::make_pair( 30, std::string( "c" ) ) );
+    m.insert( m.begin(), ft::make_pair( 25, std::string( "wrong hint" ) ) );
+    m[5] = "first";
+    mu_assert_int_eq( 5, m.size() );
+    mu_check( m.find( 10 )->second == "a" && m.at( 25 ) == "wrong hint" );
+    mu_check( m.count( 20 ) == 1 && m.count( 21 ) == 0 );
+    mu_check( m.lower_bound( 21 )->first == 25 );
+    mu_check( m.upper_bound( 25 )->first == 30 );
+    mu_check( m.upper_bound( 30 ) == m.end() );
+    mu_check( m.equal_range( 20 ).second - m.equal_range( 20 ).first == 1 );
+    mu_check( m.equal_range( 21 ).first == m.equal_range( 21 ).second );
+
+    // Keys are sorted, values follow them
+    int keys[] = { 5, 10, 20, 25, 30 };
+    int i      = 0;
+    for ( table::const_iterator it = m.begin(); it != m.end(); ++it, ++i ) {
+        mu_assert_int_eq( keys[i], it->first );
+        mu_check( m.values()[i] == ( *it ).second );
+    }
+    mu_check( m.rbegin()->first == 30 );
+    m.rbegin()->second = "last";
+    mu_check( m.at( 30 ) == "last" );
+    const table &c = m;
+    mu_check( c.rbegin()->second == "last" && ( ++c.rbegin() )->first == 25 );
+
+    // Writes through an iterator reach the values
+    m.find( 30 )->second = "changed";
+    mu_check( m.at( 30 ) == "changed" );
+
+    bool thrown = false;
+    try {
+        m.at( 7 );
+    } catch ( const std::out_of_range & ) {
+        thrown = true;
+    }
+    mu_check( thrown );
+}
+
+MU_TEST( test_flat_map_bulk_insert )
+{
+    std::vector<ft::pair<int, int> > rows;
+    for ( int i = 0; i < 1000; i++ )
+        rows.push_back( ft::make_pair( ( i * 7919 ) % 1000, i ) );
+    rows.push_back( ft::make_pair( 3, -1 ) );
+
+    ft::flat_map<int, int> m;
+    m.reserve( 2000 );
+    m[3]              = 42;
+    const int *keys   = m.keys().data();
+    const int *values = m.values().data();
+    m.insert( rows.begin(), rows.end() );
+    // A reserved table is merged into in place
+    mu_check( m.keys().data() == keys && m.values().data() == values );
+    mu_assert_int_eq( 1000, m.size() );
+    mu_assert_int_eq( 2000, m.capacity() );
+    // The elements of the map and the first of equal keys win
+    mu_assert_int_eq( 42, m[3] );
+    mu_assert_int_eq( 1, m[7919 % 1000] );
+    for ( int k = 0; k < 1000; k++ )
+        mu_assert_int_eq( k, m.keys()[k] );
+    m.shrink_to_fit();
+    mu_assert_int_eq( 1000, m.capacity() );
+
+    ft::flat_map<int, int> copy( m.begin(), m.end() );
+    mu_check( copy == m && !( copy < m ) );
+    copy[1000] = 0;
+    mu_check( copy != m && m < copy );
+}
+
+MU_TEST( test_flat_map_erase )
+{
+    ft::flat_map<int, int> m;
+    for ( int i = 0; i < 100; i++ )
+        m.insert( m.end(), ft::make_pair( i, i * i ) );
+    mu_assert_int_eq( 1, m.erase( 50 ) );
+    mu_assert_int_eq( 0, m.erase( 50 ) );
+    m.erase( m.begin() );
+    m.erase( m.lower_bound( 10 ), m.lower_bound( 20 ) );
+    mu_assert_int_eq( 100 - 2 - 10, m.size() );
+    mu_check( m.find( 15 ) == m.end() );
+    mu_assert_int_eq( 400, m.find( 20 )->second );
+    mu_assert_int_eq( 81, ( --m.lower_bound( 10 ) )->second );
+
+    ft::flat_map<int, int> other;
+    other[1] = 1;
+    m.swap( other );
+    mu_assert_int_eq( 1, m.size() );
+    mu_assert_int_eq( 88, other.size() );
+    m.clear();
+    mu_check( m.empty() );
+}
+
+// A value whose copies throw once copies_left runs out, and which swaps by
+// copying, so bulk inserts merge into a copy of the map
+struct fragile
+{
+    static int copies_left;
+    int        v;
+
+    fragile( int x = 0 ) : v( x ) {};
+
+    fragile( const fragile &x ) : v( x.v ) { _count(); };
+
+    fragile &operator=( const fragile &x )
+    {
+        _count();
+        v = x.v;
+        return *this;
+    };
+
+    static void _count()
+    {
+        if ( copies_left-- == 0 )
+            throw std::runtime_error( "fragile copy" );
+    };
+};
+
+int fragile::copies_left = -1;
+
+MU_TEST( test_flat_map_bulk_insert_throws )
+{
+    ft::flat_map<int, fragile> m;
+    for ( int i = 0; i < 100; i += 2 )
+        m.insert( m.end(), ft::make_pair( i, fragile( i ) ) );
+    std::vector<ft::pair<int, fragile> > rows;
+    for ( int i = 1; i < 100; i += 2 )
+        rows.push_back( ft::make_pair( i, fragile( i ) ) );
+
+    bool thrown = false;
+    for ( int limit = 0;; limit += 37 ) {
+        fragile::copies_left = limit;
+        thrown               = false;
+        try {
+            m.insert( rows.begin(), rows.end() );
+        } catch ( const std::runtime_error & ) {
+            thrown = true;
+        }
+        fragile::copies_left = -1;
+        if ( !thrown )
+            break;
+        // The map is left as it was
+        mu_assert_int_eq( 50, m.size() );
+        for ( int i = 0; i < 50; i++ ) {
+            mu_assert_int_eq( i * 2, m.keys()[i] );
+            mu_assert_int_eq( i * 2, m.values()[i].v );
+        }
+    }
+    mu_assert_int_eq( 100, m.size() );
+    for ( int i = 0; i < 100; i++ )
+        mu_assert_int_eq( i, m.values()[i].v );
+}
+
+MU_TEST( test_flat_map_random_operations )
+{
+    ft::flat_map<int, int> m;
+    std::map<int, int>     ref;
+    bool                   same = true;
+    std::srand( 42 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS && same; i++ ) {
+        int key = std::rand() % 1000;
+        int op  = std::rand() % 4;
+        if ( op == 0 ) {
+            same = m.erase( key ) == ref.erase( key );
+        } else if ( op == 1 ) {
+            std::vector<ft::pair<int, int> > batch;
+            for ( int j = 0; j < 8; j++ )
+                batch.push_back( ft::make_pair( std::rand() % 1000, i ) );
+            m.insert( batch.begin(), batch.end() );
+            for ( int j = 0; j < 8; j++ )
+                ref.insert( std::make_pair( batch[j].first, i ) );
+        } else {
+            m[key]   = i;
+            ref[key] = i;
+        }
+        same = same && m.size() == ref.size();
+    }
+    std::map<int, int>::iterator     jt = ref.begin();
+    ft::flat_map<int, int>::iterator it = m.begin();
+    for ( ; same && jt != ref.end(); ++it, ++jt )
+        same = it->first == jt->first && it->second == jt->second;
+    mu_check( same );
+}
+
+MU_TEST_SUITE( suite_flat_map )
+{
+    MU_RUN_TEST( test_flat_map_insert_find );
+    MU_RUN_TEST( test_flat_map_bulk_insert );
+    MU_RUN_TEST( test_flat_map_erase );
+    MU_RUN_TEST( test_flat_map_bulk_insert_throws );
+    MU_RUN_TEST( test_flat_map_random_operations );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_flat_map );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "flat_set.hpp"
+#include "minunit.h"
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <string>
+#include <vector>
+
+#define TEST_RANDOM_OPERATIONS 20000
+
+MU_TEST( test_flat_set_create )
+{
+    ft::flat_set<std::string> s;
+    mu_check( s.insert( "route/b" ).second );
+    mu_check( s.insert( "route/a" ).second );
+    mu_check( !s.insert( "route/a" ).second );
+    s.insert( s.end(), "route/c" );
+    s.insert( s.begin(), "route/0" );
+    mu_assert_int_eq( 4, s.size() );
+    mu_check( *s.begin() == "route/0" && *s.rbegin() == "route/c" );
+    mu_check( s.count( "route/b" ) == 1 && s.count( "route" ) == 0 );
+    mu_check( *s.lower_bound( "route/1" ) == "route/a" );
+    mu_check( s.upper_bound( "route/c" ) == s.end() );
+    mu_check( s.equal_range( "route/a" ).first == s.find( "route/a" ) );
+    mu_check( s.find( "route/d" ) == s.end() );
+
+    mu_assert_int_eq( 1, s.erase( "route/a" ) );
+    mu_assert_int_eq( 0, s.erase( "route/a" ) );
+    s.erase( s.begin() );
+    mu_check( s.size() == 2 && *s.begin() == "route/b" );
+}
+
+MU_TEST( test_flat_set_bulk_insert )
+{
+    std::vector<int> values;
+    for ( int i = 0; i < 1000; i++ )
+        values.push_back( ( i * 7919 ) % 500 );
+    ft::flat_set<int> s( values.begin(), values.end() );
+    mu_assert_int_eq( 500, s.size() );
+    for ( int i = 0; i < 500; i++ )
+        mu_assert_int_eq( i, s.elements()[i] );
+
+    s.reserve( 1500 );
+    std::vector<int> more;
+    for ( int i = 1000; i > 0; i-- )
+        more.push_back( i );
+    const int *data = s.elements().data();
+    s.insert( more.begin(), more.end() );
+    mu_check( s.elements().data() == data );
+    mu_assert_int_eq( 1001, s.size() );
+    mu_assert_int_eq( 1500, s.capacity() );
+    s.erase( s.lower_bound( 100 ), s.end() );
+    mu_assert_int_eq( 100, s.size() );
+
+    ft::flat_set<int> copy( s );
+    mu_check( copy == s && copy <= s );
+    copy.insert( -1 );
+    mu_check( copy != s && copy < s );
+    copy.swap( s );
+    mu_assert_int_eq( 101, s.size() );
+}
+
+MU_TEST( test_flat_set_random_operations )
+{
+    ft::flat_set<int> s;
+    std::set<int>     ref;
+    bool              same = true;
+    std::srand( 42 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS && same; i++ ) {
+        int val = std::rand() % 1000;
+        int op  = std::rand() % 3;
+        if ( op == 0 ) {
+            same = s.erase( val ) == ref.erase( val );
+        } else if ( op == 1 ) {
+            int batch[4] = { val, std::rand() % 1000, val, std::rand() % 1000 };
+            s.insert( batch, batch + 4 );
+            ref.insert( batch, batch + 4 );
+        } else {
+            same = s.insert( val ).second == ref.insert( val ).second;
+        }
+        same = same && s.size() == ref.size();
+    }
+    mu_check( same );
+    mu_check( std::equal( ref.begin(), ref.end(), s.begin() ) );
+}
+
+MU_TEST_SUITE( suite_flat_set )
+{
+    MU_RUN_TEST( test_flat_set_create );
+    MU_RUN_TEST( test_flat_set_bulk_insert );
+    MU_RUN_TEST( test_flat_set_random_operations );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_flat_set );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -102,6 +102,23 @@ MU_TEST( test_iterator_swap )
     mu_check( *it2 == 4 );
 }
 
+MU_TEST( test_iterator_vector_bounds )
+{
+    int                                 a[5] = { 1, 2, 3, 4, 5 };
+    random_access_iterator<int *>       it( a + 1, a, a + 5 );
+    random_access_iterator<int *>       last( a + 5, a, a + 5 );
+    random_access_iterator<const int *> cit( it );
+    mu_check( *it == 2 );
+    mu_check( it[3] == 5 );
+    mu_check( *( it + 3 ) == 5 );
+    mu_check( last - it == 4 );
+    mu_check( last - cit == 4 );
+    mu_check( ( it += 4 ) == last );
+#ifndef FT_CONTAINERS_DEBUG
+    mu_check( sizeof( it ) == sizeof( int * ) );
+#endif
+}
+
 MU_TEST_SUITE( suite_iterator )
 {
     MU_RUN_TEST( test_iterator_create_int_iterator );
@@ -110,6 +127,7 @@ MU_TEST_SUITE( suite_iterator )
     MU_RUN_TEST( test_iterator_iterate_while_true_loop );
     MU_RUN_TEST( test_iterator_access_invalid_index );
     MU_RUN_TEST( test_iterator_swap );
+    MU_RUN_TEST( test_iterator_vector_bounds );
 }
 
 int main()
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "malloc_allocator.hpp"
+#include "minunit.h"
+#include "vector.hpp"
+#include <string>
+
+#define TEST_VECTOR_SIZE 1000
+
+MU_TEST( test_malloc_allocator_can_reallocate )
+{
+    mu_check( ft::allocator_can_reallocate<ft::malloc_allocator<int> >::value );
+    mu_check( !ft::allocator_can_reallocate<std::allocator<int> >::value );
+}
+
+MU_TEST( test_malloc_allocator_reallocate )
+{
+    ft::malloc_allocator<int> alloc;
+    int                      *p = alloc.allocate( 4 );
+    for ( int i = 0; i < 4; i++ )
+        p[i] = i;
+    p = alloc.reallocate( p, 4, 1024 );
+    for ( int i = 0; i < 4; i++ )
+        mu_assert_int_eq( i, p[i] );
+    alloc.deallocate( p, 1024 );
+}
+
+MU_TEST( test_malloc_allocator_vector_growth )
+{
+    ft::vector<long, ft::malloc_allocator<long> > vecLong;
+    for ( long i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecLong.push_back( i );
+    vecLong.insert( vecLong.begin(), -1 );
+    vecLong.shrink_to_fit();
+    mu_assert_int_eq( TEST_VECTOR_SIZE + 1, vecLong.capacity() );
+    for ( long i = 0; i < TEST_VECTOR_SIZE; i++ )
+        mu_assert_int_eq( i, vecLong[i + 1] );
+    vecLong.clear();
+    vecLong.shrink_to_fit();
+    mu_assert_int_eq( 0, vecLong.capacity() );
+}
+
+MU_TEST( test_malloc_allocator_vector_string )
+{
+    ft::vector<std::string, ft::malloc_allocator<std::string> > vecStr;
+    for ( int i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecStr.push_back( std::string( 32, 'a' + i % 26 ) );
+    vecStr.reserve( TEST_VECTOR_SIZE * 2 );
+    mu_assert( vecStr[27] == std::string( 32, 'b' ), "elements are kept" );
+}
+
+MU_TEST_SUITE( suite_malloc_allocator )
+{
+    MU_RUN_TEST( test_malloc_allocator_can_reallocate );
+    MU_RUN_TEST( test_malloc_allocator_reallocate );
+    MU_RUN_TEST( test_malloc_allocator_vector_growth );
+    MU_RUN_TEST( test_malloc_allocator_vector_string );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_malloc_allocator );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
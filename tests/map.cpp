@@ -3,6 +3,46 @@
  */
 #include "map.hpp"
 #include "minunit.h"
+#include <cstdlib>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#define TEST_RANDOM_OPERATIONS 20000
+#define TEST_TREE_SIZE 1023
+#define TEST_TREE_MAX_HEIGHT 20
+
+// Counts the comparisons made by the map it orders
+struct counting_less
+{
+    static size_t calls;
+
+    bool operator()( int lhs, int rhs ) const
+    {
+        calls++;
+        return lhs < rhs;
+    }
+};
+
+size_t counting_less::calls = 0;
+
+// Part of a string, which lookups never convert to std::string
+struct slice
+{
+    const char *data;
+    size_t      size;
+};
+
+static bool operator<( const slice &lhs, const std::string &rhs )
+{
+    return rhs.compare( 0, std::string::npos, lhs.data, lhs.size ) > 0;
+}
+
+static bool operator<( const std::string &lhs, const slice &rhs )
+{
+    return lhs.compare( 0, std::string::npos, rhs.data, rhs.size ) < 0;
+}
 
 MU_TEST( test_map_assignment )
 {
@@ -90,6 +130,177 @@ MU_TEST( test_map_add_duplicates )
     mu_assert( m[1] == 10, "m[1] == 10" );
 }
 
+MU_TEST( test_map_single_descent )
+{
+    ft::map<int, int, counting_less> m;
+    for ( int i = 0; i < TEST_TREE_SIZE; i++ )
+        m[i] = i;
+
+    // One comparison per level plus the check against the predecessor
+    counting_less::calls = 0;
+    mu_assert_int_eq( 500, m[500] );
+    mu_check( counting_less::calls <= TEST_TREE_MAX_HEIGHT + 1 );
+
+    counting_less::calls = 0;
+    ft::pair<ft::map<int, int, counting_less>::iterator, bool> res =
+        m.insert( ft::make_pair( 7, 0 ) );
+    mu_check( counting_less::calls <= TEST_TREE_MAX_HEIGHT + 1 );
+    mu_check( !res.second && res.first->second == 7 );
+
+    res = m.insert( ft::make_pair( -1, -1 ) );
+    mu_check( res.second && res.first == m.begin() );
+    mu_assert_int_eq( TEST_TREE_SIZE + 1, m.size() );
+}
+
+MU_TEST( test_map_hinted_insert )
+{
+    ft::map<int, int, counting_less> m;
+    counting_less::calls = 0;
+    for ( int i = 0; i < TEST_TREE_SIZE; i += 2 )
+        m.insert( m.end(), ft::make_pair( i, i ) );
+    mu_check( counting_less::calls <= TEST_TREE_SIZE );
+
+    // Right before and right after the hint, then a hint far off
+    ft::map<int, int, counting_less>::iterator hint = m.find( 500 );
+    counting_less::calls                            = 0;
+    mu_assert_int_eq( 499, m.insert( hint, ft::make_pair( 499, 0 ) )->first );
+    mu_assert_int_eq( 501, m.insert( hint, ft::make_pair( 501, 0 ) )->first );
+    mu_check( counting_less::calls <= 8 );
+    mu_assert_int_eq( 7, m.insert( m.begin(), ft::make_pair( 7, 0 ) )->first );
+    mu_assert_int_eq( 6, m.insert( m.end(), ft::make_pair( 6, 0 ) )->second );
+    mu_assert_int_eq( TEST_TREE_SIZE / 2 + 4, m.size() );
+
+    int previous = -1;
+    for ( hint = m.begin(); hint != m.end(); ++hint ) {
+        mu_check( previous < hint->first );
+        previous = hint->first;
+    }
+}
+
+MU_TEST( test_map_bulk_build )
+{
+    typedef ft::map<int, int, counting_less> map_type;
+    std::vector<ft::pair<int, int> >        sorted;
+    for ( int i = 0; i < TEST_TREE_SIZE; i++ )
+        sorted.push_back( ft::make_pair( i, -i ) );
+
+    // A sorted range is checked once, then linked without comparisons
+    counting_less::calls = 0;
+    map_type m( sorted.begin(), sorted.end() );
+    mu_check( counting_less::calls < TEST_TREE_SIZE );
+    mu_assert_int_eq( TEST_TREE_SIZE, m.size() );
+    // 1023 keys fill exactly ten levels
+    counting_less::calls = 0;
+    mu_assert_int_eq( -500, m.lower_bound( 500 )->second );
+    mu_assert_int_eq( 0, m.lower_bound( -1 )->second );
+    mu_check( counting_less::calls == 20 );
+
+    // Copies clone the shape of the tree
+    counting_less::calls = 0;
+    map_type copy( m );
+    mu_check( counting_less::calls == 0 );
+    copy = m;
+    mu_check( counting_less::calls == 0 );
+    mu_check( copy == m );
+    mu_assert_int_eq( TEST_TREE_SIZE - 1, ( --copy.end() )->first );
+
+    // Unsorted ranges, duplicates and non-empty maps insert one by one
+    std::list<ft::pair<int, int> > unsorted( sorted.begin(), sorted.end() );
+    unsorted.push_back( ft::make_pair( 0, 42 ) );
+    unsorted.push_front( ft::make_pair( TEST_TREE_SIZE, 0 ) );
+    map_type other( unsorted.begin(), unsorted.end() );
+    mu_assert_int_eq( TEST_TREE_SIZE + 1, other.size() );
+    mu_assert_int_eq( 0, other[0] );
+    m.insert( unsorted.begin(), unsorted.end() );
+    mu_check( m == other );
+}
+
+MU_TEST( test_map_transparent_lookup )
+{
+    typedef ft::map<std::string, int, ft::less<void> > route_map;
+    route_map                                          routes;
+    routes["/"]      = 0;
+    routes["/users"] = 1;
+    routes["/zoo"]   = 2;
+    const route_map &const_routes = routes;
+
+    slice users = { "/users/42", 6 };
+    slice none  = { "/u", 2 };
+    mu_assert_int_eq( 1, routes.find( users )->second );
+    mu_assert_int_eq( 1, const_routes.find( users )->second );
+    mu_check( routes.find( none ) == routes.end() );
+    mu_assert_int_eq( 1, routes.count( users ) );
+    mu_assert_int_eq( 0, const_routes.count( none ) );
+    mu_assert_int_eq( 1, routes.lower_bound( none )->second );
+    mu_assert_int_eq( 1, const_routes.lower_bound( users )->second );
+    mu_assert_int_eq( 2, routes.upper_bound( users )->second );
+    mu_assert_int_eq( 1, const_routes.upper_bound( none )->second );
+    ft::pair<route_map::iterator, route_map::iterator> range =
+        routes.equal_range( users );
+    mu_check( range.first->second == 1 && range.second->second == 2 );
+    mu_check( const_routes.equal_range( none ).first
+              == const_routes.equal_range( none ).second );
+    mu_assert_int_eq( 2, routes.find( "/zoo" )->second );
+
+    // Without is_transparent the key is converted first
+    ft::map<std::string, int> plain;
+    plain["/users"] = 1;
+    mu_assert_int_eq( 1, plain.find( "/users" )->second );
+    mu_assert_int_eq( 1, plain.count( "/users" ) );
+}
+
+MU_TEST( test_map_order_statistics )
+{
+    typedef ft::map<int,
+                    int,
+                    ft::less<int>,
+                    std::allocator<ft::pair<const int, int> >,
+                    ft::rb_rank_policy>
+                       ranked_map;
+    ranked_map         m;
+    std::map<int, int> ref;
+    std::srand( 7 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS; i++ ) {
+        int key = std::rand() % 1000;
+        if ( std::rand() % 3 == 0 ) {
+            m.erase( key );
+            ref.erase( key );
+        } else {
+            m.insert( m.lower_bound( key ), ft::make_pair( key, i ) );
+            ref.insert( std::make_pair( key, i ) );
+        }
+    }
+    ranked_map copy( m );
+    ranked_map built( copy.begin(), copy.end() );
+
+    bool   same  = true;
+    size_t index = 0;
+    for ( std::map<int, int>::iterator it = ref.begin(); it != ref.end();
+          ++it, ++index ) {
+        same = same && m.nth( index )->first == it->first
+            && copy.nth( index )->first == it->first
+            && built.nth( index )->first == it->first
+            && m.rank( it->first ) == index
+            && m.rank( it->first + 1 ) == index + 1
+            && m.index_of( m.find( it->first ) ) == index;
+    }
+    mu_check( same );
+    mu_check( m.nth( m.size() ) == m.end() );
+    mu_assert_int_eq( m.size(), m.index_of( m.end() ) );
+    mu_assert_int_eq( 0, m.rank( -1 ) );
+    mu_assert_int_eq( m.size(), m.distance( m.begin(), m.end() ) );
+    mu_assert_int_eq( -3, m.distance( m.nth( 5 ), m.nth( 2 ) ) );
+
+    const ranked_map &const_m = m;
+    mu_check( const_m.nth( 0 ) == const_m.begin() );
+
+    // Ranges erased by splitting keep the subtree counts
+    m.erase( m.nth( 100 ), m.nth( 400 ) );
+    mu_assert_int_eq( 100, m.index_of( m.nth( 100 ) ) );
+    mu_assert_int_eq( ref.size() - 300, m.index_of( m.end() ) );
+    mu_assert_int_eq( 42, m.rank( m.nth( 42 )->first ) );
+}
+
 MU_TEST( test_map_find )
 {
     ft::map<int, int> m;
@@ -326,6 +537,307 @@ MU_TEST( test_map_greater_than_or_equal )
     mu_assert( m2 >= m1, "m2 >= m1" );
 }
 
+// Walks m both ways and checks it holds the same elements as ref
+static bool same_contents( const ft::map<int, int>  &m,
+                           const std::map<int, int> &ref )
+{
+    if ( m.size() != ref.size() )
+        return false;
+    ft::map<int, int>::const_iterator  it     = m.begin();
+    std::map<int, int>::const_iterator ref_it = ref.begin();
+    for ( ; ref_it != ref.end(); ++it, ++ref_it ) {
+        if ( it == m.end() || it->first != ref_it->first
+             || it->second != ref_it->second )
+            return false;
+    }
+    if ( it != m.end() )
+        return false;
+    std::map<int, int>::const_reverse_iterator ref_rit = ref.rbegin();
+    while ( ref_rit != ref.rend() ) {
+        --it;
+        if ( it->first != ref_rit->first )
+            return false;
+        ++ref_rit;
+    }
+    return it == m.begin();
+}
+
+MU_TEST( test_map_erase_range )
+{
+    ft::map<int, int>  m;
+    std::map<int, int> ref;
+    std::srand( 11 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS / 10; i++ ) {
+        int key  = std::rand() % 10000;
+        m[key]   = i;
+        ref[key] = i;
+    }
+    // Ranges of every length, the longer ones split and join the tree
+    for ( int i = 0; i < 40; i++ ) {
+        int first = std::rand() % 10000;
+        int last  = first + std::rand() % ( i < 20 ? 50 : 1000 );
+        m.erase( m.lower_bound( first ), m.lower_bound( last ) );
+        ref.erase( ref.lower_bound( first ), ref.lower_bound( last ) );
+        for ( int j = 0; j < 20; j++ ) {
+            int key  = std::rand() % 10000;
+            m[key]   = j;
+            ref[key] = j;
+        }
+    }
+    mu_check( same_contents( m, ref ) );
+
+    size_t expired = std::distance( ref.begin(), ref.lower_bound( 2500 ) );
+    mu_assert_int_eq( expired, m.erase_before( 2500 ) );
+    ref.erase( ref.begin(), ref.lower_bound( 2500 ) );
+    expired = std::distance( ref.upper_bound( 7500 ), ref.end() );
+    mu_assert_int_eq( expired, m.erase_after( 7500 ) );
+    ref.erase( ref.upper_bound( 7500 ), ref.end() );
+    mu_check( same_contents( m, ref ) );
+    mu_assert_int_eq( 0, m.erase_before( 0 ) );
+    m.erase( m.begin(), m.end() );
+    mu_check( m.empty() && m.begin() == m.end() );
+}
+
+MU_TEST( test_map_set_algebra )
+{
+    // Permissions granted to a role, against those a request needs
+    ft::map<int, int>  granted, needed;
+    std::map<int, int> both, only_granted, all;
+    std::srand( 3 );
+    for ( int i = 0; i < 2000; i++ ) {
+        int key      = std::rand() % 5000;
+        granted[key] = i;
+        all[key]     = i;
+    }
+    for ( int i = 0; i < 50; i++ ) {
+        int key     = std::rand() % 5000;
+        needed[key] = -1;
+    }
+    for ( std::map<int, int>::iterator it = all.begin(); it != all.end(); ++it )
+        if ( needed.count( it->first ) )
+            both.insert( *it );
+        else
+            only_granted.insert( *it );
+    for ( ft::map<int, int>::iterator it = needed.begin(); it != needed.end();
+          ++it )
+        all.insert( std::make_pair( it->first, it->second ) );
+
+    // Values come from the left operand when both have the key
+    mu_check( same_contents( ft::set_intersection( granted, needed ), both ) );
+    mu_check(
+        same_contents( ft::set_difference( granted, needed ), only_granted ) );
+    mu_check( same_contents( ft::set_union( granted, needed ), all ) );
+    ft::map<int, int> missing = ft::set_difference( needed, granted );
+    mu_assert_int_eq( needed.size() - both.size(), missing.size() );
+    mu_check( ft::set_intersection( needed, ft::map<int, int>() ).empty() );
+}
+
+MU_TEST( test_map_threaded_iteration )
+{
+    typedef ft::map<int,
+                    int,
+                    ft::less<int>,
+                    std::allocator<ft::pair<const int, int> >,
+                    ft::rb_threaded_policy>
+                       threaded_map;
+    threaded_map       m;
+    std::map<int, int> ref;
+    bool               same = true;
+    std::srand( 5 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS; i++ ) {
+        int key = std::rand() % 2000;
+        switch ( std::rand() % 8 ) {
+        case 0:
+            m.erase( key );
+            ref.erase( key );
+            break;
+        case 1:
+            if ( i % 100 == 0 ) {
+                m.erase( m.lower_bound( key ), m.lower_bound( key + 300 ) );
+                ref.erase( ref.lower_bound( key ),
+                           ref.lower_bound( key + 300 ) );
+            }
+            break;
+        case 2:
+            if ( i % 1000 == 0 ) {
+                threaded_map copy( m );
+                m.swap( copy );
+            }
+            break;
+        default:
+            m.insert( m.lower_bound( key ), ft::make_pair( key, i ) );
+            ref.insert( std::make_pair( key, i ) );
+        }
+        if ( i % 1000 == 0 || i == TEST_RANDOM_OPERATIONS - 1 ) {
+            // Both ways along the threads
+            same = same && m.size() == ref.size();
+            std::map<int, int>::iterator ref_it = ref.begin();
+            for ( threaded_map::iterator it = m.begin(); it != m.end();
+                  ++it, ++ref_it )
+                same = same && it->first == ref_it->first
+                    && it->second == ref_it->second;
+            std::map<int, int>::reverse_iterator ref_rit = ref.rbegin();
+            for ( threaded_map::reverse_iterator rit = m.rbegin();
+                  rit != m.rend(); ++rit, ++ref_rit )
+                same = same && rit->first == ref_rit->first;
+        }
+    }
+    mu_check( same );
+    threaded_map built( m.begin(), m.end() );
+    mu_check( built == m );
+    mu_check( --built.end() == built.find( ref.rbegin()->first ) );
+}
+
+MU_TEST( test_map_extract_merge )
+{
+    typedef ft::map<int, std::string> shard;
+    shard                             a, b;
+    for ( int i = 0; i < 10; i++ ) {
+        a[i]     = "a";
+        b[i + 5] = "b";
+    }
+
+    // Re-keying relinks the same node
+    shard::node_type nh = a.extract( 3 );
+    mu_check( !nh.empty() && a.size() == 9 && a.count( 3 ) == 0 );
+    const ft::pair<const int, std::string> *moved = &nh.value();
+    nh.key()    = 30;
+    nh.mapped() = "moved";
+    ft::pair<shard::iterator, bool> res = a.insert( nh );
+    mu_check( res.second && nh.empty() && &*res.first == moved );
+    mu_check( a[30] == "moved" );
+
+    // A conflicting key leaves the node in the handle, a copy transfers it
+    mu_check( a.extract( 42 ).empty() );
+    shard::node_type taken = b.extract( b.find( 5 ) );
+    shard::node_type copy  = taken;
+    mu_check( taken.empty() && copy.key() == 5 );
+    res = a.insert( copy );
+    mu_check( !res.second && !copy.empty() && res.first->second == "a" );
+    b.insert( copy );
+
+    // Keys 5 to 9 are in both maps and stay in b
+    a.merge( b );
+    mu_assert_int_eq( 15, a.size() );
+    mu_assert_int_eq( 5, b.size() );
+    mu_check( a[5] == "a" && a[14] == "b" && b.begin()->first == 5 );
+    a.merge( a );
+    mu_assert_int_eq( 15, a.size() );
+
+    typedef ft::map<int,
+                    int,
+                    ft::less<int>,
+                    std::allocator<ft::pair<const int, int> >,
+                    ft::rb_rank_policy>
+               ranked_map;
+    ranked_map ranked, other;
+    for ( int i = 0; i < 100; i++ )
+        ( i % 2 ? ranked : other )[i] = i;
+    ranked.insert( other.extract( 0 ) );
+    ranked.merge( other );
+    mu_check( other.empty() );
+    mu_assert_int_eq( 50, ranked.nth( 50 )->second );
+    mu_assert_int_eq( 99, ranked.rank( 99 ) );
+}
+
+// Counts the copies of the mapped values of a map
+struct counted
+{
+    static int copies;
+
+    std::string text;
+
+    counted() : text() {};
+    counted( const char *s ) : text( s ) {};
+    counted( const counted &x ) : text( x.text ) { copies++; };
+
+    counted &operator=( const char *s )
+    {
+        text = s;
+        return *this;
+    };
+};
+
+int counted::copies = 0;
+
+// Returns the mapped value of a cache miss, counting the calls
+struct make_counted
+{
+    static int calls;
+
+    counted operator()() const
+    {
+        calls++;
+        return counted( "made" );
+    };
+};
+
+int make_counted::calls = 0;
+
+MU_TEST( test_map_try_insert )
+{
+    ft::map<int, counted> m;
+    counted::copies     = 0;
+    make_counted::calls = 0;
+
+    // The mapped value is built in the node, and only on a miss
+    ft::pair<ft::map<int, counted>::iterator, bool> res;
+    res = m.try_insert( 1, make_counted() );
+    mu_check( res.second && res.first->second.text == "made" );
+    res = m.try_insert( 1, make_counted() );
+    mu_check( !res.second && res.first->second.text == "made" );
+    mu_assert_int_eq( 1, make_counted::calls );
+
+    // A miss converts the argument, a hit assigns it
+    res = m.insert_or_assign( 2, "new" );
+    mu_check( res.second && m[2].text == "new" );
+    res = m.insert_or_assign( 1, "assigned" );
+    mu_check( !res.second && m[1].text == "assigned" );
+
+    m[3].text = "default";
+    mu_check( m.size() == 3 && m[3].text == "default" );
+    mu_assert_int_eq( 0, counted::copies );
+}
+
+MU_TEST( test_map_random_operations )
+{
+    ft::map<int, int>  m;
+    std::map<int, int> ref;
+    std::srand( 42 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS; i++ ) {
+        int key = std::rand() % 1000;
+        if ( std::rand() % 3 == 0 ) {
+            m.erase( key );
+            ref.erase( key );
+        } else {
+            m[key]   = i;
+            ref[key] = i;
+        }
+        if ( i % 1000 == 0 )
+            mu_check( same_contents( m, ref ) );
+    }
+    mu_check( same_contents( m, ref ) );
+
+    ft::map<int, int> built( m.begin(), m.end() );
+    ft::map<int, int> copy( built );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS / 10; i++ ) {
+        copy.erase( std::rand() % 1000 );
+        copy[std::rand() % 1000] = i;
+    }
+    mu_check( same_contents( built, ref ) );
+    copy = built;
+    mu_check( same_contents( copy, ref ) );
+    ft::map<int, int> empty;
+    copy.swap( empty );
+    mu_check( copy.empty() && copy.begin() == copy.end() );
+    mu_check( same_contents( empty, ref ) );
+    while ( !ref.empty() ) {
+        m.erase( ref.begin()->first );
+        ref.erase( ref.begin() );
+    }
+    mu_check( m.empty() && m.begin() == m.end() );
+}
+
 MU_TEST_SUITE( suite_map )
 {
     MU_RUN_TEST( test_map_assignment );
@@ -333,8 +845,18 @@ MU_TEST_SUITE( suite_map )
     MU_RUN_TEST( test_map_string_pairs );
     MU_RUN_TEST( test_map_iterate );
     MU_RUN_TEST( test_map_add_duplicates );
+    MU_RUN_TEST( test_map_single_descent );
+    MU_RUN_TEST( test_map_hinted_insert );
+    MU_RUN_TEST( test_map_bulk_build );
+    MU_RUN_TEST( test_map_transparent_lookup );
+    MU_RUN_TEST( test_map_order_statistics );
     MU_RUN_TEST( test_map_find );
     MU_RUN_TEST( test_map_erase_iterator );
+    MU_RUN_TEST( test_map_erase_range );
+    MU_RUN_TEST( test_map_set_algebra );
+    MU_RUN_TEST( test_map_threaded_iteration );
+    MU_RUN_TEST( test_map_extract_merge );
+    MU_RUN_TEST( test_map_try_insert );
     MU_RUN_TEST( test_map_key_compare );
     MU_RUN_TEST( test_map_insert_input_iterator );
     MU_RUN_TEST( test_map_swap );
@@ -349,6 +871,7 @@ MU_TEST_SUITE( suite_map )
     MU_RUN_TEST( test_map_less_than_or_equal );
     MU_RUN_TEST( test_map_greater_than );
     MU_RUN_TEST( test_map_greater_than_or_equal );
+    MU_RUN_TEST( test_map_random_operations );
 }
 
 int main()
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "mmap_allocator.hpp"
+#include "map.hpp"
+#include "minunit.h"
+#include "set.hpp"
+#include "vector.hpp"
+#include <string>
+
+#define TEST_VECTOR_SIZE 100000
+#define TEST_THRESHOLD   4096
+
+typedef ft::mmap_allocator<long, TEST_THRESHOLD>       long_alloc;
+typedef ft::mmap_allocator<long, TEST_THRESHOLD, true> populated_alloc;
+
+MU_TEST( test_mmap_allocator_can_reallocate )
+{
+    mu_check( ft::allocator_can_reallocate<long_alloc>::value );
+    typedef long_alloc::rebind<int>::other         rebound;
+    typedef ft::mmap_allocator<int, TEST_THRESHOLD> int_alloc;
+    mu_check( ( ft::is_same<rebound, int_alloc>::value ) );
+}
+
+MU_TEST( test_mmap_allocator_reallocate )
+{
+    long_alloc alloc;
+    long      *p = alloc.allocate( 4 );
+    for ( long i = 0; i < 4; i++ )
+        p[i] = i;
+    p = alloc.reallocate( p, 4, TEST_VECTOR_SIZE );
+    mu_check( reinterpret_cast<size_t>( p ) % long_alloc::huge_page_size == 0 );
+    p[TEST_VECTOR_SIZE - 1] = -1;
+    // A mapping right after p keeps it from growing in place
+    long *next = alloc.allocate( TEST_VECTOR_SIZE );
+    p          = alloc.reallocate( p, TEST_VECTOR_SIZE, TEST_VECTOR_SIZE * 4 );
+    mu_check( reinterpret_cast<size_t>( p ) % long_alloc::huge_page_size == 0 );
+    mu_assert_int_eq( -1, p[TEST_VECTOR_SIZE - 1] );
+    p[TEST_VECTOR_SIZE * 4 - 1] = -1;
+    alloc.deallocate( next, TEST_VECTOR_SIZE );
+    p = alloc.reallocate( p, TEST_VECTOR_SIZE * 4, 8 );
+    for ( long i = 0; i < 4; i++ )
+        mu_assert_int_eq( i, p[i] );
+    alloc.deallocate( p, 8 );
+}
+
+MU_TEST( test_mmap_allocator_vector )
+{
+    ft::vector<long, long_alloc> vecLong;
+    for ( long i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecLong.push_back( i );
+    vecLong.insert( vecLong.begin(), -1 );
+    for ( long i = 0; i < TEST_VECTOR_SIZE; i += 1000 )
+        mu_assert_int_eq( i, vecLong[i + 1] );
+    vecLong.erase( vecLong.begin() + 10, vecLong.end() );
+    vecLong.shrink_to_fit();
+    mu_assert_int_eq( 10, vecLong.capacity() );
+    mu_assert_int_eq( 8, vecLong[9] );
+
+    ft::vector<long, populated_alloc> vecPopulated( TEST_VECTOR_SIZE, 7 );
+    mu_assert_int_eq( 7, vecPopulated[TEST_VECTOR_SIZE - 1] );
+    for ( long i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecPopulated.push_back( i );
+    mu_assert_int_eq( 7, vecPopulated[TEST_VECTOR_SIZE - 1] );
+    mu_assert_int_eq( TEST_VECTOR_SIZE - 1, vecPopulated.back() );
+
+    typedef ft::mmap_allocator<std::string, TEST_THRESHOLD> string_alloc;
+    ft::vector<std::string, string_alloc> vecStr;
+    for ( int i = 0; i < 1000; i++ )
+        vecStr.push_back( std::string( 32, 'a' + i % 26 ) );
+    mu_assert( vecStr[27] == std::string( 32, 'b' ), "elements are kept" );
+}
+
+MU_TEST( test_mmap_allocator_map_set )
+{
+    typedef ft::pair<const int, int> value_type;
+    ft::map<int, int, std::less<int>, ft::mmap_allocator<value_type> > mapInt;
+    ft::set<int, std::less<int>, ft::mmap_allocator<int> >             setInt;
+    for ( int i = 0; i < 1000; i++ ) {
+        mapInt[i] = i * 2;
+        setInt.insert( i );
+    }
+    mu_assert_int_eq( 1000, mapInt.size() );
+    mu_assert_int_eq( 998, mapInt[499] );
+    mu_assert_int_eq( 1000, setInt.size() );
+    mu_check( setInt.find( 999 ) != setInt.end() );
+}
+
+MU_TEST_SUITE( suite_mmap_allocator )
+{
+    MU_RUN_TEST( test_mmap_allocator_can_reallocate );
+    MU_RUN_TEST( test_mmap_allocator_reallocate );
+    MU_RUN_TEST( test_mmap_allocator_vector );
+    MU_RUN_TEST( test_mmap_allocator_map_set );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_mmap_allocator );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
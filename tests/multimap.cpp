@@ -0,0 +1,209 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "multimap.hpp"
+#include "minunit.h"
+#include <cstdlib>
+#include <map>
+#include <string>
+#include <vector>
+
+#define TEST_RANDOM_OPERATIONS 20000
+
+typedef ft::multimap<int, std::string> index_type;
+
+MU_TEST( test_multimap_insert_order )
+{
+    index_type m;
+    m.insert( ft::make_pair( 2, std::string( "b1" ) ) );
+    m.insert( ft::make_pair( 1, std::string( "a" ) ) );
+    m.insert( ft::make_pair( 2, std::string( "b2" ) ) );
+    m.insert( ft::make_pair( 3, std::string( "c" ) ) );
+    m.insert( ft::make_pair( 2, std::string( "b3" ) ) );
+    mu_assert_int_eq( 5, m.size() );
+    mu_assert_int_eq( 3, m.count( 2 ) );
+    mu_assert_int_eq( 0, m.count( 4 ) );
+
+    // Equal keys stay in insertion order
+    ft::pair<index_type::iterator, index_type::iterator> range;
+    range = m.equal_range( 2 );
+    mu_check( range.first == m.find( 2 ) );
+    mu_check( ( range.first++ )->second == "b1" );
+    mu_check( ( range.first++ )->second == "b2" );
+    mu_check( ( range.first++ )->second == "b3" );
+    mu_check( range.first == range.second && range.second->first == 3 );
+
+    range = m.equal_range( 0 );
+    mu_check( range.first == m.begin() && range.second == m.begin() );
+    mu_check( m.find( 4 ) == m.end() );
+}
+
+MU_TEST( test_multimap_hinted_insert )
+{
+    index_type           m;
+    index_type::iterator it;
+
+    // Appending at end() keeps the order of equal keys
+    for ( int i = 0; i < 6; i++ )
+        m.insert( m.end(), ft::make_pair( i / 3, std::string( 1, 'a' + i ) ) );
+    it = m.begin();
+    for ( int i = 0; i < 6; i++, ++it )
+        mu_check( it->first == i / 3 && it->second[0] == 'a' + i );
+
+    // A hint right after the equal keys appends to them, one before them
+    // prepends, and a wrong hint appends as a plain insert does
+    m.insert( m.upper_bound( 0 ), ft::make_pair( 0, std::string( "last" ) ) );
+    m.insert( m.lower_bound( 1 ), ft::make_pair( 1, std::string( "first" ) ) );
+    it = m.insert( m.begin(), ft::make_pair( 1, std::string( "wrong" ) ) );
+    mu_check( ( --m.upper_bound( 0 ) )->second == "last" );
+    mu_check( m.lower_bound( 1 )->second == "first" );
+    mu_check( ++it == m.end() );
+    mu_assert_int_eq( 4, m.count( 0 ) );
+    mu_assert_int_eq( 5, m.count( 1 ) );
+}
+
+MU_TEST( test_multimap_range_constructor )
+{
+    std::vector<ft::pair<int, int> > sorted, shuffled;
+    for ( int i = 0; i < 100; i++ ) {
+        sorted.push_back( ft::make_pair( i / 10, i ) );
+        shuffled.push_back( ft::make_pair( ( i * 7 ) % 10, i ) );
+    }
+    ft::multimap<int, int> a( sorted.begin(), sorted.end() );
+    ft::multimap<int, int> b( shuffled.begin(), shuffled.end() );
+    mu_assert_int_eq( 100, a.size() );
+    mu_assert_int_eq( 100, b.size() );
+    int i = 0;
+    for ( ft::multimap<int, int>::iterator it = a.begin(); it != a.end();
+          ++it, ++i )
+        mu_check( it->first == i / 10 && it->second == i );
+    for ( int k = 0; k < 10; k++ ) {
+        mu_assert_int_eq( 10, a.count( k ) );
+        mu_assert_int_eq( 10, b.count( k ) );
+    }
+    // Equal keys of an unsorted range keep their order in it
+    mu_assert_int_eq( 0, b.find( 0 )->second );
+    mu_assert_int_eq( 90, ( --b.upper_bound( 0 ) )->second );
+
+    ft::multimap<int, int> c( a );
+    mu_check( c == a && !( c < a ) && c <= a );
+    c.erase( c.begin() );
+    mu_check( c != a && a < c );
+}
+
+MU_TEST( test_multimap_erase )
+{
+    ft::multimap<int, int> m;
+    for ( int i = 0; i < 1000; i++ )
+        m.insert( ft::make_pair( i % 50, i ) );
+
+    mu_assert_int_eq( 20, m.erase( 7 ) );
+    mu_assert_int_eq( 0, m.erase( 7 ) );
+    mu_assert_int_eq( 0, m.count( 7 ) );
+    mu_assert_int_eq( 980, m.size() );
+
+    // A range starting and ending among equal keys
+    ft::multimap<int, int>::iterator first = m.find( 10 );
+    ft::multimap<int, int>::iterator last  = m.find( 30 );
+    for ( int i = 0; i < 5; i++ ) {
+        ++first;
+        ++last;
+    }
+    m.erase( first, last );
+    mu_assert_int_eq( 5, m.count( 10 ) );
+    mu_assert_int_eq( 15, m.count( 30 ) );
+    mu_assert_int_eq( 0, m.count( 20 ) );
+    mu_assert_int_eq( 980 - 15 - 19 * 20 - 5, m.size() );
+    mu_assert_int_eq( 210, ( --m.upper_bound( 10 ) )->second );
+    mu_assert_int_eq( 280, m.find( 30 )->second );
+
+    m.erase( m.begin() );
+    mu_assert_int_eq( 50, m.begin()->second );
+    m.erase( m.begin(), m.end() );
+    mu_check( m.empty() && m.begin() == m.end() );
+}
+
+template < typename Multimap >
+static bool same( const Multimap &m, const std::multimap<int, int> &ref )
+{
+    if ( m.size() != ref.size() )
+        return false;
+    typename Multimap::const_iterator       it = m.begin();
+    std::multimap<int, int>::const_iterator jt = ref.begin();
+    for ( ; jt != ref.end(); ++it, ++jt ) {
+        if ( it->first != jt->first || it->second != jt->second )
+            return false;
+    }
+    return it == m.end();
+}
+
+template < typename Multimap >
+static bool random_operations()
+{
+    Multimap                m;
+    std::multimap<int, int> ref;
+    std::srand( 42 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS; i++ ) {
+        int key = std::rand() % 100;
+        int op  = std::rand() % 6;
+        if ( op == 0 ) {
+            if ( m.erase( key ) != ref.erase( key ) )
+                return false;
+        } else if ( op == 1 && !ref.empty() ) {
+            int hi = key + std::rand() % 10;
+            int lo = std::rand() % ( ref.count( key ) + 1 );
+            typename Multimap::iterator       first = m.lower_bound( key );
+            std::multimap<int, int>::iterator rfirst = ref.lower_bound( key );
+            for ( ; lo > 0; lo-- ) {
+                ++first;
+                ++rfirst;
+            }
+            m.erase( first, m.upper_bound( hi ) );
+            ref.erase( rfirst, ref.upper_bound( hi ) );
+        } else if ( op == 2 ) {
+            m.insert( m.upper_bound( key ), ft::make_pair( key, i ) );
+            ref.insert( ref.upper_bound( key ), std::make_pair( key, i ) );
+        } else if ( op == 3 ) {
+            m.insert( m.lower_bound( key ), ft::make_pair( key, i ) );
+            ref.insert( ref.lower_bound( key ), std::make_pair( key, i ) );
+        } else {
+            m.insert( ft::make_pair( key, i ) );
+            ref.insert( std::make_pair( key, i ) );
+        }
+        if ( m.count( key ) != ref.count( key ) )
+            return false;
+        if ( i % 1000 == 0 && !same( m, ref ) )
+            return false;
+    }
+    return same( m, ref );
+}
+
+MU_TEST( test_multimap_random_operations )
+{
+    typedef ft::multimap<int,
+                         int,
+                         ft::less<int>,
+                         std::allocator<ft::pair<const int, int> >,
+                         ft::rb_threaded_policy>
+        threaded_multimap;
+    typedef ft::multimap<int, int> plain_multimap;
+
+    mu_check( random_operations<plain_multimap>() );
+    mu_check( random_operations<threaded_multimap>() );
+}
+
+MU_TEST_SUITE( suite_multimap )
+{
+    MU_RUN_TEST( test_multimap_insert_order );
+    MU_RUN_TEST( test_multimap_hinted_insert );
+    MU_RUN_TEST( test_multimap_range_constructor );
+    MU_RUN_TEST( test_multimap_erase );
+    MU_RUN_TEST( test_multimap_random_operations );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_multimap );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "multiset.hpp"
+#include "minunit.h"
+#include <algorithm>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#define TEST_RANDOM_OPERATIONS 20000
+
+MU_TEST( test_multiset_create )
+{
+    ft::multiset<int> s;
+    for ( int i = 0; i < 10; i++ )
+        s.insert( i % 4 );
+    mu_assert_int_eq( 10, s.size() );
+    mu_assert_int_eq( 3, s.count( 0 ) );
+    mu_assert_int_eq( 3, s.count( 1 ) );
+    mu_assert_int_eq( 2, s.count( 3 ) );
+    mu_assert_int_eq( 0, s.count( 4 ) );
+    mu_check( s.find( 2 ) == s.lower_bound( 2 ) );
+    mu_check( s.find( 4 ) == s.end() );
+
+    int prev = 0;
+    for ( ft::multiset<int>::iterator it = s.begin(); it != s.end(); ++it ) {
+        mu_check( prev <= *it );
+        prev = *it;
+    }
+
+    ft::pair<ft::multiset<int>::iterator, ft::multiset<int>::iterator> range;
+    range = s.equal_range( 1 );
+    mu_check( range.first == s.upper_bound( 0 ) );
+    mu_check( range.second == s.lower_bound( 2 ) );
+}
+
+MU_TEST( test_multiset_range )
+{
+    std::vector<int> sorted;
+    for ( int i = 0; i < 100; i++ )
+        sorted.push_back( i / 4 );
+    ft::multiset<int> s( sorted.begin(), sorted.end() );
+    ft::multiset<int> copy( s );
+    mu_assert_int_eq( 100, s.size() );
+    mu_assert_int_eq( 4, s.count( 24 ) );
+    mu_check( s == copy );
+
+    copy.insert( copy.end(), 24 );
+    copy.insert( copy.begin(), 0 );
+    mu_check( copy < s && copy != s );
+    mu_assert_int_eq( 5, copy.count( 24 ) );
+    mu_assert_int_eq( 5, copy.erase( 0 ) );
+    copy.erase( copy.lower_bound( 10 ), copy.upper_bound( 19 ) );
+    mu_assert_int_eq( 100 + 1 - 4 - 40, copy.size() );
+    mu_check( *copy.lower_bound( 10 ) == 20 );
+    copy.swap( s );
+    mu_assert_int_eq( 100, copy.size() );
+}
+
+MU_TEST( test_multiset_random_operations )
+{
+    ft::multiset<int>  s;
+    std::multiset<int> ref;
+    bool               same = true;
+    std::srand( 42 );
+    for ( int i = 0; i < TEST_RANDOM_OPERATIONS && same; i++ ) {
+        int val = std::rand() % 50;
+        int op  = std::rand() % 4;
+        if ( op == 0 ) {
+            same = s.erase( val ) == ref.erase( val );
+        } else if ( op == 1 ) {
+            s.erase( s.upper_bound( val ), s.upper_bound( val + 5 ) );
+            ref.erase( ref.upper_bound( val ), ref.upper_bound( val + 5 ) );
+        } else {
+            s.insert( val );
+            ref.insert( val );
+        }
+        same = same && s.size() == ref.size()
+            && s.count( val ) == ref.count( val );
+    }
+    mu_check( same );
+    mu_check( std::equal( ref.begin(), ref.end(), s.begin() ) );
+}
+
+MU_TEST_SUITE( suite_multiset )
+{
+    MU_RUN_TEST( test_multiset_create );
+    MU_RUN_TEST( test_multiset_range );
+    MU_RUN_TEST( test_multiset_random_operations );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_multiset );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
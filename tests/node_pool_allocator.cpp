@@ -0,0 +1,148 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "map.hpp"
+#include "minunit.h"
+#include "node_pool_allocator.hpp"
+#include "set.hpp"
+#include "vector.hpp"
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#define TEST_POOL_SIZE 10000
+
+typedef ft::node_pool_allocator<double>                    double_alloc;
+typedef ft::node_pool_allocator<ft::pair<const int, int> > pair_alloc;
+typedef ft::map<int, int, std::less<int>, pair_alloc>       pool_map;
+
+MU_TEST( test_node_pool_allocator_allocate )
+{
+    mu_check( !ft::allocator_can_reallocate<double_alloc>::value );
+    mu_check( ft::allocator_can_release<double_alloc>::value );
+    mu_check( !ft::allocator_can_release<std::allocator<double> >::value );
+    mu_check( ( ft::is_same<double_alloc::rebind<char>::other,
+                            ft::node_pool_allocator<char> >::value ) );
+
+    // Freed objects are handed out again, newest first
+    double_alloc alloc;
+    double      *a = alloc.allocate( 1 );
+    double      *b = alloc.allocate( 1 );
+    mu_check( a != b && reinterpret_cast<size_t>( b ) % sizeof( double ) == 0 );
+    alloc.deallocate( a, 1 );
+    mu_check( alloc.allocate( 1 ) == a );
+    double *many = alloc.allocate( 100 );
+    many[99]     = 1.0;
+    alloc.deallocate( many, 100 );
+    alloc.deallocate( a, 1 );
+    alloc.deallocate( b, 1 );
+
+    // Objects of a few bytes still hold the free list links
+    ft::node_pool_allocator<char, 64> small;
+    char                             *c = small.allocate( 1 );
+    for ( int i = 0; i < 100; i++ )
+        small.allocate( 1 );
+    small.deallocate( c, 1 );
+    mu_check( small.allocate( 1 ) == c );
+}
+
+MU_TEST( test_node_pool_allocator_sharing )
+{
+    double_alloc alloc;
+    double_alloc copy( alloc );
+    mu_check( alloc == copy );
+    mu_check( alloc != double_alloc() );
+    mu_check( alloc != ft::node_pool_allocator<float>( alloc ) );
+
+    double *p = copy.allocate( 1 );
+    alloc.deallocate( p, 1 );
+    mu_check( !alloc.release() );
+    double_alloc other;
+    copy = other;
+    mu_check( copy == other && copy != alloc );
+    mu_check( alloc.release() );
+    mu_check( alloc.allocate( 1 ) != NULL );
+}
+
+MU_TEST( test_node_pool_allocator_map )
+{
+    // Nothing to destroy in the nodes, so clear() frees whole slabs
+    mu_check( ft::is_trivially_destructible<pool_map::value_type>::value );
+    pool_map           m;
+    std::map<int, int> ref;
+    std::srand( 42 );
+    for ( int i = 0; i < TEST_POOL_SIZE; i++ ) {
+        int key = std::rand() % 1000;
+        if ( std::rand() % 3 == 0 ) {
+            m.erase( key );
+            ref.erase( key );
+        } else {
+            m[key]   = i;
+            ref[key] = i;
+        }
+    }
+    mu_assert_int_eq( ref.size(), m.size() );
+    std::map<int, int>::iterator ref_it = ref.begin();
+    bool                         same   = true;
+    for ( pool_map::iterator it = m.begin(); it != m.end(); ++it, ++ref_it )
+        same = same && it->first == ref_it->first
+            && it->second == ref_it->second;
+    mu_check( same );
+
+    // A copy shares the pool, so clearing either one frees node by node
+    pool_map copy( m );
+    m.clear();
+    mu_check( m.empty() && copy.size() == ref.size() );
+    m[1] = 1;
+    copy.clear();
+    mu_assert_int_eq( 1, m[1] );
+    m.clear();
+    for ( int i = 0; i < TEST_POOL_SIZE; i++ )
+        m[i] = i;
+    mu_assert_int_eq( TEST_POOL_SIZE, m.size() );
+
+    // Nodes move between maps sharing a pool, and are copied across pools
+    pool_map shared( std::less<int>(), m.get_allocator() );
+    pool_map separate;
+    shared.insert( m.extract( 0 ) );
+    separate.insert( m.extract( 1 ) );
+    shared.merge( m );
+    separate.merge( shared );
+    mu_check( m.empty() && shared.empty() );
+    mu_assert_int_eq( TEST_POOL_SIZE, separate.size() );
+    mu_check( separate.get_allocator() != m.get_allocator() );
+    m.clear();
+    mu_assert_int_eq( TEST_POOL_SIZE - 1, separate.rbegin()->second );
+}
+
+MU_TEST( test_node_pool_allocator_set )
+{
+    typedef ft::node_pool_allocator<std::string> string_alloc;
+    ft::set<std::string, std::less<std::string>, string_alloc> words;
+    for ( int i = 0; i < 1000; i++ )
+        words.insert( std::string( 32 + i % 7, 'a' + i % 26 ) );
+    mu_assert_int_eq( 26 * 7, words.size() );
+    words.clear();
+    words.insert( "pool" );
+    mu_check( *words.begin() == "pool" );
+
+    ft::vector<int, ft::node_pool_allocator<int> > vecInt;
+    for ( int i = 0; i < 100; i++ )
+        vecInt.push_back( i );
+    mu_assert_int_eq( 99, vecInt.back() );
+}
+
+MU_TEST_SUITE( suite_node_pool_allocator )
+{
+    MU_RUN_TEST( test_node_pool_allocator_allocate );
+    MU_RUN_TEST( test_node_pool_allocator_sharing );
+    MU_RUN_TEST( test_node_pool_allocator_map );
+    MU_RUN_TEST( test_node_pool_allocator_set );
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_node_pool_allocator );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -3,45 +3,73 @@
  */
 #include "rb_iterator.hpp"
 #include "minunit.h"
+#include "rb_reverse_iterator.hpp"
 #include "utility.hpp"
 #include <stdexcept>
+#include <string>
 
 using namespace ft;
 
+// Links the three nodes as the tree 0 <- 1 -> 2 under header
+template < typename T >
+void link_tree( rb_node_base &header, rb_node<T> *nodes )
+{
+    header.set_parent_and_color( &nodes[1], ft::RED );
+    header.left  = &nodes[0];
+    header.right = &nodes[2];
+    nodes[1].set_parent_and_color( &header, ft::BLACK );
+    nodes[1].left  = &nodes[0];
+    nodes[1].right = &nodes[2];
+    nodes[0].set_parent_and_color( &nodes[1], ft::RED );
+    nodes[2].set_parent_and_color( &nodes[1], ft::RED );
+}
+
 MU_TEST( test_rb_iterator_create_int_iterator )
 {
-    static ft::rb_node<int> root( 0, NULL, NULL );
-    static ft::rb_node<int> leaf( 1, &root, NULL );
-    static ft::rb_node<int> node1( 2, &root, &leaf );
-    ft::rb_iterator<int *>  it( &node1 );
-
-    mu_assert( it.base() == &node1, "is not the same as node" );
-    mu_assert( it.base()->root == &root, "is not the same as node" );
-    mu_assert( it.base()->leaf == &leaf, "is not the same as node" );
+    rb_node_base            header;
+    ft::rb_node<int>        nodes[3] = { rb_node<int>( 0 ),
+                                         rb_node<int>( 1 ),
+                                         rb_node<int>( 2 ) };
+    ft::rb_iterator<int *>  it( &nodes[0] );
+    ft::rb_iterator<int *>  end( &header );
+    link_tree( header, nodes );
+
+    mu_assert( it.base() == &nodes[0], "is not the same as node" );
+    for ( int i = 0; i < 3; i++, it++ )
+        mu_assert_int_eq( i, *it );
+    mu_check( it == end );
+    mu_assert_int_eq( 2, *--it );
 }
 
 MU_TEST( test_rb_iterator_create_int_const_iterator )
 {
-    static ft::rb_node<int>      root( 0, NULL, NULL );
-    static ft::rb_node<int>      leaf( 1, &root, NULL );
-    static ft::rb_node<int>      node1( 2, &root, &leaf );
-    ft::rb_iterator<const int *> it( &node1 );
-
-    mu_assert( it.base() == &node1, "is not the same as node" );
-    mu_assert( it.base()->root == &root, "is not the same as node" );
-    mu_assert( it.base()->leaf == &leaf, "is not the same as node" );
+    rb_node_base                 header;
+    ft::rb_node<int>             nodes[3] = { rb_node<int>( 0 ),
+                                              rb_node<int>( 1 ),
+                                              rb_node<int>( 2 ) };
+    ft::rb_iterator<int *>       it( &nodes[1] );
+    ft::rb_iterator<const int *> cit( it );
+    link_tree( header, nodes );
+
+    mu_assert( cit.base() == &nodes[1], "is not the same as node" );
+    mu_check( cit == it );
+    mu_assert_int_eq( 0, *--cit );
 }
 
 MU_TEST( test_rb_iterator_create_string_iterator )
 {
-    static ft::rb_node<std::string> root( "0", NULL, NULL );
-    static ft::rb_node<std::string> leaf( "1", &root, NULL );
-    static ft::rb_node<std::string> node1( "2", &root, &leaf );
-    ft::rb_iterator<std::string *>  it( &node1 );
-
-    mu_assert( it.base() == &node1, "is not the same as node" );
-    mu_assert( it.base()->root == &root, "is not the same as node" );
-    mu_assert( it.base()->leaf == &leaf, "is not the same as node" );
+    rb_node_base                   header;
+    ft::rb_node<std::string>       nodes[3] = { rb_node<std::string>( "0" ),
+                                                rb_node<std::string>( "1" ),
+                                                rb_node<std::string>( "2" ) };
+    ft::rb_iterator<std::string *> end( &header );
+    link_tree( header, nodes );
+
+    ft::rb_reverse_iterator<ft::rb_iterator<std::string *> > rit( end );
+    mu_assert( *rit == "2", "reverse iteration starts at the last node" );
+    mu_assert( rit->size() == 1, "reaches the member of the node" );
+    ++rit;
+    mu_assert( *rit == "1", "reverse iteration goes backwards" );
 }
 
 MU_TEST_SUITE( suite_rb_iterator )
@@ -4,47 +4,67 @@
 #include "rb_node.hpp"
 #include "minunit.h"
 
-static ft::rb_node<int> root( 0, NULL, NULL );
-static ft::rb_node<int> leaf( 1, &root, NULL );
-static ft::rb_node<int> node1( 2, &leaf, &leaf );
+typedef ft::rb_node_base base;
 
-MU_TEST( test_rb_node_root )
+// The tree 1 <- 2 -> 3 under its header
+static base             header;
+static ft::rb_node<int> node1( 1 );
+static ft::rb_node<int> node2( 2 );
+static ft::rb_node<int> node3( 3 );
+
+static void link_tree()
+{
+    header.set_parent_and_color( &node2, ft::RED );
+    header.left  = &node1;
+    header.right = &node3;
+    node2.set_parent_and_color( &header, ft::BLACK );
+    node2.left  = &node1;
+    node2.right = &node3;
+    node1.set_parent_and_color( &node2, ft::RED );
+    node3.set_parent_and_color( &node2, ft::RED );
+}
+
+MU_TEST( test_rb_node_layout )
 {
-    mu_assert_int_eq( root.data, 0 );
-    mu_assert( root.parent == NULL, "is not the same as parent" );
-    mu_assert( root.left == NULL, "is not the same as left" );
-    mu_assert( root.right == NULL, "is not the same right" );
-    mu_assert( root.leaf == NULL, "is not the same as leaf" );
-    mu_assert( root.color == ft::BLACK, "is not black" );
+    mu_assert_int_eq( 3 * sizeof( void * ), sizeof( base ) );
+    mu_assert( sizeof( ft::rb_node<int> ) <= 4 * sizeof( void * ),
+               "a node of int holds three links and the int" );
+    ft::rb_node<int> node( 0 );
+    mu_assert_int_eq( 0, node.data );
+    mu_assert( node.parent() == NULL, "has no parent" );
+    mu_assert( node.left == NULL && node.right == NULL, "has no children" );
 }
 
-MU_TEST( test_rb_node_leaf )
+MU_TEST( test_rb_node_color_bit )
 {
-    mu_assert_int_eq( leaf.data, 1 );
-    mu_assert( leaf.parent == NULL, "is not the same as parent" );
-    mu_assert( leaf.left == NULL, "is not the same as left" );
-    mu_assert( leaf.right == NULL, "is not the same right" );
-    mu_assert( leaf.root == &root, "is not the same as root" );
-    mu_assert( leaf.leaf == NULL, "is not the same as leaf" );
-    mu_assert( leaf.color == ft::BLACK, "is not black" );
+    ft::rb_node<int> node( 0 );
+    node.set_parent( &node1 );
+    node.set_color( ft::BLACK );
+    mu_assert( node.parent() == &node1, "the color keeps the parent" );
+    mu_assert( node.color() == ft::BLACK, "is black" );
+    node.set_parent( &node3 );
+    mu_assert( node.color() == ft::BLACK, "the parent keeps the color" );
+    node.set_color( ft::RED );
+    mu_assert( node.parent() == &node3, "the color keeps the parent" );
+    mu_assert( node.color() == ft::RED, "is red" );
 }
 
-MU_TEST( test_rb_node_node1 )
+MU_TEST( test_rb_node_navigation )
 {
-    mu_assert_int_eq( node1.data, 2 );
-    mu_assert( node1.parent == NULL, "is not the same as parent" );
-    mu_assert( node1.left == NULL, "is not the same as left" );
-    mu_assert( node1.right == NULL, "is not the same right" );
-    mu_assert( node1.root == &leaf, "is not the same as root" );
-    mu_assert( node1.leaf == &leaf, "is not the same as leaf" );
-    mu_assert( node1.color == ft::BLACK, "is not black" );
+    link_tree();
+    mu_assert( base::minimum( &node2 ) == &node1, "minimum is 1" );
+    mu_assert( base::maximum( &node2 ) == &node3, "maximum is 3" );
+    mu_assert( base::successor( &node1 ) == &node2, "1 is followed by 2" );
+    mu_assert( base::successor( &node3 ) == &header, "3 is followed by end" );
+    mu_assert( base::predecessor( &header ) == &node3, "end follows 3" );
+    mu_assert( base::predecessor( &node2 ) == &node1, "2 follows 1" );
 }
 
 MU_TEST_SUITE( suite_rb_node )
 {
-    MU_RUN_TEST( test_rb_node_root );
-    MU_RUN_TEST( test_rb_node_leaf );
-    MU_RUN_TEST( test_rb_node_node1 );
+    MU_RUN_TEST( test_rb_node_layout );
+    MU_RUN_TEST( test_rb_node_color_bit );
+    MU_RUN_TEST( test_rb_node_navigation );
 }
 
 int main()
@@ -3,6 +3,11 @@
  */
 #include "set.hpp"
 #include "minunit.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <vector>
 
 MU_TEST( test_set_create )
 {
@@ -118,6 +123,17 @@ MU_TEST( test_set_erase_first_last )
     mu_assert_int_eq( s.size(), 2 );
     mu_assert_int_eq( *s.begin(), 40 );
     mu_assert_int_eq( *s.rbegin(), 50 );
+
+    for ( int i = 0; i < 100; i++ ) {
+        s.insert( i );
+    }
+    mu_assert_int_eq( 10, s.erase_before( 10 ) );
+    mu_assert_int_eq( 10, s.erase_after( 89 ) );
+    s.erase( s.find( 20 ), s.find( 70 ) );
+    mu_assert_int_eq( 30, s.size() );
+    mu_assert_int_eq( 10, *s.begin() );
+    mu_assert_int_eq( 70, *s.find( 70 ) );
+    mu_assert_int_eq( 89, *s.rbegin() );
 }
 
 MU_TEST( test_set_swap )
@@ -215,6 +231,163 @@ MU_TEST( test_set_bounds )
         = s.equal_range( 20 );
     mu_assert_int_eq( *p.first, 20 );
     mu_assert_int_eq( *p.second, 30 );
+    p = s.equal_range( 25 );
+    mu_check( p.first == p.second && *p.first == 30 );
+}
+
+MU_TEST( test_set_transparent_lookup )
+{
+    typedef ft::set<std::string, ft::less<void> > string_set;
+    string_set                                    words;
+    words.insert( "apple" );
+    words.insert( "pear" );
+
+    mu_check( *words.find( "pear" ) == "pear" );
+    mu_check( words.find( "plum" ) == words.end() );
+    mu_assert_int_eq( 1, words.count( "apple" ) );
+    mu_check( *words.lower_bound( "b" ) == "pear" );
+    mu_check( words.upper_bound( "pear" ) == words.end() );
+    ft::pair<string_set::iterator, string_set::iterator> range =
+        words.equal_range( "apple" );
+    mu_check( *range.first == "apple" && *range.second == "pear" );
+    mu_check( ft::less<void>()( 1, 2.5 ) && !ft::less<void>()( 'b', 'a' ) );
+}
+
+MU_TEST( test_set_order_statistics )
+{
+    typedef ft::set<int, ft::less<int>, std::allocator<int>, ft::rb_rank_policy>
+             ranked_set;
+    ranked_set scores;
+    for ( int i = 100; i > 0; i-- )
+        scores.insert( i * 10 );
+    scores.erase( 500 );
+
+    mu_assert_int_eq( 10, *scores.nth( 0 ) );
+    mu_assert_int_eq( 510, *scores.nth( 49 ) );
+    mu_assert_int_eq( 1000, *scores.nth( 98 ) );
+    mu_check( scores.nth( 99 ) == scores.end() );
+    mu_assert_int_eq( 49, scores.rank( 505 ) );
+    mu_assert_int_eq( 99, scores.rank( 1001 ) );
+    mu_assert_int_eq( 49, scores.index_of( scores.find( 510 ) ) );
+    mu_assert_int_eq( 10, scores.distance( scores.lower_bound( 100 ),
+                                           scores.lower_bound( 200 ) ) );
+}
+
+MU_TEST( test_set_threaded_iteration )
+{
+    typedef ft::set<int,
+                    ft::less<int>,
+                    std::allocator<int>,
+                    ft::rb_threaded_policy>
+                 threaded_set;
+    threaded_set s;
+    for ( int i = 100; i > 0; i-- )
+        s.insert( i );
+    for ( int i = 2; i <= 100; i += 2 )
+        s.erase( i );
+    s.erase( s.find( 41 ), s.find( 81 ) );
+
+    int  expected = 1;
+    bool same     = true;
+    for ( threaded_set::iterator it = s.begin(); it != s.end(); ++it ) {
+        same      = same && *it == expected;
+        expected += expected == 39 ? 42 : 2;
+    }
+    mu_check( same && expected == 101 );
+    for ( threaded_set::reverse_iterator it = s.rbegin(); it != s.rend(); ++it )
+        expected -= *it;
+    mu_assert_int_eq( 101 - 400 - 900, expected );
+    threaded_set copy( s );
+    copy.swap( s );
+    mu_assert_int_eq( 99, *--s.end() );
+}
+
+MU_TEST( test_set_extract_merge )
+{
+    ft::set<std::string> tags, other;
+    tags.insert( "red" );
+    tags.insert( "green" );
+    other.insert( "green" );
+    other.insert( "blue" );
+
+    ft::set<std::string>::node_type nh = tags.extract( "red" );
+    mu_check( nh.value() == "red" && tags.size() == 1 );
+    mu_check( tags.extract( "red" ).empty() );
+    const std::string *moved = &nh.value();
+    mu_check( &*other.insert( nh ).first == moved && nh.empty() );
+    mu_check( !tags.insert( other.extract( other.find( "green" ) ) ).second );
+
+    // The green node of other went away with its temporary handle
+    tags.merge( other );
+    mu_assert_int_eq( 3, tags.size() );
+    mu_check( other.empty() && *tags.begin() == "blue" );
+}
+
+static size_t g_comparisons = 0;
+
+struct counting_less
+{
+    bool operator()( int a, int b ) const
+    {
+        g_comparisons++;
+        return a < b;
+    };
+};
+
+MU_TEST( test_set_algebra )
+{
+    typedef ft::set<int, ft::less<int>, std::allocator<int>, ft::rb_rank_policy>
+                     ranked_set;
+    std::vector<int> ref;
+    bool             same = true;
+    std::srand( 7 );
+    for ( int round = 0; round < 40; round++ ) {
+        ranked_set a, b;
+        int        na = std::rand() % ( round % 4 == 0 ? 10 : 400 );
+        int        nb = std::rand() % 400;
+        for ( int i = 0; i < na; i++ )
+            a.insert( std::rand() % 600 );
+        for ( int i = 0; i < nb; i++ )
+            b.insert( std::rand() % 600 );
+        ranked_set ops[3] = { ft::set_union( a, b ),
+                              ft::set_intersection( a, b ),
+                              ft::set_difference( a, b ) };
+        for ( int op = 0; op < 3; op++ ) {
+            ref.clear();
+            if ( op == 0 )
+                std::set_union( a.begin(), a.end(), b.begin(), b.end(),
+                                std::back_inserter( ref ) );
+            else if ( op == 1 )
+                std::set_intersection( a.begin(), a.end(), b.begin(), b.end(),
+                                       std::back_inserter( ref ) );
+            else
+                std::set_difference( a.begin(), a.end(), b.begin(), b.end(),
+                                     std::back_inserter( ref ) );
+            same = same && ops[op].size() == ref.size()
+                && std::equal( ref.begin(), ref.end(), ops[op].begin() );
+            for ( size_t i = 0; i < ref.size(); i += 17 )
+                same = same && *ops[op].nth( i ) == ref[i];
+        }
+    }
+    mu_check( same );
+
+    ft::set<int> s;
+    for ( int i = 0; i < 10; i++ )
+        s.insert( i );
+    mu_check( ft::set_union( s, s ) == s );
+    mu_check( ft::set_intersection( s, s ) == s );
+    mu_check( ft::set_difference( s, s ).empty() );
+
+    // A few keys against many are found without walking the large set
+    ft::set<int, counting_less> few, many;
+    for ( int i = 0; i < 65536; i++ )
+        many.insert( many.end(), i );
+    for ( int i = 0; i < 16; i++ )
+        few.insert( i * 4096 + 1 );
+    g_comparisons                     = 0;
+    ft::set<int, counting_less> inter = ft::set_intersection( many, few );
+    mu_assert_int_eq( 16, inter.size() );
+    mu_check( g_comparisons < 1000 );
 }
 
 MU_TEST( test_set_lesser )
@@ -361,6 +534,11 @@ MU_TEST_SUITE( suite_set )
     MU_RUN_TEST( test_set_observers );
     MU_RUN_TEST( test_set_count );
     MU_RUN_TEST( test_set_bounds );
+    MU_RUN_TEST( test_set_transparent_lookup );
+    MU_RUN_TEST( test_set_order_statistics );
+    MU_RUN_TEST( test_set_algebra );
+    MU_RUN_TEST( test_set_threaded_iteration );
+    MU_RUN_TEST( test_set_extract_merge );
     MU_RUN_TEST( test_set_lesser );
     MU_RUN_TEST( test_set_greater );
     MU_RUN_TEST( test_set_less_equal );
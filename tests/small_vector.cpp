@@ -0,0 +1,241 @@
+/*
+ * Copyright 2022 ©️ vcwild under the GNU Affero General Public License v3.0.
+ */
+#include "small_vector.hpp"
+#include "minunit.h"
+#include "stack.hpp"
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <string>
+
+#define TEST_INLINE_SIZE 4
+
+typedef ft::small_vector<int, TEST_INLINE_SIZE>         small_ints;
+typedef ft::small_vector<std::string, TEST_INLINE_SIZE> small_strings;
+
+MU_TEST( test_small_vec_inline )
+{
+    small_ints vecInt;
+    mu_check( vecInt.is_inline() );
+    mu_assert_int_eq( TEST_INLINE_SIZE, vecInt.capacity() );
+    for ( int i = 0; i < TEST_INLINE_SIZE; i++ )
+        vecInt.push_back( i );
+    mu_check( vecInt.is_inline() );
+    mu_assert_int_eq( TEST_INLINE_SIZE, vecInt.size() );
+    mu_assert_int_eq( 3, vecInt.back() );
+}
+
+MU_TEST( test_small_vec_spill )
+{
+    small_ints vecInt;
+    for ( int i = 0; i < 100; i++ )
+        vecInt.push_back( i );
+    mu_check( !vecInt.is_inline() );
+    for ( int i = 0; i < 100; i++ )
+        mu_assert_int_eq( i, vecInt[i] );
+    vecInt.erase( vecInt.begin() + 2, vecInt.end() );
+    vecInt.shrink_to_fit();
+    mu_check( vecInt.is_inline() );
+    mu_assert_int_eq( 2, vecInt.size() );
+    mu_assert_int_eq( 1, vecInt[1] );
+}
+
+MU_TEST( test_small_vec_constructors )
+{
+    small_ints vecFill( ( size_t ) 10, 42 );
+    mu_assert_int_eq( 10, vecFill.size() );
+    mu_assert_int_eq( 42, vecFill[9] );
+
+    small_ints vecInt( 3, 7 );
+    mu_assert_int_eq( 3, vecInt.size() );
+    mu_assert_int_eq( 7, vecInt[2] );
+
+    small_ints vecRange( vecFill.begin(), vecFill.begin() + 3 );
+    mu_check( vecRange.is_inline() );
+    mu_assert_int_eq( 42, vecRange[2] );
+
+    std::istringstream in( "1 2 3 4 5 6" );
+    small_ints         vecStream( ( std::istream_iterator<int>( in ) ),
+                                  std::istream_iterator<int>() );
+    mu_assert_int_eq( 6, vecStream.size() );
+    mu_assert_int_eq( 6, vecStream[5] );
+
+    small_ints vecCopy( vecFill );
+    mu_check( vecCopy == vecFill );
+    vecCopy = vecRange;
+    mu_check( vecCopy == vecRange );
+}
+
+MU_TEST( test_small_vec_insert_erase_string )
+{
+    small_strings vecStr;
+    vecStr.push_back( "a" );
+    vecStr.push_back( "b" );
+    vecStr.insert( vecStr.begin() + 1, ( size_t ) 3, "x" );
+    vecStr.insert( vecStr.begin(), vecStr[3] );
+    mu_assert_int_eq( 6, vecStr.size() );
+    mu_assert( vecStr[0] == "x" && vecStr[1] == "a", "inserted at front" );
+    mu_assert( vecStr[5] == "b", "shifted the tail" );
+    vecStr.erase( vecStr.begin() + 2, vecStr.begin() + 5 );
+    mu_assert_int_eq( 3, vecStr.size() );
+    mu_assert( vecStr[2] == "b", "closed the gap" );
+    vecStr.push_back( vecStr[0] );
+    mu_assert( vecStr[3] == "x", "pushed a copy of an element" );
+}
+
+MU_TEST( test_small_vec_swap )
+{
+    small_strings inlineStr( ( size_t ) 2, "in" );
+    small_strings heapStr( ( size_t ) 10, "heap" );
+    inlineStr.swap( heapStr );
+    mu_assert_int_eq( 10, inlineStr.size() );
+    mu_assert_int_eq( 2, heapStr.size() );
+    mu_assert( inlineStr[9] == "heap" && heapStr[1] == "in", "swapped" );
+
+    small_strings otherHeap( ( size_t ) 20, "other" );
+    const std::string *data = otherHeap.data();
+    ft::swap( inlineStr, otherHeap );
+    mu_assert( inlineStr.data() == data, "heap storage is swapped" );
+}
+
+MU_TEST( test_small_vec_comparison )
+{
+    small_ints lhs( ( size_t ) 3, 1 );
+    small_ints rhs( ( size_t ) 3, 1 );
+    mu_check( lhs == rhs );
+    rhs.push_back( 0 );
+    mu_check( lhs != rhs );
+    mu_check( lhs < rhs );
+    mu_check( rhs >= lhs );
+}
+
+MU_TEST( test_small_vec_stack )
+{
+    ft::stack<int, small_ints> stackInt;
+    for ( int i = 0; i < 10; i++ )
+        stackInt.push( i );
+    mu_assert_int_eq( 10, stackInt.size() );
+    mu_assert_int_eq( 9, stackInt.top() );
+    stackInt.pop();
+    mu_assert_int_eq( 8, stackInt.top() );
+    ft::stack<int, small_ints> stackCopy( stackInt );
+    mu_check( stackCopy == stackInt );
+}
+
+#if defined( __GNUC__ )
+struct wide_lane
+{
+    double lanes[4];
+} __attribute__( ( aligned( 32 ) ) );
+
+MU_TEST( test_small_vec_over_aligned )
+{
+    struct slot
+    {
+        char                                          tag;
+        ft::small_vector<wide_lane, TEST_INLINE_SIZE> lanes;
+    };
+    slot      slots[4];
+    wide_lane lane = { { 1, 2, 3, 4 } };
+    mu_assert_int_eq( 32, ft::alignment_of<wide_lane>::value );
+    for ( int i = 0; i < 4; i++ ) {
+        slots[i].lanes.push_back( lane );
+        mu_assert_int_eq(
+            0, ( size_t ) slots[i].lanes.data() % sizeof( wide_lane ) );
+        mu_check( slots[i].lanes[0].lanes[3] == 4 );
+    }
+}
+#endif
+
+#if FT_CXX11
+MU_TEST( test_small_vec_move )
+{
+    small_strings vecStr;
+    vecStr.emplace_back( 3, 'a' );
+    small_strings vecMove( std::move( vecStr ) );
+    mu_assert_int_eq( 0, vecStr.size() );
+    mu_assert( vecMove[0] == "aaa", "inline elements are moved" );
+    for ( int i = 0; i < 10; i++ )
+        vecMove.emplace_back( "b" );
+    const std::string *data = vecMove.data();
+    vecStr = std::move( vecMove );
+    mu_assert( vecStr.data() == data, "heap storage is stolen" );
+    mu_check( vecMove.is_inline() );
+}
+
+// Remembers which allocator allocated each buffer, and counts the buffers
+// freed by another one
+template < typename T >
+struct tagged_allocator : std::allocator<T>
+{
+    static std::map<T *, int> owners;
+    static int                foreign_frees;
+    int                       tag;
+
+    explicit tagged_allocator( int t = 0 ) : tag( t ) {};
+
+    T *allocate( size_t n )
+    {
+        T *p      = std::allocator<T>::allocate( n );
+        owners[p] = tag;
+        return p;
+    };
+
+    void deallocate( T *p, size_t n )
+    {
+        foreign_frees += owners[p] != tag;
+        owners.erase( p );
+        std::allocator<T>::deallocate( p, n );
+    };
+};
+
+template < typename T >
+std::map<T *, int> tagged_allocator<T>::owners;
+
+template < typename T >
+int tagged_allocator<T>::foreign_frees = 0;
+
+MU_TEST( test_small_vec_move_assign_allocator )
+{
+    typedef tagged_allocator<int>                           tagged;
+    typedef ft::small_vector<int, TEST_INLINE_SIZE, tagged> tagged_ints;
+    {
+        tagged_ints heap( ( tagged( 1 ) ) );
+        tagged_ints target( ( tagged( 2 ) ) );
+        for ( int i = 0; i < 10; i++ ) {
+            heap.push_back( i );
+            target.push_back( i );
+        }
+        target = std::move( heap );
+        mu_assert_int_eq( 1, target.get_allocator().tag );
+        mu_assert_int_eq( 9, target.back() );
+    }
+    mu_assert_int_eq( 0, tagged::foreign_frees );
+}
+#endif
+
+MU_TEST_SUITE( suite_small_vector )
+{
+    MU_RUN_TEST( test_small_vec_inline );
+    MU_RUN_TEST( test_small_vec_spill );
+    MU_RUN_TEST( test_small_vec_constructors );
+    MU_RUN_TEST( test_small_vec_insert_erase_string );
+    MU_RUN_TEST( test_small_vec_swap );
+    MU_RUN_TEST( test_small_vec_comparison );
+    MU_RUN_TEST( test_small_vec_stack );
+#if defined( __GNUC__ )
+    MU_RUN_TEST( test_small_vec_over_aligned );
+#endif
+#if FT_CXX11
+    MU_RUN_TEST( test_small_vec_move );
+    MU_RUN_TEST( test_small_vec_move_assign_allocator );
+#endif
+}
+
+int main()
+{
+    MU_RUN_SUITE( suite_small_vector );
+    MU_REPORT();
+    return MU_EXIT_CODE;
+}
@@ -4,6 +4,13 @@
 #include "type_traits.hpp"
 #include "minunit.h"
 #include <limits.h>
+#include <string>
+
+struct pod_point
+{
+    int    x;
+    double y;
+};
 
 MU_TEST( test_is_integral_bool )
 {
@@ -125,6 +132,34 @@ MU_TEST( test_is_integral_int_const_ptr )
                "is_integral<int const *>::value == false" );
 }
 
+MU_TEST( test_is_floating_point_double )
+{
+    mu_assert( ft::is_floating_point<double>::value == true,
+               "is_floating_point<double>::value == true" );
+}
+
+MU_TEST( test_is_trivially_copyable )
+{
+    mu_assert( ft::is_trivially_copyable<int>::value == true,
+               "is_trivially_copyable<int>::value == true" );
+    mu_assert( ft::is_trivially_copyable<double *>::value == true,
+               "is_trivially_copyable<double *>::value == true" );
+    mu_assert( ft::is_trivially_copyable<pod_point>::value == true,
+               "is_trivially_copyable<pod_point>::value == true" );
+    mu_assert( ft::is_trivially_copyable<std::string>::value == false,
+               "is_trivially_copyable<std::string>::value == false" );
+}
+
+MU_TEST( test_is_trivially_destructible )
+{
+    mu_assert( ft::is_trivially_destructible<char>::value == true,
+               "is_trivially_destructible<char>::value == true" );
+    mu_assert( ft::is_trivially_destructible<pod_point>::value == true,
+               "is_trivially_destructible<pod_point>::value == true" );
+    mu_assert( ft::is_trivially_destructible<std::string>::value == false,
+               "is_trivially_destructible<std::string>::value == false" );
+}
+
 MU_TEST_SUITE( suite_type_traits )
 {
     MU_RUN_TEST( test_is_integral_bool );
@@ -147,6 +182,9 @@ MU_TEST_SUITE( suite_type_traits )
     MU_RUN_TEST( test_is_integral_int_const_volatile );
     MU_RUN_TEST( test_is_integral_int_ptr );
     MU_RUN_TEST( test_is_integral_int_const_ptr );
+    MU_RUN_TEST( test_is_floating_point_double );
+    MU_RUN_TEST( test_is_trivially_copyable );
+    MU_RUN_TEST( test_is_trivially_destructible );
 }
 
 int main()
@@ -3,6 +3,8 @@
  */
 #include "vector.hpp"
 #include "minunit.h"
+#include <iterator>
+#include <list>
 #include <sstream>
 #include <string>
 
@@ -10,7 +12,7 @@
 
 #define SSTR( x )                                                              \
     static_cast< std::ostringstream & >(                                       \
-        ( std::ostringstream() << std::dec << x ) )                            \
+        ( std::ostringstream().flush() << std::dec << x ) )                    \
         .str()
 
 MU_TEST( test_vec_copy_constructor )
@@ -330,6 +332,23 @@ MU_TEST( test_vec_push_back )
     mu_assert_int_eq( 42, vecMut[TEST_VECTOR_SIZE] );
 }
 
+MU_TEST( test_vec_push_back_growth )
+{
+    ft::vector<int> vecMut;
+    size_t          reallocations = 0;
+    size_t          capacity      = vecMut.capacity();
+    for ( int i = 0; i < 1000; i++ ) {
+        vecMut.push_back( i );
+        if ( vecMut.capacity() != capacity ) {
+            capacity = vecMut.capacity();
+            reallocations++;
+        }
+    }
+    for ( int i = 0; i < 1000; i++ )
+        mu_assert_int_eq( i, vecMut[i] );
+    mu_assert( reallocations <= 11, "capacity grows geometrically" );
+}
+
 MU_TEST( test_vec_pop_back )
 {
     ft::vector<int> vecMut( TEST_VECTOR_SIZE );
@@ -358,6 +377,20 @@ MU_TEST( test_vec_insert_pos_nsize_val )
         mu_assert_int_eq( 42, vecMut[i] );
 }
 
+MU_TEST( test_vec_insert_pos_nsize_val_middle )
+{
+    ft::vector<int> vecMut;
+    for ( int i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecMut.push_back( i );
+    vecMut.insert( vecMut.begin() + 5, ( size_t ) 3, 42 );
+    mu_assert_int_eq( TEST_VECTOR_SIZE + 3, vecMut.size() );
+    mu_assert_int_eq( 4, vecMut[4] );
+    mu_assert_int_eq( 42, vecMut[5] );
+    mu_assert_int_eq( 42, vecMut[7] );
+    mu_assert_int_eq( 5, vecMut[8] );
+    mu_assert_int_eq( 9, vecMut[12] );
+}
+
 MU_TEST( test_vec_insert_pos_range )
 {
     ft::vector<int> vecInt( TEST_VECTOR_SIZE );
@@ -368,6 +401,42 @@ MU_TEST( test_vec_insert_pos_range )
     mu_assert_int_eq( 0, vecMut[0] );
 }
 
+MU_TEST( test_vec_insert_pos_range_categories )
+{
+    std::list<std::string> lst;
+    for ( int i = 0; i < TEST_VECTOR_SIZE; i++ )
+        lst.push_back( SSTR( i ) );
+    ft::vector<std::string> vecStr( lst.begin(), lst.end() );
+    mu_assert_int_eq( TEST_VECTOR_SIZE, vecStr.size() );
+    mu_assert_int_eq( TEST_VECTOR_SIZE, vecStr.capacity() );
+    vecStr.insert( vecStr.begin() + 8, lst.begin(), lst.end() );
+    mu_assert( vecStr[8] == "0" && vecStr[17] == "9", "inserted the list" );
+    mu_assert( vecStr[18] == "8" && vecStr[19] == "9", "shifted the tail" );
+
+    std::istringstream         in( "1 2 3 4 5" );
+    std::istream_iterator<int> first( in );
+    std::istream_iterator<int> last;
+    ft::vector<int>            vecInt( first, last );
+    mu_assert_int_eq( 5, vecInt.size() );
+    std::istringstream more( "-1 -2 -3" );
+    vecInt.insert( vecInt.begin() + 1,
+                   std::istream_iterator<int>( more ),
+                   std::istream_iterator<int>() );
+    mu_assert_int_eq( 8, vecInt.size() );
+    mu_assert_int_eq( 1, vecInt[0] );
+    mu_assert_int_eq( -1, vecInt[1] );
+    mu_assert_int_eq( -3, vecInt[3] );
+    mu_assert_int_eq( 2, vecInt[4] );
+    mu_assert_int_eq( 5, vecInt[7] );
+
+    ft::vector<int> vecFill( 4, 42 );
+    mu_assert_int_eq( 4, vecFill.size() );
+    vecFill.insert( vecFill.begin(), 2, 7 );
+    mu_assert_int_eq( 6, vecFill.size() );
+    mu_assert_int_eq( 7, vecFill[1] );
+    mu_assert_int_eq( 42, vecFill[2] );
+}
+
 MU_TEST( test_vec_erase_first )
 {
     ft::vector<int> vecInt( TEST_VECTOR_SIZE );
@@ -396,6 +465,25 @@ MU_TEST( test_vec_erase_range )
                "size is reduced by 5" );
 }
 
+MU_TEST( test_vec_insert_erase_string )
+{
+    ft::vector<std::string> vecStr;
+    for ( int i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecStr.push_back( SSTR( i ) );
+    vecStr.insert( vecStr.begin() + 2, ( size_t ) 3, "x" );
+    vecStr.insert( vecStr.begin(), vecStr[4] );
+    mu_assert_int_eq( TEST_VECTOR_SIZE + 4, vecStr.size() );
+    mu_assert( vecStr[0] == "x", "inserted a copy of an element" );
+    mu_assert( vecStr[3] == "x" && vecStr[5] == "x", "filled the gap" );
+    mu_assert( vecStr[6] == "2", "shifted the tail" );
+    vecStr.erase( vecStr.begin() + 1, vecStr.begin() + 6 );
+    for ( int i = 0; i < TEST_VECTOR_SIZE - 2; i++ )
+        mu_assert( vecStr[i + 1] == SSTR( i + 2 ), "closed the gap" );
+    ft::vector<std::string> copyStr;
+    copyStr = vecStr;
+    mu_assert( copyStr == vecStr, "copy is equal" );
+}
+
 MU_TEST( test_vec_swap_empty )
 {
     ft::vector<int> vecMut;
@@ -505,6 +593,140 @@ MU_TEST( test_vec_of_vecs_of_vecs )
     mu_assert_int_eq( 4, vecMut[0][0][4] );
 }
 
+MU_TEST( test_vec_relocation_keeps_payload )
+{
+    mu_check( ft::is_swap_relocatable<std::string>::value );
+    mu_check( ft::is_swap_relocatable<ft::vector<int> >::value );
+    mu_check( !ft::is_swap_relocatable<int>::value );
+
+    ft::vector<std::string> vecStr;
+    for ( int i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecStr.push_back( std::string( 32, 'a' + i ) );
+    const char *first = vecStr[0].data();
+    const char *last  = vecStr[9].data();
+    vecStr.reserve( 1000 );
+    vecStr.insert( vecStr.begin(), ( size_t ) 2, "x" );
+    vecStr.erase( vecStr.begin() + 1 );
+    mu_assert( vecStr[1].data() == first, "payload is not copied" );
+    mu_assert( vecStr[10].data() == last, "payload is not copied" );
+    mu_assert( vecStr[10] == std::string( 32, 'j' ), "value is kept" );
+
+    ft::vector<ft::vector<int> > vecMut( 3,
+                                         ft::vector<int>( ( size_t ) 5, 42 ) );
+    const int *data = vecMut[2].data();
+    vecMut.push_back( ft::vector<int>() );
+    mu_assert( vecMut[2].data() == data, "nested vectors are not copied" );
+    mu_assert_int_eq( 42, vecMut[2][4] );
+}
+
+struct copy_only
+{
+    static int copies;
+
+    int value;
+
+    copy_only( int v = 0 ) : value( v ) {};
+    copy_only( const copy_only &x ) : value( x.value ) { copies++; };
+    copy_only &operator=( const copy_only &x )
+    {
+        value = x.value;
+        copies++;
+        return *this;
+    };
+};
+
+int copy_only::copies = 0;
+
+MU_TEST( test_vec_insert_reallocating_copies_once )
+{
+    ft::vector<copy_only> vecMut;
+    vecMut.reserve( 64 );
+    for ( int i = 0; i < 64; i++ )
+        vecMut.push_back( copy_only( i ) );
+    copy_only::copies = 0;
+    vecMut.insert( vecMut.begin() + 32, vecMut[0] );
+    mu_assert_int_eq( 65, copy_only::copies );
+    mu_assert_int_eq( 0, vecMut[32].value );
+    mu_assert_int_eq( 32, vecMut[33].value );
+
+    copy_only::copies = 0;
+    vecMut.insert( vecMut.begin() + 1, ( size_t ) 100, vecMut[64] );
+    mu_assert_int_eq( 165, copy_only::copies );
+    mu_assert_int_eq( 63, vecMut[100].value );
+    mu_assert_int_eq( 1, vecMut[101].value );
+    mu_assert_int_eq( 63, vecMut.back().value );
+}
+
+#if FT_CXX11
+struct copy_counter
+{
+    static int copies;
+
+    int value;
+
+    copy_counter( int v = 0 ) : value( v ) {};
+    copy_counter( const copy_counter &x ) : value( x.value ) { copies++; };
+    copy_counter( copy_counter &&x ) noexcept : value( x.value ) {};
+    copy_counter &operator=( const copy_counter &x )
+    {
+        value = x.value;
+        copies++;
+        return *this;
+    };
+    copy_counter &operator=( copy_counter &&x ) noexcept
+    {
+        value = x.value;
+        return *this;
+    };
+};
+
+int copy_counter::copies = 0;
+
+MU_TEST( test_vec_move_constructor )
+{
+    ft::vector<std::string> vecStr( TEST_VECTOR_SIZE, "moved" );
+    const std::string      *data = vecStr.data();
+    ft::vector<std::string> vecMove( std::move( vecStr ) );
+    mu_assert( vecMove.data() == data, "storage is stolen" );
+    mu_assert_int_eq( TEST_VECTOR_SIZE, vecMove.size() );
+    mu_assert_int_eq( 0, vecStr.size() );
+    vecStr = std::move( vecMove );
+    mu_assert( vecStr.data() == data, "storage is stolen back" );
+    mu_assert_int_eq( 0, vecMove.size() );
+    mu_assert( vecStr[9] == "moved", "elements are kept" );
+}
+
+MU_TEST( test_vec_emplace )
+{
+    ft::vector<std::string> vecStr;
+    for ( int i = 0; i < TEST_VECTOR_SIZE; i++ )
+        vecStr.emplace_back( i + 1, 'a' );
+    mu_assert( vecStr.back() == "aaaaaaaaaa", "constructed in place" );
+    vecStr.emplace_back( vecStr[0] );
+    mu_assert( vecStr.back() == "a", "emplaced a copy of an element" );
+    vecStr.emplace( vecStr.begin() + 1, 3, 'b' );
+    mu_assert( vecStr[1] == "bbb" && vecStr[2] == "aa", "emplaced inside" );
+    vecStr.push_back( std::string( "tmp" ) );
+    vecStr.insert( vecStr.begin(), std::string( "first" ) );
+    mu_assert_int_eq( TEST_VECTOR_SIZE + 4, vecStr.size() );
+    mu_assert( vecStr[0] == "first" && vecStr.back() == "tmp", "moved in" );
+}
+
+MU_TEST( test_vec_relocation_moves )
+{
+    ft::vector<copy_counter> vecMut;
+    copy_counter::copies = 0;
+    for ( int i = 0; i < 100; i++ )
+        vecMut.push_back( copy_counter( i ) );
+    vecMut.insert( vecMut.begin(), copy_counter( -1 ) );
+    vecMut.erase( vecMut.begin() + 50 );
+    vecMut.reserve( 1000 );
+    mu_assert_int_eq( 0, copy_counter::copies );
+    mu_assert_int_eq( -1, vecMut[0].value );
+    mu_assert_int_eq( 99, vecMut.back().value );
+}
+#endif
+
 MU_TEST_SUITE( suite_vector )
 {
     MU_RUN_TEST( test_vec_copy_constructor );
@@ -540,12 +762,16 @@ MU_TEST_SUITE( suite_vector )
     MU_RUN_TEST( test_vec_const_data );
     MU_RUN_TEST( test_vec_assign );
     MU_RUN_TEST( test_vec_push_back );
+    MU_RUN_TEST( test_vec_push_back_growth );
     MU_RUN_TEST( test_vec_pop_back );
     MU_RUN_TEST( test_vec_insert_pos_val );
     MU_RUN_TEST( test_vec_insert_pos_nsize_val );
+    MU_RUN_TEST( test_vec_insert_pos_nsize_val_middle );
     MU_RUN_TEST( test_vec_insert_pos_range );
+    MU_RUN_TEST( test_vec_insert_pos_range_categories );
     MU_RUN_TEST( test_vec_erase_first );
     MU_RUN_TEST( test_vec_erase_range );
+    MU_RUN_TEST( test_vec_insert_erase_string );
     MU_RUN_TEST( test_vec_swap_empty );
     MU_RUN_TEST( test_vec_swap );
     MU_RUN_TEST( test_vec_clear );
@@ -558,6 +784,13 @@ MU_TEST_SUITE( suite_vector )
     MU_RUN_TEST( test_vec_not_equal );
     MU_RUN_TEST( test_vec_of_vecs );
     MU_RUN_TEST( test_vec_of_vecs_of_vecs );
+    MU_RUN_TEST( test_vec_relocation_keeps_payload );
+    MU_RUN_TEST( test_vec_insert_reallocating_copies_once );
+#if FT_CXX11
+    MU_RUN_TEST( test_vec_move_constructor );
+    MU_RUN_TEST( test_vec_emplace );
+    MU_RUN_TEST( test_vec_relocation_moves );
+#endif
 }
 
 int main()